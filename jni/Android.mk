@@ -19,7 +19,29 @@ include $(CLEAR_VARS)
 LOCAL_MODULE    := libgles3jni
 LOCAL_CFLAGS    := -Werror
 LOCAL_SRC_FILES := gles3jni.cpp \
-				   RendererES3.cpp
+				   RendererES2.cpp \
+				   RendererES3.cpp \
+				   ShaderVariant.cpp \
+				   ShaderSources.cpp \
+				   CommandStream.cpp \
+				   SharedResources.cpp \
+				   GpuTimer.cpp \
+				   FrameGovernor.cpp \
+				   GlState.cpp \
+				   BufferArena.cpp \
+				   GlLoader.cpp \
+				   DeviceCaps.cpp \
+				   FrameScheduler.cpp \
+				   ReadbackQueue.cpp \
+				   GlDebug.cpp \
+				   RingLog.cpp \
+				   ThreadPool.cpp \
+				   BroadPhase.cpp \
+				   CpuCompute.cpp \
+				   ComputeFormat.cpp \
+				   ComputeJobs.cpp \
+				   ComputeKernels.cpp \
+				   BatchCompute.cpp
 LOCAL_LDLIBS    := -llog -lGLESv3 -lEGL
 
 LOCAL_CPPFLAGS += -std=c++11
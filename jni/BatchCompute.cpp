@@ -0,0 +1,384 @@
+/*
+ * Copyright 2013 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "BatchCompute.h"
+#include "ComputeFormat.h"
+#include "ComputeKernels.h"
+#include "DeviceCaps.h"
+#include "GlDebug.h"
+#include "GlState.h"
+#include "SharedResources.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+static uint64_t monotonicNs() {
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec*1000000000ull + now.tv_nsec;
+}
+
+static void logThroughput(const char* where, uint64_t points, uint64_t ns) {
+    const double mb = points * BATCH_POINT_SIZE / (1024.0 * 1024.0);
+    ALOGV("Batch compute (%s): %llu points in %.1f ms, %.1f MB/s", where,
+            (unsigned long long)points, ns * 0.000001,
+            ns ? mb / (ns * 0.000000001) : 0.0);
+}
+
+BatchFiles::BatchFiles()
+:   mInput(-1),
+    mOutput(-1),
+    mPoints(0),
+    mPageSize(sysconf(_SC_PAGESIZE))
+{}
+
+BatchFiles::~BatchFiles() {
+    close();
+}
+
+bool BatchFiles::open(const char* inputPath, const char* outputPath) {
+    close();
+    // The *64 calls keep files over 2 GB working on 32-bit devices.
+    mInput = ::open(inputPath, O_RDONLY | O_LARGEFILE | O_CLOEXEC);
+    if (mInput < 0) {
+        ALOGE("Batch compute: can't open %s: %s", inputPath, strerror(errno));
+        return false;
+    }
+    struct stat64 st;
+    if (fstat64(mInput, &st) != 0 || st.st_size % BATCH_POINT_SIZE != 0) {
+        ALOGE("Batch compute: %s is not a file of vec4s", inputPath);
+        close();
+        return false;
+    }
+    mOutput = ::open(outputPath, O_RDWR | O_CREAT | O_TRUNC | O_LARGEFILE | O_CLOEXEC,
+            0644);
+    if (mOutput < 0 || ftruncate64(mOutput, st.st_size) != 0) {
+        ALOGE("Batch compute: can't create %s: %s", outputPath, strerror(errno));
+        close();
+        return false;
+    }
+    mPoints = st.st_size / BATCH_POINT_SIZE;
+    return true;
+}
+
+void BatchFiles::close() {
+    if (mInput >= 0)
+        ::close(mInput);
+    if (mOutput >= 0)
+        ::close(mOutput);
+    mInput = -1;
+    mOutput = -1;
+    mPoints = 0;
+}
+
+bool BatchFiles::map(int fd, int prot, uint64_t first, unsigned int count,
+        Chunk* chunk) {
+    const off64_t offset = first * BATCH_POINT_SIZE;
+    const off64_t pageOffset = offset & ~(off64_t)(mPageSize - 1);
+    const size_t skip = offset - pageOffset;
+    chunk->length = skip + count * BATCH_POINT_SIZE;
+    chunk->base = mmap64(NULL, chunk->length, prot,
+            prot & PROT_WRITE ? MAP_SHARED : MAP_PRIVATE, fd, pageOffset);
+    if (chunk->base == MAP_FAILED) {
+        ALOGE("Batch compute: mmap of %u points at %llu failed: %s", count,
+                (unsigned long long)first, strerror(errno));
+        chunk->base = NULL;
+        chunk->data = NULL;
+        return false;
+    }
+    chunk->data = (float*)((char*)chunk->base + skip);
+    return true;
+}
+
+bool BatchFiles::mapInput(uint64_t first, unsigned int count, Chunk* chunk) {
+    return map(mInput, PROT_READ, first, count, chunk);
+}
+
+bool BatchFiles::mapOutput(uint64_t first, unsigned int count, Chunk* chunk) {
+    return map(mOutput, PROT_READ | PROT_WRITE, first, count, chunk);
+}
+
+void BatchFiles::unmap(Chunk* chunk) {
+    if (chunk->base)
+        munmap(chunk->base, chunk->length);
+    chunk->base = NULL;
+    chunk->data = NULL;
+}
+
+void BatchFiles::prefetch(uint64_t first, unsigned int count) {
+    if (first < mPoints) {
+        posix_fadvise64(mInput, first * BATCH_POINT_SIZE,
+                count * BATCH_POINT_SIZE, POSIX_FADV_WILLNEED);
+    }
+}
+
+int64_t batchComputeCpu(BatchFiles& files) {
+    const uint64_t start = monotonicNs();
+    const uint64_t points = files.points();
+    const unsigned int localSize = VELOCITY_TO_POSITION_KERNEL.localSize[0];
+    for (uint64_t first = 0; first < points; first += BATCH_CHUNK_POINTS) {
+        unsigned int count = BATCH_CHUNK_POINTS;
+        if (count > points - first)
+            count = points - first;
+        files.prefetch(first + count, BATCH_CHUNK_POINTS);
+        BatchFiles::Chunk in, out;
+        if (!files.mapInput(first, count, &in))
+            return -1;
+        if (!files.mapOutput(first, count, &out)) {
+            BatchFiles::unmap(&in);
+            return -1;
+        }
+        VelocityToPositionArgs args = {in.data, out.data, count, false};
+        const uint32_t groups[3] = {(count + localSize - 1) / localSize, 1, 1};
+        bool ok = cpuDispatch(VELOCITY_TO_POSITION_KERNEL, groups, &args);
+        BatchFiles::unmap(&in);
+        BatchFiles::unmap(&out);
+        if (!ok)
+            return -1;
+    }
+    logThroughput("CPU", points, monotonicNs() - start);
+    return points;
+}
+
+BatchComputeGpu::BatchComputeGpu(GlState& gl, BufferArena& arena)
+:   mGl(gl),
+    mArena(arena),
+    mProgram(0),
+    mBaseGroupLoc(-1),
+    mLocalSize(0),
+    mChunkPoints(0),
+    mNumSlots(0),
+    mUploadNs(0),
+    mWaitNs(0),
+    mReadBackNs(0)
+{
+    memset(mSlots, 0, sizeof(mSlots));
+}
+
+BatchComputeGpu::~BatchComputeGpu() {
+    for (unsigned int i = 0; i < MAX_SLOTS; i++) {
+        if (mSlots[i].buffers[SLOT_INPUT].buffer)
+            ALOGE("BatchComputeGpu destroyed without destroy()");
+    }
+}
+
+bool BatchComputeGpu::init(SharedResources* shared, const ShaderDesc& desc,
+        const ShaderVariantKey& key, unsigned int slots,
+        unsigned int chunkPoints) {
+    const int localSizeConstant = findShaderConstant(desc, "LOCAL_SIZE");
+    const int debugIds = findShaderFeature(desc, "DEBUG_IDS");
+    if (localSizeConstant < 0)
+        return false;
+    ShaderVariantKey batchKey = key;
+    if (debugIds >= 0)
+        batchKey.features &= ~(1u << debugIds);
+    // Files hold floats, which go through the slots as they are.
+    static const char* const FORMAT_CONSTANTS[] = {"VELOCITY_FORMAT", "POSITION_FORMAT"};
+    for (int i = 0; i < 2; i++) {
+        const int format = findShaderConstant(desc, FORMAT_CONSTANTS[i]);
+        if (format >= 0)
+            batchKey.constants[format] = COMPUTE_FORMAT_RGBA32F;
+    }
+    mLocalSize = batchKey.constants[localSizeConstant];
+    mProgram = shared->program(desc, batchKey);
+    if (!mProgram)
+        return false;
+    mBaseGroupLoc = glGetUniformLocation(mProgram, "baseGroup");
+
+    const DeviceCaps& caps = deviceCaps();
+    mChunkPoints = chunkPoints;
+    if (caps.maxTextureBufferSize > 0 && mChunkPoints > caps.maxTextureBufferSize)
+        mChunkPoints = caps.maxTextureBufferSize;
+
+    if (slots > MAX_SLOTS)
+        slots = MAX_SLOTS;
+    const GLsizeiptr size = mChunkPoints * BATCH_POINT_SIZE;
+    for (mNumSlots = 0; mNumSlots < slots; mNumSlots++) {
+        Slot& slot = mSlots[mNumSlots];
+        if (!mArena.allocate(size, BufferArena::ARENA_COMPUTE, &slot.buffers[SLOT_INPUT]) ||
+                !mArena.allocate(size, BufferArena::ARENA_COMPUTE,
+                    &slot.buffers[SLOT_OUTPUT])) {
+            mArena.free(&slot.buffers[SLOT_INPUT]);
+            break;
+        }
+        glGenTextures(SLOT_BUFFER_COUNT, slot.textures);
+        for (int i = 0; i < SLOT_BUFFER_COUNT; i++) {
+            const BufferRange& buf = slot.buffers[i];
+            mGl.bindTexture(0, GL_TEXTURE_BUFFER_EXT, slot.textures[i]);
+            glTexBufferRangeEXT(GL_TEXTURE_BUFFER_EXT, GL_RGBA32F,
+                    buf.buffer, buf.offset, buf.size);
+        }
+        CHECK_GL_CALL("batch compute slot");
+    }
+    if (mNumSlots < 2) {
+        destroy();
+        return false;
+    }
+    ALOGV("Batch compute: %u slots of %u points", mNumSlots, mChunkPoints);
+    return true;
+}
+
+void BatchComputeGpu::destroy() {
+    for (unsigned int i = 0; i < MAX_SLOTS; i++) {
+        Slot& slot = mSlots[i];
+        if (slot.fence)
+            glDeleteSync(slot.fence);
+        if (slot.buffers[SLOT_INPUT].buffer)
+            mGl.deleteTextures(SLOT_BUFFER_COUNT, slot.textures);
+        mArena.free(&slot.buffers[SLOT_INPUT]);
+        mArena.free(&slot.buffers[SLOT_OUTPUT]);
+    }
+    memset(mSlots, 0, sizeof(mSlots));
+    mNumSlots = 0;
+}
+
+bool BatchComputeGpu::upload(Slot& slot, BatchFiles& files, uint64_t first,
+        unsigned int count) {
+    const uint64_t start = monotonicNs();
+    BatchFiles::Chunk in;
+    if (!files.mapInput(first, count, &in))
+        return false;
+    // The slot's previous chunk has been read back, so the GPU is done
+    // with it and neither path waits.
+    const BufferRange& buf = slot.buffers[SLOT_INPUT];
+    if (buf.map) {
+        memcpy(buf.map, in.data, count * BATCH_POINT_SIZE);
+    } else {
+        mGl.bindBuffer(GL_COPY_WRITE_BUFFER, buf.buffer);
+        glBufferSubData(GL_COPY_WRITE_BUFFER, buf.offset,
+                count * BATCH_POINT_SIZE, in.data);
+    }
+    BatchFiles::unmap(&in);
+    slot.first = first;
+    slot.count = count;
+    mUploadNs += monotonicNs() - start;
+    return !checkGlError("batch compute upload");
+}
+
+void BatchComputeGpu::dispatch(Slot& slot) {
+    mGl.useProgram(mProgram);
+    // Each chunk is a whole dispatch; the program may be shared with a
+    // renderer that left a job's offset in it.
+    glUniform3ui(mBaseGroupLoc, 0, 0, 0);
+    mGl.bindImageTexture(0, slot.textures[SLOT_INPUT], 0, false, 0,
+            GL_READ_ONLY, GL_RGBA32F);
+    mGl.bindImageTexture(1, slot.textures[SLOT_OUTPUT], 0, false, 0,
+            GL_WRITE_ONLY, GL_RGBA32F);
+    glDispatchCompute((slot.count + mLocalSize - 1) / mLocalSize, 1, 1);
+    GLbitfield barriers = GL_BUFFER_UPDATE_BARRIER_BIT;
+    if (slot.buffers[SLOT_OUTPUT].map)
+        barriers |= GL_CLIENT_MAPPED_BUFFER_BARRIER_BIT_EXT;
+    glMemoryBarrier(barriers);
+    slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    // Start the GPU on it while the next chunk is uploaded.
+    glFlush();
+    CHECK_GL_CALL("batch compute dispatch");
+}
+
+bool BatchComputeGpu::readBack(Slot& slot, BatchFiles& files) {
+    uint64_t start = monotonicNs();
+    GLenum status;
+    do {
+        status = glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT,
+                100000000ull /* 100ms */);
+    } while (status == GL_TIMEOUT_EXPIRED);
+    glDeleteSync(slot.fence);
+    slot.fence = 0;
+    if (status == GL_WAIT_FAILED) {
+        checkGlError("batch compute wait");
+        return false;
+    }
+    const uint64_t waited = monotonicNs();
+    mWaitNs += waited - start;
+
+    BatchFiles::Chunk out;
+    if (!files.mapOutput(slot.first, slot.count, &out))
+        return false;
+    const BufferRange& buf = slot.buffers[SLOT_OUTPUT];
+    const GLsizeiptr size = slot.count * BATCH_POINT_SIZE;
+    const void* results = buf.map;
+    if (!results) {
+        mGl.bindBuffer(GL_COPY_READ_BUFFER, buf.buffer);
+        results = glMapBufferRange(GL_COPY_READ_BUFFER, buf.offset, size,
+                GL_MAP_READ_BIT);
+    }
+    if (results)
+        memcpy(out.data, results, size);
+    else
+        checkGlError("glMapBufferRange(batch compute)");
+    if (results && !buf.map)
+        glUnmapBuffer(GL_COPY_READ_BUFFER);
+    BatchFiles::unmap(&out);
+    mReadBackNs += monotonicNs() - waited;
+    return results != NULL;
+}
+
+int64_t BatchComputeGpu::run(BatchFiles& files) {
+    const uint64_t start = monotonicNs();
+    const uint64_t points = files.points();
+    mUploadNs = 0;
+    mWaitNs = 0;
+    mReadBackNs = 0;
+
+    // Chunks go through the slots in order. Every slot is kept busy: as
+    // soon as the oldest chunk is read back, its slot takes the next one.
+    uint64_t uploaded = 0;
+    uint64_t written = 0;
+    unsigned int next = 0;
+    unsigned int oldest = 0;
+    unsigned int inFlight = 0;
+    bool ok = true;
+    while (ok && written < points) {
+        while (inFlight < mNumSlots && uploaded < points) {
+            unsigned int count = mChunkPoints;
+            if (count > points - uploaded)
+                count = points - uploaded;
+            ok = upload(mSlots[next], files, uploaded, count);
+            if (!ok)
+                break;
+            dispatch(mSlots[next]);
+            uploaded += count;
+            next = (next + 1) % mNumSlots;
+            inFlight++;
+            files.prefetch(uploaded, mChunkPoints);
+        }
+        if (!ok)
+            break;
+        ok = readBack(mSlots[oldest], files);
+        written += mSlots[oldest].count;
+        oldest = (oldest + 1) % mNumSlots;
+        inFlight--;
+    }
+    // Chunks left in flight by a failure.
+    for (unsigned int i = 0; i < mNumSlots; i++) {
+        if (mSlots[i].fence) {
+            glDeleteSync(mSlots[i].fence);
+            mSlots[i].fence = 0;
+        }
+    }
+    if (!ok)
+        return -1;
+
+    logThroughput("GPU", points, monotonicNs() - start);
+    ALOGV("Batch compute: upload %.1f ms, GPU wait %.1f ms, readback %.1f ms",
+            mUploadNs * 0.000001, mWaitNs * 0.000001, mReadBackNs * 0.000001);
+    return points;
+}
@@ -0,0 +1,142 @@
+/*
+ * Copyright 2013 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BATCHCOMPUTE_H
+#define BATCHCOMPUTE_H 1
+
+#include "BufferArena.h"
+#include "ShaderVariant.h"
+
+#include <stdint.h>
+#include <sys/types.h>
+
+class GlState;
+class SharedResources;
+
+// ----------------------------------------------------------------------------
+// Out-of-core batch compute: runs the velocity-to-position kernel of
+// shaders/compute.comp over a dataset file of any size and writes the
+// results to an output file of the same size. Both files are raw vec4s of
+// native-order floats, 16 bytes per point.
+//
+// Files are memory mapped a chunk at a time, so datasets may be larger than
+// both GPU memory and the address space. BatchComputeGpu streams chunks
+// through a ring of 2 or 3 buffer slots: while the GPU runs chunk k, chunk
+// k+1 is copied from the input mapping into the next slot and chunk k-1 is
+// copied from its slot into the output mapping. Slots are reused once their
+// results have been copied out, so uploads never wait for the GPU.
+// batchComputeCpu() is the fallback without compute.
+
+// points per chunk; N6 only maps 1 MB of a buffer, see COMPUTE_POINTS
+#define BATCH_CHUNK_POINTS (63*1024)
+#define BATCH_POINT_SIZE (4 * sizeof(float))
+
+class BatchFiles {
+public:
+    BatchFiles();
+    ~BatchFiles();
+
+    // Opens input and creates or truncates output to the same size.
+    // Returns false, and logs why, if either fails or the input isn't a
+    // whole number of points.
+    bool open(const char* inputPath, const char* outputPath);
+    void close();
+
+    uint64_t points() const { return mPoints; }
+
+    // A mapping of points [first, first + count) of one file.
+    struct Chunk {
+        float* data;
+        // the whole mapping, which starts at a page boundary
+        void* base;
+        size_t length;
+    };
+    // Return false if mmap fails. Input chunks are read-only; output chunks
+    // are shared, so writes go to the file.
+    bool mapInput(uint64_t first, unsigned int count, Chunk* chunk);
+    bool mapOutput(uint64_t first, unsigned int count, Chunk* chunk);
+    static void unmap(Chunk* chunk);
+    // Hints the kernel to start reading input points ahead of mapInput().
+    void prefetch(uint64_t first, unsigned int count);
+
+private:
+    bool map(int fd, int prot, uint64_t first, unsigned int count, Chunk* chunk);
+
+    int mInput;
+    int mOutput;
+    uint64_t mPoints;
+    size_t mPageSize;
+};
+
+// Runs the kernel on the CPU, a chunk at a time. Returns the number of
+// points written, or -1 on failure.
+extern int64_t batchComputeCpu(BatchFiles& files);
+
+class BatchComputeGpu {
+public:
+    BatchComputeGpu(GlState& gl, BufferArena& arena);
+    ~BatchComputeGpu();
+
+    // Sets up slots (2 or 3) of chunkPoints each. desc is the
+    // COMPUTE_SHADER from ShaderSources.h and key its variant, of which
+    // the local size is used and DEBUG_IDS turned off. Fewer slots are set
+    // up if memory runs out; returns false with fewer than 2 or without a
+    // program.
+    bool init(SharedResources* shared, const ShaderDesc& desc,
+            const ShaderVariantKey& key, unsigned int slots,
+            unsigned int chunkPoints);
+    // Frees the slots. Call with the context current.
+    void destroy();
+
+    // Streams all of files through the kernel. Blocks until the output is
+    // written. Returns the number of points written, or -1 on failure.
+    int64_t run(BatchFiles& files);
+
+private:
+    enum {MAX_SLOTS = 3};
+    enum {SLOT_INPUT, SLOT_OUTPUT, SLOT_BUFFER_COUNT};
+
+    struct Slot {
+        BufferRange buffers[SLOT_BUFFER_COUNT];
+        GLuint textures[SLOT_BUFFER_COUNT];
+        // signals when the chunk's results are in the output buffer
+        GLsync fence;
+        uint64_t first;
+        unsigned int count;
+    };
+
+    // Copies points [first, first + count) in and dispatches the kernel.
+    bool upload(Slot& slot, BatchFiles& files, uint64_t first, unsigned int count);
+    void dispatch(Slot& slot);
+    // Waits for the slot's fence and copies its results out.
+    bool readBack(Slot& slot, BatchFiles& files);
+
+    GlState& mGl;
+    BufferArena& mArena;
+    GLuint mProgram;
+    GLint mBaseGroupLoc;
+    int mLocalSize;
+    unsigned int mChunkPoints;
+    Slot mSlots[MAX_SLOTS];
+    unsigned int mNumSlots;
+
+    // time spent in each stage of the last run, for the throughput log
+    uint64_t mUploadNs;
+    uint64_t mWaitNs;
+    uint64_t mReadBackNs;
+};
+
+#endif // BATCHCOMPUTE_H
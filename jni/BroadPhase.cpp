@@ -0,0 +1,459 @@
+/*
+ * Copyright 2013 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "BroadPhase.h"
+#include "DeviceCaps.h"
+#include "GlDebug.h"
+#include "GlState.h"
+#include "SharedResources.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// boxes per task below which splitting the work costs more than it saves
+#define MIN_TASK_BOXES 2048
+#define MIN_BUCKETS 64
+#define MAX_BUCKETS (1u << 22)
+// Keeps cell coordinates in int range for boxes far out.
+#define MAX_CELL 1.0e9f
+
+BroadPhaseGrid broadPhaseGrid(const float* bounds, unsigned int count) {
+    float maxExtent = 0.0f;
+    for (unsigned int i = 0; i < count; i++) {
+        maxExtent = fmaxf(maxExtent, bounds[4*i + 2]);
+        maxExtent = fmaxf(maxExtent, bounds[4*i + 3]);
+    }
+    BroadPhaseGrid grid;
+    grid.cellSize = fmaxf(2.0f * maxExtent, 1.0e-4f);
+    // about two buckets per box
+    grid.numBuckets = MIN_BUCKETS;
+    while (grid.numBuckets < 2 * count && grid.numBuckets < MAX_BUCKETS)
+        grid.numBuckets <<= 1;
+    return grid;
+}
+
+static inline int32_t cellOf(float x, float invCellSize) {
+    return (int32_t)fminf(fmaxf(floorf(x * invCellSize), -MAX_CELL), MAX_CELL);
+}
+
+// ----------------------------------------------------------------------------
+
+struct BroadPhaseCpu::Job {
+    BroadPhaseCpu* self;
+    const float* bounds;
+    unsigned int count;
+    BroadPhaseGrid grid;
+    float invCellSize;
+    unsigned int numTasks;
+    bool failed;
+
+    // slice [*begin, *end) of n items for task t
+    void slice(unsigned int n, unsigned int t, unsigned int* begin,
+            unsigned int* end) const {
+        *begin = (unsigned int)((uint64_t)n * t / numTasks);
+        *end = (unsigned int)((uint64_t)n * (t + 1) / numTasks);
+    }
+};
+
+BroadPhaseCpu::BroadPhaseCpu()
+:   mBucketOf(NULL),
+    mSorted(NULL),
+    mStart(NULL),
+    mSortedBounds(NULL),
+    mHistograms(NULL),
+    mCapacity(0),
+    mBucketCapacity(0),
+    mTaskCapacity(0)
+{
+    memset(mTaskPairs, 0, sizeof(mTaskPairs));
+    memset(mTaskPairCapacity, 0, sizeof(mTaskPairCapacity));
+    memset(mNumTaskPairs, 0, sizeof(mNumTaskPairs));
+    memset(mRangeTotals, 0, sizeof(mRangeTotals));
+}
+
+BroadPhaseCpu::~BroadPhaseCpu() {
+    free(mBucketOf);
+    free(mSorted);
+    free(mStart);
+    free(mSortedBounds);
+    free(mHistograms);
+    for (unsigned int t = 0; t < ThreadPool::MAX_THREADS; t++)
+        free(mTaskPairs[t]);
+}
+
+static bool grow(uint32_t** array, size_t count) {
+    uint32_t* grown = (uint32_t*)realloc(*array, count * sizeof(uint32_t));
+    if (!grown)
+        return false;
+    *array = grown;
+    return true;
+}
+
+bool BroadPhaseCpu::reserve(unsigned int count, const BroadPhaseGrid& grid,
+        unsigned int numTasks) {
+    if (count > mCapacity) {
+        float* bounds = (float*)realloc(mSortedBounds, count * 4 * sizeof(float));
+        if (!bounds)
+            return false;
+        mSortedBounds = bounds;
+        if (!grow(&mBucketOf, count) || !grow(&mSorted, count))
+            return false;
+        mCapacity = count;
+    }
+    if (grid.numBuckets > mBucketCapacity || numTasks > mTaskCapacity) {
+        uint32_t buckets = grid.numBuckets > mBucketCapacity ?
+                grid.numBuckets : mBucketCapacity;
+        unsigned int tasks = numTasks > mTaskCapacity ? numTasks : mTaskCapacity;
+        if (!grow(&mStart, buckets + 1) ||
+                !grow(&mHistograms, (size_t)tasks * buckets))
+            return false;
+        mBucketCapacity = buckets;
+        mTaskCapacity = tasks;
+    }
+    return true;
+}
+
+void BroadPhaseCpu::countTask(void* user, unsigned int task) {
+    Job& job = *(Job*)user;
+    BroadPhaseCpu& self = *job.self;
+    const uint32_t numBuckets = job.grid.numBuckets;
+    uint32_t* histogram = self.mHistograms + (size_t)task * numBuckets;
+    memset(histogram, 0, numBuckets * sizeof(uint32_t));
+
+    unsigned int begin, end;
+    job.slice(job.count, task, &begin, &end);
+    for (unsigned int i = begin; i < end; i++) {
+        const float* b = job.bounds + 4*i;
+        uint32_t bucket = broadPhaseBucket(cellOf(b[0], job.invCellSize),
+                cellOf(b[1], job.invCellSize), numBuckets);
+        self.mBucketOf[i] = bucket;
+        histogram[bucket]++;
+    }
+}
+
+void BroadPhaseCpu::sumTask(void* user, unsigned int task) {
+    Job& job = *(Job*)user;
+    BroadPhaseCpu& self = *job.self;
+    const uint32_t numBuckets = job.grid.numBuckets;
+    unsigned int begin, end;
+    job.slice(numBuckets, task, &begin, &end);
+    uint32_t total = 0;
+    for (unsigned int k = 0; k < job.numTasks; k++) {
+        const uint32_t* histogram = self.mHistograms + (size_t)k * numBuckets;
+        for (unsigned int b = begin; b < end; b++)
+            total += histogram[b];
+    }
+    self.mRangeTotals[task] = total;
+}
+
+void BroadPhaseCpu::offsetTask(void* user, unsigned int task) {
+    Job& job = *(Job*)user;
+    BroadPhaseCpu& self = *job.self;
+    const uint32_t numBuckets = job.grid.numBuckets;
+    unsigned int begin, end;
+    job.slice(numBuckets, task, &begin, &end);
+    // Within a bucket, boxes go in task order, and so in index order.
+    uint32_t next = self.mRangeTotals[task];
+    for (unsigned int b = begin; b < end; b++) {
+        self.mStart[b] = next;
+        for (unsigned int k = 0; k < job.numTasks; k++) {
+            uint32_t* slot = self.mHistograms + (size_t)k * numBuckets + b;
+            uint32_t n = *slot;
+            *slot = next;
+            next += n;
+        }
+    }
+}
+
+void BroadPhaseCpu::scatterTask(void* user, unsigned int task) {
+    Job& job = *(Job*)user;
+    BroadPhaseCpu& self = *job.self;
+    uint32_t* offsets = self.mHistograms + (size_t)task * job.grid.numBuckets;
+    unsigned int begin, end;
+    job.slice(job.count, task, &begin, &end);
+    for (unsigned int i = begin; i < end; i++) {
+        uint32_t k = offsets[self.mBucketOf[i]]++;
+        self.mSorted[k] = i;
+        memcpy(self.mSortedBounds + 4*k, job.bounds + 4*i, 4 * sizeof(float));
+    }
+}
+
+void BroadPhaseCpu::pairsTask(void* user, unsigned int task) {
+    Job& job = *(Job*)user;
+    BroadPhaseCpu& self = *job.self;
+    const uint32_t numBuckets = job.grid.numBuckets;
+    uint32_t*& pairs = self.mTaskPairs[task];
+    unsigned int& capacity = self.mTaskPairCapacity[task];
+    unsigned int numPairs = 0;
+
+    unsigned int begin, end;
+    job.slice(job.count, task, &begin, &end);
+    for (unsigned int i = begin; i < end; i++) {
+        const float* a = job.bounds + 4*i;
+        const int32_t cx = cellOf(a[0], job.invCellSize);
+        const int32_t cy = cellOf(a[1], job.invCellSize);
+        uint32_t visited[9];
+        unsigned int numVisited = 0;
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                uint32_t bucket = broadPhaseBucket(cx + dx, cy + dy, numBuckets);
+                unsigned int v = 0;
+                while (v < numVisited && visited[v] != bucket)
+                    v++;
+                if (v < numVisited)
+                    continue;
+                visited[numVisited++] = bucket;
+
+                for (uint32_t k = self.mStart[bucket]; k < self.mStart[bucket + 1]; k++) {
+                    uint32_t j = self.mSorted[k];
+                    const float* b = self.mSortedBounds + 4*k;
+                    if (j <= i || fabsf(a[0] - b[0]) > a[2] + b[2] ||
+                            fabsf(a[1] - b[1]) > a[3] + b[3])
+                        continue;
+                    if (numPairs == capacity) {
+                        unsigned int grown = capacity ? 2 * capacity : 256;
+                        if (!grow(&pairs, 2 * (size_t)grown)) {
+                            job.failed = true;
+                            self.mNumTaskPairs[task] = numPairs;
+                            return;
+                        }
+                        capacity = grown;
+                    }
+                    pairs[2*numPairs + 0] = i;
+                    pairs[2*numPairs + 1] = j;
+                    numPairs++;
+                }
+            }
+        }
+    }
+    self.mNumTaskPairs[task] = numPairs;
+}
+
+unsigned int BroadPhaseCpu::findPairs(const float* bounds, unsigned int count,
+        const BroadPhaseGrid& grid, uint32_t* pairs, unsigned int maxPairs) {
+    if (count == 0)
+        return 0;
+    ThreadPool& pool = ThreadPool::shared();
+    unsigned int numTasks = count / MIN_TASK_BOXES;
+    if (numTasks > pool.threads())
+        numTasks = pool.threads();
+    if (numTasks == 0)
+        numTasks = 1;
+    if (!reserve(count, grid, numTasks)) {
+        ALOGE("Broad phase: out of memory for %u boxes", count);
+        return 0;
+    }
+
+    Job job;
+    job.self = this;
+    job.bounds = bounds;
+    job.count = count;
+    job.grid = grid;
+    job.invCellSize = 1.0f / grid.cellSize;
+    job.numTasks = numTasks;
+    job.failed = false;
+
+    pool.run(numTasks, countTask, &job);
+    pool.run(numTasks, sumTask, &job);
+    uint32_t total = 0;
+    for (unsigned int t = 0; t < numTasks; t++) {
+        uint32_t n = mRangeTotals[t];
+        mRangeTotals[t] = total;
+        total += n;
+    }
+    mStart[grid.numBuckets] = total;
+    pool.run(numTasks, offsetTask, &job);
+    pool.run(numTasks, scatterTask, &job);
+    pool.run(numTasks, pairsTask, &job);
+    if (job.failed) {
+        ALOGE("Broad phase: out of memory for pairs");
+        return 0;
+    }
+
+    unsigned int numPairs = 0;
+    for (unsigned int t = 0; t < numTasks; t++) {
+        unsigned int n = mNumTaskPairs[t];
+        if (numPairs < maxPairs) {
+            unsigned int kept = n < maxPairs - numPairs ? n : maxPairs - numPairs;
+            memcpy(pairs + 2*numPairs, mTaskPairs[t], 2 * kept * sizeof(uint32_t));
+        }
+        numPairs += n;
+    }
+    return numPairs;
+}
+
+// ----------------------------------------------------------------------------
+
+// Storage layout, see shaders/broadphase.comp:
+// entries   struct { vec4 bounds; uint bucket; } per box, 32 bytes each
+// buckets   uint counts[numBuckets], uint starts[numBuckets + 1]
+// sorted    uint per box
+// pairs     uint count, uint unused, uvec2 pairs[maxPairs]
+#define ENTRY_SIZE 32
+#define PAIRS_HEADER_SIZE 8
+
+// Shader storage binding points of each buffer. Passes only declare the
+// buffers they use, which keeps every pass within the 4 blocks ES 3.1
+// guarantees.
+enum {
+    BINDING_OFFSETS = 0,
+    BINDING_SORTED = 0,
+    BINDING_TRANSFORMS = 1,
+    BINDING_PAIRS = 1,
+    BINDING_ENTRIES = 2,
+    BINDING_BUCKETS = 3,
+};
+
+static const char* const UNIFORM_NAMES[] = {
+    "numInstances", "invCellSize", "numBuckets", "maxPairs",
+};
+
+BroadPhaseGpu::BroadPhaseGpu(GlState& gl, BufferArena& arena)
+:   mGl(gl),
+    mArena(arena),
+    mShared(NULL),
+    mDesc(NULL),
+    mLocalSize(0),
+    mMaxInstances(0),
+    mMaxPairs(0),
+    mNumBuckets(0)
+{
+    memset(mPrograms, 0, sizeof(mPrograms));
+    memset(&mEntries, 0, sizeof(mEntries));
+    memset(&mBuckets, 0, sizeof(mBuckets));
+    memset(&mSorted, 0, sizeof(mSorted));
+    memset(&mPairs, 0, sizeof(mPairs));
+}
+
+bool BroadPhaseGpu::init(SharedResources* shared, const ShaderDesc& desc,
+        unsigned int maxInstances, unsigned int maxPairs) {
+    const DeviceCaps& caps = deviceCaps();
+    if (!hasGlCaps(GLCAP_ES31) || caps.maxComputeShaderStorageBlocks < 4)
+        return false;
+    const int passConstant = findShaderConstant(desc, "PASS");
+    const int localSizeConstant = findShaderConstant(desc, "LOCAL_SIZE");
+    if (passConstant < 0 || localSizeConstant < 0)
+        return false;
+
+    // The scan runs in a single work group, so use the largest power of
+    // two up to the default that the device can run.
+    ShaderVariantKey key = defaultVariantKey(desc);
+    mLocalSize = key.constants[localSizeConstant];
+    while (mLocalSize > 1 && (mLocalSize > caps.maxComputeWorkGroupSize[0] ||
+            mLocalSize > caps.maxComputeWorkGroupInvocations ||
+            mLocalSize * (int)sizeof(uint32_t) > caps.maxComputeSharedMemorySize))
+        mLocalSize >>= 1;
+    key.constants[localSizeConstant] = mLocalSize;
+
+    mShared = shared;
+    mDesc = &desc;
+    for (unsigned int pass = 0; pass < PASS_COUNT; pass++) {
+        mKeys[pass] = key;
+        mKeys[pass].constants[passConstant] = pass;
+        shared->prewarmAllFeatures(desc, mKeys[pass]);
+    }
+
+    mMaxInstances = maxInstances;
+    mMaxPairs = maxPairs;
+    mNumBuckets = MIN_BUCKETS;
+    while (mNumBuckets < 2 * maxInstances)
+        mNumBuckets <<= 1;
+    if (!mArena.allocate(maxInstances * ENTRY_SIZE, BufferArena::ARENA_COMPUTE, &mEntries) ||
+            !mArena.allocate((2 * mNumBuckets + 1) * sizeof(uint32_t),
+                BufferArena::ARENA_COMPUTE, &mBuckets) ||
+            !mArena.allocate(maxInstances * sizeof(uint32_t),
+                BufferArena::ARENA_COMPUTE, &mSorted) ||
+            !mArena.allocate(PAIRS_HEADER_SIZE + maxPairs * 2 * sizeof(uint32_t),
+                BufferArena::ARENA_COMPUTE, &mPairs)) {
+        destroy();
+        return false;
+    }
+    ALOGV("Broad phase: %u instances, %u buckets, %d invocations per group",
+            maxInstances, mNumBuckets, mLocalSize);
+    return true;
+}
+
+void BroadPhaseGpu::destroy() {
+    mArena.free(&mEntries);
+    mArena.free(&mBuckets);
+    mArena.free(&mSorted);
+    mArena.free(&mPairs);
+    mMaxInstances = 0;
+}
+
+bool BroadPhaseGpu::usePass(unsigned int pass) {
+    GLuint program = mShared->program(*mDesc, mKeys[pass]);
+    if (!program)
+        return false;
+    if (program != mPrograms[pass]) {
+        mPrograms[pass] = program;
+        for (unsigned int u = 0; u < UNIFORM_COUNT; u++)
+            mUniforms[pass][u] = glGetUniformLocation(program, UNIFORM_NAMES[u]);
+    }
+    mGl.useProgram(program);
+    return true;
+}
+
+void BroadPhaseGpu::dispatch(const BufferRange& offsets, const BufferRange& transforms,
+        unsigned int count, const BroadPhaseGrid& grid) {
+    if (!mMaxInstances)
+        return;
+    if (count > mMaxInstances)
+        count = mMaxInstances;
+    const GLuint groups = (count + mLocalSize - 1) / mLocalSize;
+    const GLuint bucketGroups = (mNumBuckets + mLocalSize - 1) / mLocalSize;
+
+    static const GLenum SSBO = GL_SHADER_STORAGE_BUFFER;
+    mGl.bindBufferRange(SSBO, BINDING_BUCKETS, mBuckets.buffer, mBuckets.offset, mBuckets.size);
+
+    for (unsigned int pass = 0; pass < PASS_COUNT; pass++) {
+        if (!usePass(pass))
+            return;
+        const GLint* u = mUniforms[pass];
+        glUniform1ui(u[UNIFORM_INSTANCES], count);
+        glUniform1f(u[UNIFORM_INV_CELL_SIZE], 1.0f / grid.cellSize);
+        glUniform1ui(u[UNIFORM_NUM_BUCKETS], mNumBuckets);
+        glUniform1ui(u[UNIFORM_MAX_PAIRS], mMaxPairs);
+
+        GLuint passGroups = groups;
+        switch (pass) {
+        case PASS_CLEAR:
+            mGl.bindBufferRange(SSBO, BINDING_PAIRS, mPairs.buffer, mPairs.offset, mPairs.size);
+            passGroups = bucketGroups;
+            break;
+        case PASS_HISTOGRAM:
+            mGl.bindBufferRange(SSBO, BINDING_OFFSETS, offsets.buffer, offsets.offset, offsets.size);
+            mGl.bindBufferRange(SSBO, BINDING_TRANSFORMS, transforms.buffer,
+                    transforms.offset, transforms.size);
+            mGl.bindBufferRange(SSBO, BINDING_ENTRIES, mEntries.buffer, mEntries.offset, mEntries.size);
+            break;
+        case PASS_SCAN:
+            passGroups = 1;
+            break;
+        case PASS_SCATTER:
+            mGl.bindBufferRange(SSBO, BINDING_SORTED, mSorted.buffer, mSorted.offset, mSorted.size);
+            break;
+        case PASS_PAIRS:
+            mGl.bindBufferRange(SSBO, BINDING_PAIRS, mPairs.buffer, mPairs.offset, mPairs.size);
+            break;
+        }
+        if (passGroups)
+            glDispatchCompute(passGroups, 1, 1);
+        if (pass + 1 < PASS_COUNT)
+            glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    }
+    CHECK_GL_CALL("broad phase");
+}
@@ -0,0 +1,183 @@
+/*
+ * Copyright 2013 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BROADPHASE_H
+#define BROADPHASE_H 1
+
+#include "BufferArena.h"
+#include "ShaderVariant.h"
+#include "ThreadPool.h"
+
+#include <math.h>
+#include <stdint.h>
+
+class GlState;
+class SharedResources;
+
+// ----------------------------------------------------------------------------
+// Broad-phase collision detection: finds every pair of instances whose
+// axis-aligned bounding boxes overlap.
+//
+// Boxes are put in a uniform grid by the cell of their center. Cells are
+// hashed into a power-of-two table of buckets, so the grid needs no
+// bounds, and the table is built with a counting sort: count per bucket,
+// prefix sum, scatter. Each box is then tested against the boxes in the
+// buckets of its own cell and the 8 around it. That finds every overlap as
+// long as no box is wider or taller than a cell. Cells that hash to the
+// same bucket only cost extra tests, never duplicate pairs.
+//
+// Pairs are (i, j) with i < j, in no particular order.
+//
+// BroadPhaseCpu runs on ThreadPool::shared(). It is the fallback without
+// compute, and the reference GPU results are checked against in debug
+// builds. BroadPhaseGpu runs the same steps as compute passes over shader
+// storage buffers, see shaders/broadphase.comp.
+
+// half size of QUAD
+#define QUAD_EXTENT 0.7f
+
+struct BroadPhaseGrid {
+    float cellSize;
+    // a power of two
+    uint32_t numBuckets;
+};
+
+// Bounds as (center x, center y, half width, half height) of an instance
+// drawn with the given offset (vec2) and scale/rotation transform (vec4).
+inline void instanceBounds(const float* offset, const float* transform,
+        float* bounds) {
+    bounds[0] = offset[0];
+    bounds[1] = offset[1];
+    bounds[2] = QUAD_EXTENT * (fabsf(transform[0]) + fabsf(transform[2]));
+    bounds[3] = QUAD_EXTENT * (fabsf(transform[1]) + fabsf(transform[3]));
+}
+
+// Grid for count boxes, sized for the largest of them.
+extern BroadPhaseGrid broadPhaseGrid(const float* bounds, unsigned int count);
+
+// Bucket of grid cell (x, y). Keep in sync with shaders/broadphase.comp.
+inline uint32_t broadPhaseBucket(int32_t x, int32_t y, uint32_t numBuckets) {
+    return (((uint32_t)x * 73856093u) ^ ((uint32_t)y * 19349663u)) &
+            (numBuckets - 1);
+}
+
+class BroadPhaseCpu {
+public:
+    BroadPhaseCpu();
+    ~BroadPhaseCpu();
+
+    // bounds holds count boxes as from instanceBounds(). Writes up to
+    // maxPairs pairs to pairs, two indices each, and returns how many
+    // pairs overlap, which may be more. Returns 0 if out of memory.
+    unsigned int findPairs(const float* bounds, unsigned int count,
+            const BroadPhaseGrid& grid, uint32_t* pairs, unsigned int maxPairs);
+
+private:
+    struct Job;
+    // Each task takes a slice of the boxes, or of the buckets for the
+    // prefix sum (sumTask, offsetTask).
+    static void countTask(void* user, unsigned int task);
+    static void sumTask(void* user, unsigned int task);
+    static void offsetTask(void* user, unsigned int task);
+    static void scatterTask(void* user, unsigned int task);
+    static void pairsTask(void* user, unsigned int task);
+
+    bool reserve(unsigned int count, const BroadPhaseGrid& grid,
+            unsigned int numTasks);
+
+    // bucket of each box
+    uint32_t* mBucketOf;
+    // box indices sorted by bucket; bucket b is
+    // mSorted[mStart[b] .. mStart[b + 1]]
+    uint32_t* mSorted;
+    uint32_t* mStart;
+    // bounds in mSorted order, so the pair tests read them in sequence
+    float* mSortedBounds;
+    // per task: box counts per bucket, turned into scatter offsets
+    uint32_t* mHistograms;
+    // per task: pairs found, and the number of boxes in its slice of the
+    // buckets, turned into the slice's first index in mSorted
+    uint32_t* mTaskPairs[ThreadPool::MAX_THREADS];
+    unsigned int mTaskPairCapacity[ThreadPool::MAX_THREADS];
+    unsigned int mNumTaskPairs[ThreadPool::MAX_THREADS];
+    uint32_t mRangeTotals[ThreadPool::MAX_THREADS];
+
+    unsigned int mCapacity;
+    uint32_t mBucketCapacity;
+    unsigned int mTaskCapacity;
+};
+
+class BroadPhaseGpu {
+public:
+    BroadPhaseGpu(GlState& gl, BufferArena& arena);
+
+    // Allocates storage for up to maxInstances boxes and maxPairs pairs.
+    // desc is the BROADPHASE_SHADER from ShaderSources.h. Returns false if
+    // the device can't run the passes or memory ran out.
+    bool init(SharedResources* shared, const ShaderDesc& desc,
+            unsigned int maxInstances, unsigned int maxPairs);
+    // Frees the storage; the arena takes care of the buffers.
+    void destroy();
+
+    // Issues the passes over count instances, whose offsets (vec2) and
+    // transforms (vec4) are read from the given ranges. The pairs are
+    // available to later GPU commands after a shader storage barrier.
+    void dispatch(const BufferRange& offsets, const BufferRange& transforms,
+            unsigned int count, const BroadPhaseGrid& grid);
+
+    // uint count, uint unused, then count pairs as uvec2, of which the
+    // first maxPairs are stored
+    const BufferRange& pairs() const { return mPairs; }
+
+private:
+    enum {
+        PASS_CLEAR,
+        PASS_HISTOGRAM,
+        PASS_SCAN,
+        PASS_SCATTER,
+        PASS_PAIRS,
+        PASS_COUNT
+    };
+    enum {
+        UNIFORM_INSTANCES,
+        UNIFORM_INV_CELL_SIZE,
+        UNIFORM_NUM_BUCKETS,
+        UNIFORM_MAX_PAIRS,
+        UNIFORM_COUNT
+    };
+
+    // Binds the pass's program and looks up its uniforms if it changed.
+    bool usePass(unsigned int pass);
+
+    GlState& mGl;
+    BufferArena& mArena;
+    SharedResources* mShared;
+    const ShaderDesc* mDesc;
+    ShaderVariantKey mKeys[PASS_COUNT];
+    GLuint mPrograms[PASS_COUNT];
+    GLint mUniforms[PASS_COUNT][UNIFORM_COUNT];
+    int mLocalSize;
+
+    unsigned int mMaxInstances;
+    unsigned int mMaxPairs;
+    uint32_t mNumBuckets;
+    BufferRange mEntries;
+    BufferRange mBuckets;
+    BufferRange mSorted;
+    BufferRange mPairs;
+};
+
+#endif // BROADPHASE_H
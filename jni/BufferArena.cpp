@@ -0,0 +1,269 @@
+/*
+ * Copyright 2013 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "BufferArena.h"
+#include "DeviceCaps.h"
+#include "GlState.h"
+#include "SharedResources.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// smallest block handed out, before alignment requirements
+#define MIN_BLOCK_SIZE 256
+// pages are this big unless a single range needs more
+#define PAGE_SIZE (4 * 1024 * 1024)
+
+static const char* const CATEGORY_NAMES[] = {"instances", "compute", "readback"};
+
+BufferArena::BufferArena(GlState& gl)
+:   mGl(gl),
+    mPersistent(false),
+    mMinBlock(MIN_BLOCK_SIZE),
+    mNumPages(0),
+    mReserved(0)
+{
+    memset(mPages, 0, sizeof(mPages));
+    memset(mBytes, 0, sizeof(mBytes));
+    memset(mPeakBytes, 0, sizeof(mPeakBytes));
+}
+
+BufferArena::~BufferArena() {
+    for (unsigned int i = 0; i < MAX_PAGES; i++) {
+        for (unsigned int k = 0; k < MAX_ORDERS; k++)
+            ::free(mPages[i].free[k].offsets);
+    }
+}
+
+void BufferArena::init() {
+    mPersistent = hasGlCaps(GLCAP_BUFFER_STORAGE) && canMapPersistently();
+
+    // Blocks are aligned to their size, so a minimum block that is a
+    // multiple of every offset alignment satisfies all of them. The
+    // alignments are powers of two in practice.
+    const DeviceCaps& caps = deviceCaps();
+    const GLint ALIGNMENTS[] = {
+        caps.uniformBufferOffsetAlignment,
+        caps.shaderStorageBufferOffsetAlignment,
+        caps.textureBufferOffsetAlignment,
+    };
+    for (unsigned int i = 0; i < sizeof(ALIGNMENTS) / sizeof(ALIGNMENTS[0]); i++) {
+        while (ALIGNMENTS[i] > mMinBlock)
+            mMinBlock <<= 1;
+    }
+    ALOGV("Buffer arena: %ld byte blocks%s", (long)mMinBlock,
+            mPersistent ? ", persistently mapped" : "");
+}
+
+void BufferArena::destroy(bool contextCurrent, SharedResources* shared) {
+    GLuint buffers[MAX_PAGES];
+    for (unsigned int i = 0; i < mNumPages; i++)
+        buffers[i] = mPages[i].buffer;
+    if (contextCurrent)
+        mGl.deleteBuffers(mNumPages, buffers);
+    else
+        shared->deferDelete(buffers, mNumPages, NULL, 0);
+    logUsage();
+
+    for (unsigned int i = 0; i < mNumPages; i++) {
+        for (unsigned int k = 0; k < MAX_ORDERS; k++)
+            mPages[i].free[k].count = 0;
+        mPages[i].buffer = 0;
+        mPages[i].map = NULL;
+    }
+    mNumPages = 0;
+    mReserved = 0;
+    memset(mBytes, 0, sizeof(mBytes));
+}
+
+// Some drivers expose GL_EXT_buffer_storage but fail the persistent map.
+// Immutable storage can't be respecified with glBufferData(), so find out
+// before any page is created, and before callers lay out their ranges for
+// persistent mapping.
+bool BufferArena::canMapPersistently() {
+    const GLbitfield access = GL_MAP_READ_BIT | GL_MAP_WRITE_BIT |
+            GL_MAP_PERSISTENT_BIT_EXT | GL_MAP_COHERENT_BIT_EXT;
+    GLuint buffer;
+    glGenBuffers(1, &buffer);
+    mGl.bindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    glBufferStorageEXT(GL_COPY_WRITE_BUFFER, MIN_BLOCK_SIZE, NULL, access);
+    const bool mapped = glMapBufferRange(GL_COPY_WRITE_BUFFER,
+            0, MIN_BLOCK_SIZE, access) != NULL;
+    if (mapped)
+        glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+    const bool error = checkGlError("BufferArena::canMapPersistently");
+    mGl.deleteBuffers(1, &buffer);
+    if (!mapped || error) {
+        ALOGE("Buffer arena: persistent mapping failed, using glBufferData()");
+        return false;
+    }
+    return true;
+}
+
+bool BufferArena::addPage(unsigned int maxOrder) {
+    if (mNumPages == MAX_PAGES || maxOrder >= MAX_ORDERS)
+        return false;
+    Page& page = mPages[mNumPages];
+    const GLsizeiptr size = blockSize(maxOrder);
+
+    glGenBuffers(1, &page.buffer);
+    mGl.bindBuffer(GL_COPY_WRITE_BUFFER, page.buffer);
+    if (mPersistent) {
+        const GLbitfield access = GL_MAP_READ_BIT | GL_MAP_WRITE_BIT |
+                GL_MAP_PERSISTENT_BIT_EXT | GL_MAP_COHERENT_BIT_EXT;
+        glBufferStorageEXT(GL_COPY_WRITE_BUFFER, size, NULL, access);
+        page.map = (unsigned char*)glMapBufferRange(GL_COPY_WRITE_BUFFER,
+                0, size, access);
+        if (!page.map)
+            checkGlError("glMapBufferRange(persistent page)");
+    } else {
+        glBufferData(GL_COPY_WRITE_BUFFER, size, NULL, GL_DYNAMIC_DRAW);
+        page.map = NULL;
+    }
+    if (checkGlError("BufferArena::addPage") || (mPersistent && !page.map) ||
+            !push(&page.free[maxOrder], 0)) {
+        mGl.deleteBuffers(1, &page.buffer);
+        page.buffer = 0;
+        return false;
+    }
+    page.maxOrder = maxOrder;
+    mNumPages++;
+    mReserved += size;
+    RLOGV("Buffer arena: new %ld KB page, %zu KB reserved",
+            (long)(size / 1024), mReserved / 1024);
+    return true;
+}
+
+bool BufferArena::allocateFrom(Page* page, unsigned int order, GLintptr* offset) {
+    unsigned int k = order;
+    while (k <= page->maxOrder && page->free[k].count == 0)
+        k++;
+    if (k > page->maxOrder)
+        return false;
+    // Make room for every buddy before splitting, so a split can't fail
+    // halfway with some of them already on the free lists.
+    for (unsigned int i = order; i < k; i++) {
+        if (!reserve(&page->free[i]))
+            return false;
+    }
+    GLintptr block = page->free[k].offsets[--page->free[k].count];
+    // Split down to the requested size, keeping the lower half each time.
+    while (k > order) {
+        k--;
+        push(&page->free[k], block + blockSize(k));
+    }
+    *offset = block;
+    return true;
+}
+
+bool BufferArena::allocate(GLsizeiptr size, Category category, BufferRange* range,
+        bool ownPage) {
+    memset(range, 0, sizeof(*range));
+    unsigned int order = 0;
+    while (blockSize(order) < size)
+        order++;
+
+    GLintptr offset = 0;
+    unsigned int p = 0;
+    if (!ownPage) {
+        for (; p < mNumPages; p++) {
+            if (order <= mPages[p].maxOrder &&
+                    allocateFrom(&mPages[p], order, &offset))
+                break;
+        }
+    }
+    if (ownPage || p == mNumPages) {
+        p = mNumPages;
+        unsigned int pageOrder = 0;
+        while (!ownPage && blockSize(pageOrder) < PAGE_SIZE)
+            pageOrder++;
+        if (!addPage(order > pageOrder ? order : pageOrder) ||
+                !allocateFrom(&mPages[p], order, &offset)) {
+            ALOGE("Buffer arena: out of memory for %ld bytes of %s",
+                    (long)size, CATEGORY_NAMES[category]);
+            return false;
+        }
+    }
+
+    range->buffer = mPages[p].buffer;
+    range->offset = offset;
+    range->size = size;
+    range->map = mPages[p].map ? mPages[p].map + offset : NULL;
+    range->page = p;
+    range->order = order;
+    range->category = category;
+
+    mBytes[category] += blockSize(order);
+    if (mBytes[category] > mPeakBytes[category])
+        mPeakBytes[category] = mBytes[category];
+    return true;
+}
+
+void BufferArena::free(BufferRange* range) {
+    if (!range->buffer)
+        return;
+    Page& page = mPages[range->page];
+    mBytes[range->category] -= blockSize(range->order);
+
+    // Merge with the buddy for as long as it is free too.
+    GLintptr block = range->offset;
+    unsigned int k = range->order;
+    while (k < page.maxOrder && remove(&page.free[k], block ^ blockSize(k))) {
+        block &= ~blockSize(k);
+        k++;
+    }
+    if (!push(&page.free[k], block))
+        ALOGE("Buffer arena: out of memory freeing a range; leaking it");
+    memset(range, 0, sizeof(*range));
+}
+
+bool BufferArena::reserve(FreeList* list) {
+    if (list->count < list->capacity)
+        return true;
+    unsigned int capacity = list->capacity ? 2 * list->capacity : 8;
+    GLintptr* grown = (GLintptr*)realloc(list->offsets,
+            capacity * sizeof(GLintptr));
+    if (!grown)
+        return false;
+    list->offsets = grown;
+    list->capacity = capacity;
+    return true;
+}
+
+bool BufferArena::push(FreeList* list, GLintptr offset) {
+    if (!reserve(list))
+        return false;
+    list->offsets[list->count++] = offset;
+    return true;
+}
+
+bool BufferArena::remove(FreeList* list, GLintptr offset) {
+    for (unsigned int i = 0; i < list->count; i++) {
+        if (list->offsets[i] == offset) {
+            list->offsets[i] = list->offsets[--list->count];
+            return true;
+        }
+    }
+    return false;
+}
+
+void BufferArena::logUsage() const {
+    for (int i = 0; i < ARENA_CATEGORY_COUNT; i++) {
+        ALOGV("Buffer arena: %s %zu KB, peak %zu KB", CATEGORY_NAMES[i],
+                mBytes[i] / 1024, mPeakBytes[i] / 1024);
+    }
+    ALOGV("Buffer arena: %zu KB reserved in %u pages", mReserved / 1024, mNumPages);
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright 2013 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BUFFERARENA_H
+#define BUFFERARENA_H 1
+
+#include "gles3jni.h"
+
+#ifndef GL_EXT_buffer_storage
+#define GL_MAP_PERSISTENT_BIT_EXT               0x0040
+#define GL_MAP_COHERENT_BIT_EXT                 0x0080
+#define GL_CLIENT_MAPPED_BUFFER_BARRIER_BIT_EXT 0x00004000
+#endif
+
+class GlState;
+class SharedResources;
+
+// ----------------------------------------------------------------------------
+// Sub-allocates buffer ranges out of a few large GL buffers ("pages"), so
+// that a renderer's buffers cost one driver allocation instead of one each.
+//
+// Each page is managed as a buddy heap: blocks are powers of two times the
+// minimum block size, which is at least the uniform, shader storage and
+// texture buffer offset alignments. Every range is therefore aligned for
+// binding with glBindBufferRange() or glTexBufferRangeEXT().
+//
+// With GL_EXT_buffer_storage pages are allocated as immutable storage and
+// stay mapped (read/write, coherent) for their whole lifetime; each range
+// then comes with a CPU pointer. Otherwise ranges are mapped on demand with
+// glMapBufferRange().
+//
+// Bytes in use are tracked per category, along with the peaks, so memory
+// can be budgeted on low-end devices.
+
+struct BufferRange {
+    GLuint buffer;
+    GLintptr offset;
+    GLsizeiptr size;
+    // CPU address of the range in a persistently mapped page, else NULL
+    void* map;
+
+    // internal to BufferArena
+    unsigned char page;
+    unsigned char order;
+    unsigned char category;
+};
+
+class BufferArena {
+public:
+    enum Category {
+        ARENA_INSTANCES,
+        ARENA_COMPUTE,
+        ARENA_READBACK,
+        ARENA_CATEGORY_COUNT
+    };
+
+    BufferArena(GlState& gl);
+    ~BufferArena();
+
+    // Sizes blocks for the offset alignments in deviceCaps(). Pages are
+    // persistently mapped if the device has GLCAP_BUFFER_STORAGE and a
+    // test buffer maps that way; otherwise they use glBufferData().
+    void init();
+    // Deletes the pages. If the context isn't current they are handed to
+    // shared->deferDelete() instead.
+    void destroy(bool contextCurrent, SharedResources* shared);
+
+    bool persistent() const { return mPersistent; }
+
+    // Returns false and an empty range if out of memory. ownPage puts the
+    // range at offset 0 of a page of its own, for APIs that can't take an
+    // offset.
+    bool allocate(GLsizeiptr size, Category category, BufferRange* range,
+            bool ownPage = false);
+    void free(BufferRange* range);
+
+    size_t bytes(Category category) const { return mBytes[category]; }
+    size_t peakBytes(Category category) const { return mPeakBytes[category]; }
+    // GL memory held by pages, used or not
+    size_t reservedBytes() const { return mReserved; }
+    void logUsage() const;
+
+private:
+    enum {
+        MAX_PAGES = 16,
+        MAX_ORDERS = 24,
+    };
+
+    struct FreeList {
+        GLintptr* offsets;
+        unsigned int count;
+        unsigned int capacity;
+    };
+    struct Page {
+        GLuint buffer;
+        unsigned char* map;
+        unsigned int maxOrder;
+        FreeList free[MAX_ORDERS];
+    };
+
+    GLsizeiptr blockSize(unsigned int order) const {
+        return mMinBlock << order;
+    }
+    bool canMapPersistently();
+    bool addPage(unsigned int maxOrder);
+    bool allocateFrom(Page* page, unsigned int order, GLintptr* offset);
+    // Makes room for one more offset, so that the next push() can't fail.
+    static bool reserve(FreeList* list);
+    static bool push(FreeList* list, GLintptr offset);
+    static bool remove(FreeList* list, GLintptr offset);
+
+    GlState& mGl;
+    bool mPersistent;
+    GLsizeiptr mMinBlock;
+    Page mPages[MAX_PAGES];
+    unsigned int mNumPages;
+
+    size_t mBytes[ARENA_CATEGORY_COUNT];
+    size_t mPeakBytes[ARENA_CATEGORY_COUNT];
+    size_t mReserved;
+};
+
+#endif // BUFFERARENA_H
@@ -0,0 +1,157 @@
+/*
+ * Copyright 2013 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "gles3jni.h"
+#include "CommandStream.h"
+#include "DeviceCaps.h"
+#include "FrameGovernor.h"
+
+// Payload sizes in words, indexed by opcode. Longer payloads are accepted
+// (and the extra words ignored) so commands can grow fields compatibly.
+static const uint32_t PAYLOAD_WORDS[] = {
+    0,  // unused
+    5,  // CMD_SET_INSTANCE
+    4,  // CMD_SPAWN
+    1,  // CMD_KILL
+    3,  // CMD_CAMERA
+    4,  // CMD_DISPATCH
+};
+
+// GL_MAX_COMPUTE_WORK_GROUP_COUNT's minimum, for devices without compute
+#define MIN_MAX_WORK_GROUP_COUNT 65535
+
+// Work group counts come from the app; a dispatch the driver would reject
+// is rejected here, before it reaches a renderer.
+static bool validKernelGroups(const uint32_t groups[3]) {
+    const DeviceCaps& caps = deviceCaps();
+    for (int i = 0; i < 3; i++) {
+        const uint32_t max = caps.maxComputeWorkGroupCount[i] > 0 ?
+                caps.maxComputeWorkGroupCount[i] : MIN_MAX_WORK_GROUP_COUNT;
+        if (groups[i] == 0 || groups[i] > max)
+            return false;
+    }
+    return true;
+}
+
+void Renderer::executeCommands(const void* data, size_t size) {
+    // Dispatches are part of the frame's work as far as the governor is
+    // concerned; render() ends the frame.
+    mGovernor->beginFrame();
+
+    SimulationState& sim = *mSim;
+    CommandReader reader(data, size);
+    uint32_t op, words;
+    while (reader.next(&op, &words)) {
+        if (op >= sizeof(PAYLOAD_WORDS) / sizeof(PAYLOAD_WORDS[0]) || op == 0) {
+            RLOGV("Skipping unknown command %u", op);
+            continue;
+        }
+        if (words < PAYLOAD_WORDS[op]) {
+            ALOGE("Command %u has %u payload words, needs %u",
+                    op, words, PAYLOAD_WORDS[op]);
+            continue;
+        }
+
+        switch (op) {
+        case CMD_SET_INSTANCE:
+        case CMD_SPAWN:
+        case CMD_KILL: {
+            // Instance commands drive the built-in simulation, so the
+            // app-supplied instances become simulated ones. Their offsets
+            // and depths are already in sim; start them at the rotation
+            // they were committed with rather than at whatever the last
+            // layout left in their slots.
+            if (sim.externalInstances) {
+                for (unsigned int k = 0; k < sim.numInstances; k++) {
+                    const float* t = sim.transforms + 4*k;
+                    sim.angles[k] = atan2f(-t[2], t[0]);
+                    sim.angularVelocity[k] = 0.0f;
+                }
+                sim.externalInstances = false;
+                mInstancesDirty = true;
+            }
+            sim.editedInstances = true;
+
+            unsigned int i;
+            unsigned int arg = 0;
+            if (op == CMD_SPAWN) {
+                if (sim.numInstances == MAX_INSTANCES) {
+                    ALOGE("CMD_SPAWN: already at %d instances", MAX_INSTANCES);
+                    break;
+                }
+                i = sim.numInstances++;
+            } else {
+                i = reader.u32(arg++);
+                if (i >= sim.numInstances) {
+                    ALOGE("Command %u: no instance %u", op, i);
+                    break;
+                }
+            }
+
+            if (op == CMD_KILL) {
+                unsigned int last = --sim.numInstances;
+                sim.angles[i] = sim.angles[last];
+                sim.angularVelocity[i] = sim.angularVelocity[last];
+                sim.offsets[2*i + 0] = sim.offsets[2*last + 0];
+                sim.offsets[2*i + 1] = sim.offsets[2*last + 1];
+                sim.depths[i] = sim.depths[last];
+            } else {
+                sim.angles[i] = reader.f32(arg + 0);
+                sim.angularVelocity[i] = reader.f32(arg + 1);
+                sim.offsets[2*i + 0] = reader.f32(arg + 2);
+                sim.offsets[2*i + 1] = reader.f32(arg + 3);
+                // The depth is optional; spawned instances get a random
+                // one like the built-in layout's, set ones keep theirs.
+                if (words > arg + 4)
+                    sim.depths[i] = reader.f32(arg + 4);
+                else if (op == CMD_SPAWN)
+                    sim.depths[i] = drand48();
+            }
+            mInstancesDirty = true;
+            break;
+        }
+
+        case CMD_CAMERA:
+            sim.camera[0] = reader.f32(0);
+            sim.camera[1] = reader.f32(1);
+            sim.camera[2] = reader.f32(2);
+            break;
+
+        case CMD_DISPATCH: {
+            unsigned int kernel = reader.u32(0);
+            const uint32_t groups[3] = {reader.u32(1), reader.u32(2), reader.u32(3)};
+            if (!validKernelGroups(groups)) {
+                ALOGE("CMD_DISPATCH: invalid work groups %ux%ux%u for kernel %u",
+                        groups[0], groups[1], groups[2], kernel);
+                break;
+            }
+            if (dispatchKernel(kernel, groups[0], groups[1], groups[2]))
+                break;
+            // Without compute, or with this frame's batch full, render()
+            // runs the broad phase on the CPU, and other kernels run right
+            // here.
+            if (kernel == KERNEL_BROAD_PHASE)
+                mBroadPhasePending = true;
+            else if (!runCpuKernel(kernel, groups))
+                ALOGE("CMD_DISPATCH: kernel %u not supported", kernel);
+            break;
+        }
+        }
+    }
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright 2013 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef COMMANDSTREAM_H
+#define COMMANDSTREAM_H 1
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// ----------------------------------------------------------------------------
+// Binary command stream filled by the Java side (CommandBuffer.java) and
+// decoded by Renderer::executeCommands() once per frame, ahead of rendering.
+//
+// The stream is a sequence of native-endian 32-bit words. Each command is a
+// header word followed by its payload:
+//
+//     header = opcode | (payload words << 16)
+//
+// Payload words are uint32 or float32 as listed below. The explicit length
+// lets the interpreter skip opcodes it doesn't know, so Java and native code
+// can be updated independently.
+//
+//   CMD_SET_INSTANCE  u32 index, f32 angle, f32 angularVelocity,
+//                     f32 offsetX, f32 offsetY[, f32 depth]
+//   CMD_SPAWN         f32 angle, f32 angularVelocity, f32 offsetX, f32 offsetY
+//                     [, f32 depth]
+//   CMD_KILL          u32 index; the last instance moves into its slot
+//   CMD_CAMERA        f32 x, f32 y, f32 zoom
+//   CMD_DISPATCH      u32 kernel, u32 groupsX, u32 groupsY, u32 groupsZ
+//
+// Depths are optional, see SimulationState::depths. Once instance commands
+// have edited the scene, resizing no longer lays it out again.
+//
+// Keep in sync with CommandBuffer.java.
+
+enum Command {
+    CMD_SET_INSTANCE = 1,
+    CMD_SPAWN        = 2,
+    CMD_KILL         = 3,
+    CMD_CAMERA       = 4,
+    CMD_DISPATCH     = 5,
+};
+
+enum ComputeKernelId {
+    // shaders/compute.comp over the renderer's velocity/position buffers
+    KERNEL_VELOCITY_TO_POSITION = 0,
+    // broad-phase collision detection over the instances of the frame, see
+    // Renderer::collisionPairs(); the group counts are ignored
+    KERNEL_BROAD_PHASE = 1,
+    KERNEL_COUNT
+};
+
+// Bounds-checked cursor over a command stream.
+class CommandReader {
+public:
+    CommandReader(const void* data, size_t size)
+    :   mWords((const uint32_t*)data),
+        mEnd(size / sizeof(uint32_t)),
+        mPos(0),
+        mPayload(0),
+        mPayloadEnd(0)
+    {}
+
+    // Advances to the next command. Returns false at the end of the stream
+    // or if the command's payload runs past it.
+    bool next(uint32_t* opcode, uint32_t* payloadWords) {
+        mPos = mPayloadEnd;
+        if (mPos >= mEnd)
+            return false;
+        uint32_t header = mWords[mPos++];
+        *opcode = header & 0xffff;
+        *payloadWords = header >> 16;
+        if (*payloadWords > mEnd - mPos)
+            return false;
+        mPayload = mPos;
+        mPayloadEnd = mPos + *payloadWords;
+        return true;
+    }
+
+    uint32_t u32(unsigned int i) const {
+        return mWords[mPayload + i];
+    }
+    float f32(unsigned int i) const {
+        float f;
+        memcpy(&f, &mWords[mPayload + i], sizeof(f));
+        return f;
+    }
+
+private:
+    const uint32_t* mWords;
+    size_t mEnd;
+    size_t mPos;
+    size_t mPayload;
+    size_t mPayloadEnd;
+};
+
+#endif // COMMANDSTREAM_H
@@ -0,0 +1,202 @@
+/*
+ * Copyright 2013 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ComputeFormat.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#define HALF_MAX 65504.0f
+#define FIXED_MAX 32767
+
+const ComputeFormatInfo COMPUTE_FORMATS[COMPUTE_FORMAT_COUNT] = {
+    {"rgba32f",    GL_RGBA32F, 16, 1},
+    {"rgba16f",    GL_RGBA16F,  8, 1},
+    {"half_r32ui", GL_R32UI,    8, 2},
+    {"fixed16",    GL_RGBA16I,  8, 1},
+};
+
+// IEEE 754 binary16, rounding to nearest even like the GPU's conversions.
+static uint16_t floatToHalf(float f) {
+    if (f != f)
+        return 0x7e00;
+    if (f > HALF_MAX)
+        f = HALF_MAX;
+    else if (f < -HALF_MAX)
+        f = -HALF_MAX;
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+    const uint16_t sign = (bits >> 16) & 0x8000;
+    const int exponent = (int)((bits >> 23) & 0xff) - 127 + 15;
+    uint32_t mantissa = bits & 0x7fffff;
+    if (exponent <= 0) {
+        // subnormal or zero
+        if (exponent < -10)
+            return sign;
+        mantissa |= 0x800000;
+        const int shift = 14 - exponent;
+        uint32_t half = mantissa >> shift;
+        const uint32_t rest = mantissa & ((1u << shift) - 1);
+        const uint32_t midpoint = 1u << (shift - 1);
+        if (rest > midpoint || (rest == midpoint && (half & 1)))
+            half++;
+        return sign | half;
+    }
+    uint32_t half = ((uint32_t)exponent << 10) | (mantissa >> 13);
+    const uint32_t rest = mantissa & 0x1fff;
+    if (rest > 0x1000 || (rest == 0x1000 && (half & 1)))
+        half++;
+    return sign | half;
+}
+
+static float halfToFloat(uint16_t h) {
+    const uint32_t sign = (uint32_t)(h & 0x8000) << 16;
+    const int exponent = (h >> 10) & 0x1f;
+    const uint32_t mantissa = h & 0x3ff;
+    float f;
+    if (exponent == 0) {
+        f = ldexpf((float)mantissa, -24);
+        return sign ? -f : f;
+    }
+    uint32_t bits;
+    if (exponent == 31)
+        bits = sign | 0x7f800000 | (mantissa << 13);
+    else
+        bits = sign | ((uint32_t)(exponent - 15 + 127) << 23) | (mantissa << 13);
+    memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+static int16_t floatToFixed(float f, int fracBits) {
+    float scaled = ldexpf(f, fracBits);
+    if (!(scaled > -FIXED_MAX))
+        return -FIXED_MAX;
+    if (scaled > FIXED_MAX)
+        return FIXED_MAX;
+    return (int16_t)lrintf(scaled);
+}
+
+int computeFixedFracBits(float maxAbs) {
+    if (!(maxAbs > 0.0f))
+        return 15;
+    int bits = (int)floorf(log2f(FIXED_MAX / maxAbs));
+    return bits < -16 ? -16 : bits > 15 ? 15 : bits;
+}
+
+void encodeComputePoints(const float* src, unsigned int numPoints,
+        const ComputeStorage& storage, void* dst) {
+    const unsigned int n = numPoints * 4;
+    switch (storage.format) {
+    case COMPUTE_FORMAT_RGBA32F:
+        memcpy(dst, src, n * sizeof(float));
+        break;
+    case COMPUTE_FORMAT_RGBA16F: {
+        uint16_t* halves = (uint16_t*)dst;
+        for (unsigned int i = 0; i < n; i++)
+            halves[i] = floatToHalf(src[i]);
+        break;
+    }
+    case COMPUTE_FORMAT_HALF_R32UI: {
+        // packHalf2x16() puts the first component in the low bits.
+        uint32_t* words = (uint32_t*)dst;
+        for (unsigned int i = 0; i < n / 2; i++) {
+            words[i] = floatToHalf(src[2*i]) |
+                    (uint32_t)floatToHalf(src[2*i + 1]) << 16;
+        }
+        break;
+    }
+    case COMPUTE_FORMAT_FIXED16: {
+        int16_t* fixed = (int16_t*)dst;
+        for (unsigned int i = 0; i < n; i++)
+            fixed[i] = floatToFixed(src[i], storage.fracBits);
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+void decodeComputePoints(const void* src, unsigned int numPoints,
+        const ComputeStorage& storage, float* dst) {
+    const unsigned int n = numPoints * 4;
+    switch (storage.format) {
+    case COMPUTE_FORMAT_RGBA32F:
+        memcpy(dst, src, n * sizeof(float));
+        break;
+    case COMPUTE_FORMAT_RGBA16F: {
+        const uint16_t* halves = (const uint16_t*)src;
+        for (unsigned int i = 0; i < n; i++)
+            dst[i] = halfToFloat(halves[i]);
+        break;
+    }
+    case COMPUTE_FORMAT_HALF_R32UI: {
+        const uint32_t* words = (const uint32_t*)src;
+        for (unsigned int i = 0; i < n / 2; i++) {
+            dst[2*i] = halfToFloat(words[i] & 0xffff);
+            dst[2*i + 1] = halfToFloat(words[i] >> 16);
+        }
+        break;
+    }
+    case COMPUTE_FORMAT_FIXED16: {
+        const int16_t* fixed = (const int16_t*)src;
+        for (unsigned int i = 0; i < n; i++)
+            dst[i] = ldexpf((float)fixed[i], -storage.fracBits);
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+float computeStorageTolerance(const ComputeStorage& storage, float value) {
+    const float magnitude = fabsf(value);
+    switch (storage.format) {
+    case COMPUTE_FORMAT_RGBA16F:
+    case COMPUTE_FORMAT_HALF_R32UI: {
+        // Drivers may clamp or overflow to infinity.
+        if (magnitude >= HALF_MAX)
+            return INFINITY;
+        int exponent;
+        frexpf(magnitude, &exponent);
+        return ldexpf(1.0f, (exponent > -13 ? exponent : -13) - 11);
+    }
+    case COMPUTE_FORMAT_FIXED16:
+        if (ldexpf(magnitude, storage.fracBits) >= FIXED_MAX)
+            return INFINITY;
+        return ldexpf(1.0f, -storage.fracBits);
+    default:
+        return 0.0f;
+    }
+}
+
+size_t formatComputeFormatReport(const ComputeFormatReport& report,
+        char* buf, size_t size) {
+    size_t len = snprintf(buf, size,
+            "format,bytes_per_point,max_abs_error,max_rel_error,rms_error,"
+            "gpu_us,gb_per_s,speedup\n");
+    const ComputeFormatReport::Row& reference = report.rows[COMPUTE_FORMAT_RGBA32F];
+    for (int i = 0; i < COMPUTE_FORMAT_COUNT; i++) {
+        const ComputeFormatReport::Row& row = report.rows[i];
+        len += snprintf(len < size ? buf + len : NULL, len < size ? size - len : 0,
+                "%s,%u,%g,%g,%g,%.1f,%.2f,%.2f\n", COMPUTE_FORMATS[i].name,
+                COMPUTE_FORMATS[i].bytesPerPoint, row.maxAbsError,
+                row.maxRelError, row.rmsError, row.gpuNs / 1000.0,
+                row.gbPerSecond,
+                row.gpuNs ? (double)reference.gpuNs / row.gpuNs : 0.0);
+    }
+    return len;
+}
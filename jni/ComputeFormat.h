@@ -0,0 +1,97 @@
+/*
+ * Copyright 2013 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef COMPUTEFORMAT_H
+#define COMPUTEFORMAT_H 1
+
+#include "gles3jni.h"
+
+// ----------------------------------------------------------------------------
+// Storage formats for the vec4 points of compute buffers, see the
+// VELOCITY_FORMAT and POSITION_FORMAT constants of shaders/compute.comp.
+// The kernel decodes on load and encodes on store, so it always works in
+// floats; the CPU side converts with encodeComputePoints() and
+// decodeComputePoints(), which round the way the GPU does.
+//
+// Everything but RGBA32F takes half the bytes, so twice the points fit in
+// the same memory and bandwidth, at the precision compareComputeFormats()
+// reports:
+// - RGBA16F: half floats, 11 significant bits, finite up to 65504
+// - HALF_R32UI: the same halves as packHalf2x16() pairs, two r32ui texels
+//   per point, for drivers without rgba16f image support
+// - FIXED16: rgba16i in signed Q format, value = int * 2^-fracBits, with
+//   fracBits chosen per buffer from the range of the data
+
+enum ComputeFormat {
+    COMPUTE_FORMAT_RGBA32F,
+    COMPUTE_FORMAT_RGBA16F,
+    COMPUTE_FORMAT_HALF_R32UI,
+    COMPUTE_FORMAT_FIXED16,
+    COMPUTE_FORMAT_COUNT
+};
+
+struct ComputeFormatInfo {
+    const char* name;
+    // of the texture buffer, and the image format in the shader
+    GLenum internalFormat;
+    unsigned int bytesPerPoint;
+    unsigned int texelsPerPoint;
+};
+extern const ComputeFormatInfo COMPUTE_FORMATS[COMPUTE_FORMAT_COUNT];
+
+// The format of one buffer. fracBits only applies to FIXED16.
+struct ComputeStorage {
+    ComputeFormat format;
+    int fracBits;
+};
+
+// Largest fracBits that holds values up to maxAbs without clipping.
+extern int computeFixedFracBits(float maxAbs);
+
+// Conversions between numPoints vec4s of floats and storage. Values out
+// of range clamp to the largest finite one of the format.
+extern void encodeComputePoints(const float* src, unsigned int numPoints,
+        const ComputeStorage& storage, void* dst);
+extern void decodeComputePoints(const void* src, unsigned int numPoints,
+        const ComputeStorage& storage, float* dst);
+
+// Error allowed between a float computed on the GPU and on the CPU once
+// stored as storage: the rounding step of the format at value.
+extern float computeStorageTolerance(const ComputeStorage& storage, float value);
+
+// Precision and throughput of each format against RGBA32F, as measured by
+// Renderer::compareComputeFormats(). Errors are over all components of the
+// kernel's output for the same input.
+struct ComputeFormatReport {
+    struct Row {
+        float maxAbsError;
+        float maxRelError;
+        float rmsError;
+        // GPU time per dispatch over the points, and the bytes it moved
+        // per second
+        uint64_t gpuNs;
+        float gbPerSecond;
+    };
+    unsigned int numPoints;
+    unsigned int dispatches;
+    Row rows[COMPUTE_FORMAT_COUNT];
+};
+// Writes the report as CSV with a header line, snprintf-style: returns the
+// length it needs, writing as much as fits in size.
+extern size_t formatComputeFormatReport(const ComputeFormatReport& report,
+        char* buf, size_t size);
+
+#endif // COMPUTEFORMAT_H
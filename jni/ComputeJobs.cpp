@@ -0,0 +1,311 @@
+/*
+ * Copyright 2013 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ComputeJobs.h"
+#include "DeviceCaps.h"
+#include "SharedResources.h"
+
+#include <string.h>
+#include <time.h>
+
+// slice size before anything is measured
+#define INITIAL_SLICE_GROUPS 64
+// the minimum GL_MAX_COMPUTE_WORK_GROUP_COUNT
+#define MAX_SLICE_GROUPS 65535
+// weight of each new timing in the cost per work group
+#define COST_SMOOTHING 0.25f
+
+static uint64_t monotonicNs() {
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec*1000000000ull + now.tv_nsec;
+}
+
+ComputeJobs::ComputeJobs()
+:   mNextId(1),
+    mTimed(false),
+    mFirstSlice(0),
+    mNumSlices(0),
+    mFirstTiming(0),
+    mNumTimings(0),
+    mSliceJob(0),
+    mSliceGroups(0),
+    mSliceTimed(false),
+    mNsPerGroup(0.0f),
+    mUntimedGroups(INITIAL_SLICE_GROUPS),
+    mCompleted(0),
+    mIssued(0),
+    mLate(0),
+    mDropped(0)
+{
+    memset(mJobs, 0, sizeof(mJobs));
+    memset(mSlices, 0, sizeof(mSlices));
+    memset(mTimings, 0, sizeof(mTimings));
+}
+
+void ComputeJobs::init() {
+    mTimed = mTimer.init() && mTimer.timestamps();
+    if (!mTimed)
+        mTimer.destroy();
+}
+
+void ComputeJobs::destroy(bool contextCurrent, SharedResources* shared) {
+    logStats();
+    for (unsigned int i = 0; i < mNumSlices; i++) {
+        GLsync fence = mSlices[(mFirstSlice + i) % MAX_SLICES].fence;
+        if (contextCurrent)
+            glDeleteSync(fence);
+        else
+            shared->deferDeleteSync(fence);
+    }
+    if (contextCurrent)
+        mTimer.destroy();
+    mNumSlices = mNumTimings = 0;
+    for (unsigned int i = 0; i < MAX_JOBS; i++) {
+        Job& job = mJobs[i];
+        if (job.id && !job.progress.finished && job.callback)
+            job.callback(job.id, false, job.user);
+        job.id = 0;
+    }
+}
+
+ComputeJobs::Job* ComputeJobs::find(unsigned int id) {
+    for (unsigned int i = 0; id && i < MAX_JOBS; i++) {
+        if (mJobs[i].id == id)
+            return &mJobs[i];
+    }
+    return NULL;
+}
+
+const ComputeJobs::Job* ComputeJobs::find(unsigned int id) const {
+    return const_cast<ComputeJobs*>(this)->find(id);
+}
+
+unsigned int ComputeJobs::submit(unsigned int kernel, const GLuint groups[3],
+        Callback callback, void* user) {
+    // A free entry, or else the one of the oldest finished job.
+    Job* job = NULL;
+    for (unsigned int i = 0; i < MAX_JOBS; i++) {
+        Job& j = mJobs[i];
+        if (!j.id) {
+            job = &j;
+            break;
+        }
+        if (j.progress.finished && (!job || j.id < job->id))
+            job = &j;
+    }
+    if (!job) {
+        mDropped++;
+        return 0;
+    }
+    memset(job, 0, sizeof(*job));
+    job->id = mNextId++;
+    if (!mNextId)
+        mNextId = 1;
+    job->kernel = kernel;
+    memcpy(job->groups, groups, sizeof(job->groups));
+    job->callback = callback;
+    job->user = user;
+    job->progress.groupsTotal = groups[0] * groups[1] * groups[2];
+    job->submitNs = monotonicNs();
+    return job->id;
+}
+
+unsigned int ComputeJobs::sliceGroups(uint64_t budgetNs) const {
+    if (!mTimed || mNsPerGroup <= 0.0f)
+        return mUntimedGroups;
+    const float groups = budgetNs / mNsPerGroup;
+    if (groups < 1.0f)
+        return 1;
+    return groups < MAX_SLICE_GROUPS ? (unsigned int)groups : MAX_SLICE_GROUPS;
+}
+
+static GLuint minGroups(uint64_t a, GLuint b, GLuint c) {
+    const GLuint ab = a < b ? (GLuint)a : b;
+    return ab < c ? ab : c;
+}
+
+bool ComputeJobs::nextSlice(uint64_t budgetNs, Slice* slice) const {
+    if (mNumSlices == MAX_SLICES)
+        return false;
+    const Job* job = NULL;
+    for (unsigned int i = 0; i < MAX_JOBS; i++) {
+        const Job& j = mJobs[i];
+        if (j.id && j.issued[0] < j.groups[0] && (!job || j.id < job->id))
+            job = &j;
+    }
+    if (!job)
+        return false;
+
+    const DeviceCaps& caps = deviceCaps();
+    GLuint maxGroups[3];
+    for (int i = 0; i < 3; i++) {
+        maxGroups[i] = caps.maxComputeWorkGroupCount[i] > 0 ?
+                caps.maxComputeWorkGroupCount[i] : MAX_SLICE_GROUPS;
+    }
+
+    const GLuint* total = job->groups;
+    const GLuint* next = job->issued;
+    const uint64_t budget = sliceGroups(budgetNs);
+    const uint64_t column = (uint64_t)total[1] * total[2];
+    if (next[1] == 0 && next[2] == 0 && column <= budget &&
+            total[1] <= maxGroups[1] && total[2] <= maxGroups[2]) {
+        // whole columns
+        slice->groups[0] = minGroups(budget / column, total[0] - next[0], maxGroups[0]);
+        slice->groups[1] = total[1];
+        slice->groups[2] = total[2];
+    } else if (next[2] == 0 && total[2] <= budget && total[2] <= maxGroups[2]) {
+        // whole rows of one column
+        slice->groups[0] = 1;
+        slice->groups[1] = minGroups(budget / total[2], total[1] - next[1], maxGroups[1]);
+        slice->groups[2] = total[2];
+    } else {
+        // part of one row
+        slice->groups[0] = 1;
+        slice->groups[1] = 1;
+        slice->groups[2] = minGroups(budget, total[2] - next[2], maxGroups[2]);
+    }
+    slice->job = job->id;
+    slice->kernel = job->kernel;
+    memcpy(slice->baseGroup, next, sizeof(slice->baseGroup));
+    return true;
+}
+
+void ComputeJobs::beginSlice(unsigned int job, const GLuint groups[3]) {
+    mSliceJob = job;
+    mSliceGroups = 0;
+    Job* j = find(job);
+    if (j) {
+        // Past the slice nextSlice() made: along z within the row, then
+        // along y within the column, then to the next column.
+        GLuint* next = j->issued;
+        if (next[2] + groups[2] < j->groups[2]) {
+            next[2] += groups[2];
+        } else {
+            next[2] = 0;
+            if (next[1] + groups[1] < j->groups[1]) {
+                next[1] += groups[1];
+            } else {
+                next[1] = 0;
+                next[0] += groups[0];
+            }
+        }
+        mSliceGroups = groups[0] * groups[1] * groups[2];
+        j->progress.groupsIssued += mSliceGroups;
+        j->progress.slices++;
+    }
+    mSliceTimed = mTimed && mTimer.begin();
+}
+
+void ComputeJobs::endSlice() {
+    if (mSliceTimed) {
+        mTimer.end();
+        Timed& t = mTimings[(mFirstTiming + mNumTimings++) % MAX_TIMED];
+        t.job = mSliceJob;
+        t.groups = mSliceGroups;
+    }
+    // nextSlice() keeps a place for this.
+    InFlight& s = mSlices[(mFirstSlice + mNumSlices++) % MAX_SLICES];
+    s.job = mSliceJob;
+    s.groups = mSliceGroups;
+    s.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    s.late = false;
+    mIssued++;
+}
+
+void ComputeJobs::addTiming(const Timed& timed, uint64_t ns) {
+    Job* job = find(timed.job);
+    if (job)
+        job->progress.gpuNs += ns;
+    if (!timed.groups)
+        return;
+    const float cost = (float)ns / timed.groups;
+    mNsPerGroup = mNsPerGroup > 0.0f ?
+            mNsPerGroup + COST_SMOOTHING * (cost - mNsPerGroup) : cost;
+}
+
+void ComputeJobs::complete(Job* job) {
+    job->progress.finished = true;
+    mCompleted++;
+    ALOGV("Compute job %u: %u work groups in %u slices, %.1f ms, %.2f ms on "
+            "the GPU", job->id, job->progress.groupsTotal, job->progress.slices,
+            (monotonicNs() - job->submitNs) / 1000000.0,
+            job->progress.gpuNs / 1000000.0);
+    if (job->callback)
+        job->callback(job->id, true, job->user);
+    job->callback = NULL;
+}
+
+void ComputeJobs::poll() {
+    // Timings are returned in slice order. Each one the timer is done
+    // with, returned or dropped for a disjoint event, is the oldest slice's.
+    for (;;) {
+        const unsigned int pending = mTimer.pending();
+        uint64_t ns = 0;
+        const bool measured = mTimer.poll(&ns);
+        for (unsigned int n = pending - mTimer.pending(); n > 0; n--) {
+            const Timed timed = mTimings[mFirstTiming];
+            mFirstTiming = (mFirstTiming + 1) % MAX_TIMED;
+            mNumTimings--;
+            if (measured && n == 1)
+                addTiming(timed, ns);
+        }
+        if (!measured)
+            break;
+    }
+
+    while (mNumSlices > 0) {
+        InFlight& s = mSlices[mFirstSlice];
+        GLenum status = glClientWaitSync(s.fence, 0, 0);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+            if (!s.late)
+                mLate++;
+            s.late = true;
+            break;
+        }
+        glDeleteSync(s.fence);
+        mFirstSlice = (mFirstSlice + 1) % MAX_SLICES;
+        mNumSlices--;
+        if (!mTimed) {
+            if (s.late)
+                mUntimedGroups = mUntimedGroups > 1 ? mUntimedGroups / 2 : 1;
+            else if (mUntimedGroups < MAX_SLICE_GROUPS / 2)
+                mUntimedGroups *= 2;
+        }
+        Job* job = find(s.job);
+        if (!job)
+            continue;
+        job->progress.groupsDone += s.groups;
+        if (job->progress.groupsDone == job->progress.groupsTotal)
+            complete(job);
+    }
+}
+
+bool ComputeJobs::progress(unsigned int job, Progress* progress) const {
+    const Job* j = find(job);
+    if (!j)
+        return false;
+    *progress = j->progress;
+    return true;
+}
+
+void ComputeJobs::logStats() const {
+    if (!mIssued && !mDropped)
+        return;
+    ALOGV("Compute jobs: %u completed in %u slices, %u slices late, %u jobs "
+            "dropped, %.1f ns per work group", mCompleted, mIssued, mLate,
+            mDropped, mNsPerGroup);
+}
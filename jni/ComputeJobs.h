@@ -0,0 +1,161 @@
+/*
+ * Copyright 2013 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef COMPUTEJOBS_H
+#define COMPUTEJOBS_H 1
+
+#include "gles3jni.h"
+#include "GpuTimer.h"
+
+class SharedResources;
+
+// ----------------------------------------------------------------------------
+// Runs kernels over more work groups than one dispatch should take, in
+// slices spread over frames. A dispatch can't be preempted, so a big one
+// holds up the frame's draws until it is done, and may trip the GPU
+// watchdog. A job is instead issued one slice per frame, each a dispatch of
+// the next work groups, which the kernel offsets by its baseGroup uniform
+// so that it sees the work group IDs of the whole job. A slice takes whole
+// y*z columns where the budget allows, else whole z rows of one column,
+// else part of one row, so that no slice is much over budget however the
+// job is shaped. Each dimension of a slice stays within
+// GL_MAX_COMPUTE_WORK_GROUP_COUNT. Slices go through the FrameScheduler
+// with the frame's other dispatches, ahead of its draws.
+//
+// Slices are sized to take about the budget given to nextSlice() on the
+// GPU, from the measured cost per work group. Each slice is timed with
+// timestamp queries; TIME_ELAPSED ones can't nest inside the frame
+// governor's, so without timestamps a slice grows while it finishes
+// within the frame and halves when it doesn't.
+//
+// Each slice is fenced, and a job is complete once the fence of its last
+// slice has signalled. Jobs are run oldest first; at most MAX_JOBS are
+// kept, finished ones until newer jobs need their place.
+
+class ComputeJobs {
+public:
+    typedef Renderer::ComputeJobProgress Progress;
+    // Called by poll() once all of the job's slices have finished on the
+    // GPU, or by destroy() with completed false for unfinished jobs.
+    typedef void (*Callback)(unsigned int job, bool completed, void* user);
+
+    struct Slice {
+        unsigned int job;
+        unsigned int kernel;
+        // first work group, and the work groups of the slice
+        GLuint baseGroup[3];
+        GLuint groups[3];
+    };
+
+    ComputeJobs();
+
+    // Sets up slice timing in the current context.
+    void init();
+    // Drops unfinished jobs and logs the stats. If the context isn't
+    // current, fences are handed to shared->deferDeleteSync(), and the
+    // queries go with the context.
+    void destroy(bool contextCurrent, SharedResources* shared);
+
+    // Queues a job of groups work groups. Returns its id, never 0, or 0 if
+    // there is no room for another job.
+    unsigned int submit(unsigned int kernel, const GLuint groups[3],
+            Callback callback, void* user);
+    // The slice to issue this frame: the next work groups of the oldest
+    // unfinished job, as many as take about budgetNs. Returns false if no
+    // job has work left to issue, or too many slices are in flight.
+    bool nextSlice(uint64_t budgetNs, Slice* slice) const;
+    // Bracket the dispatch of a slice from nextSlice(), groups being its
+    // work groups.
+    void beginSlice(unsigned int job, const GLuint groups[3]);
+    void endSlice();
+    // Collects finished slices and their timings, completing jobs. Call
+    // once per frame.
+    void poll();
+
+    // Returns false if the job isn't known (any more).
+    bool progress(unsigned int job, Progress* progress) const;
+    void logStats() const;
+
+private:
+    enum {
+        MAX_JOBS = 8,
+        MAX_SLICES = 4,
+        // GpuTimer::MAX_PENDING
+        MAX_TIMED = 8,
+    };
+
+    struct Job {
+        // 0 for a free entry
+        unsigned int id;
+        unsigned int kernel;
+        GLuint groups[3];
+        // first work group not issued yet; x is past the last column once
+        // all are
+        GLuint issued[3];
+        Callback callback;
+        void* user;
+        Progress progress;
+        uint64_t submitNs;
+    };
+    // a slice in flight, until its fence signals
+    struct InFlight {
+        unsigned int job;
+        unsigned int groups;
+        GLsync fence;
+        // still running when a poll() found it first in line
+        bool late;
+    };
+    // a slice whose timing hasn't been returned yet
+    struct Timed {
+        unsigned int job;
+        unsigned int groups;
+    };
+
+    Job* find(unsigned int id);
+    const Job* find(unsigned int id) const;
+    // work groups per slice for budgetNs
+    unsigned int sliceGroups(uint64_t budgetNs) const;
+    void addTiming(const Timed& timed, uint64_t ns);
+    void complete(Job* job);
+
+    Job mJobs[MAX_JOBS];
+    unsigned int mNextId;
+
+    GpuTimer mTimer;
+    bool mTimed;
+    InFlight mSlices[MAX_SLICES];
+    unsigned int mFirstSlice;
+    unsigned int mNumSlices;
+    Timed mTimings[MAX_TIMED];
+    unsigned int mFirstTiming;
+    unsigned int mNumTimings;
+    // the slice between beginSlice() and endSlice()
+    unsigned int mSliceJob;
+    unsigned int mSliceGroups;
+    bool mSliceTimed;
+
+    // measured GPU time per work group, 0 until the first timing; without
+    // timings, the fence-adjusted slice size instead
+    float mNsPerGroup;
+    unsigned int mUntimedGroups;
+
+    unsigned int mCompleted;
+    unsigned int mIssued;
+    unsigned int mLate;
+    unsigned int mDropped;
+};
+
+#endif // COMPUTEJOBS_H
@@ -0,0 +1,88 @@
+/*
+ * Copyright 2013 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ComputeKernels.h"
+#include "gles3jni.h"
+
+#include <math.h>
+
+static void velocityToPosition(const CpuInvocation& inv, void* shared,
+        void* priv, void* user) {
+    const VelocityToPositionArgs& args = *(const VelocityToPositionArgs*)user;
+    // imageStore() outside the image is ignored.
+    const uint32_t i = inv.globalId[0];
+    if (i >= args.numPoints)
+        return;
+    float* result = args.positions + 4*i;
+    if (args.debugIds) {
+        result[0] = inv.localId[0];
+        result[1] = inv.workGroupId[0];
+        result[2] = inv.localId[1];
+        result[3] = inv.workGroupId[1];
+    } else {
+        const float* vel = args.velocities + 4*i;
+        result[0] = vel[0];
+        result[1] = vel[1];
+        result[2] = vel[2] + 25.0f;
+        result[3] = vel[3] + 12.5f;
+    }
+}
+
+static const CpuKernel::Phase VELOCITY_TO_POSITION_PHASES[] = {
+    velocityToPosition,
+};
+
+const CpuKernel VELOCITY_TO_POSITION_KERNEL = {
+    "velocityToPosition", {1024, 1, 1}, 0, 0,
+    VELOCITY_TO_POSITION_PHASES, 1,
+};
+
+void initComputeVelocities(float* velocities, unsigned int numPoints) {
+    for (int i = 0; i < (int)numPoints; i++) {
+        velocities[i * 4 + 0] = -i * 4;
+        velocities[i * 4 + 1] = i * 4 + 1;
+        velocities[i * 4 + 2] = -i * 4 + 2;
+        velocities[i * 4 + 3] = i * 4 + 3;
+    }
+}
+
+void velocityToPositionRange(const float* velocities,
+        unsigned int numPoints, float* maxVelocity, float* maxPosition) {
+    static const float BIAS[4] = {0.0f, 0.0f, 25.0f, 12.5f};
+    *maxVelocity = *maxPosition = 0.0f;
+    for (unsigned int i = 0; i < numPoints * 4; i++) {
+        const float v = fabsf(velocities[i]);
+        const float p = fabsf(velocities[i] + BIAS[i % 4]);
+        *maxVelocity = v > *maxVelocity ? v : *maxVelocity;
+        *maxPosition = p > *maxPosition ? p : *maxPosition;
+    }
+}
+
+void logComputePositions(const float* positions, unsigned int numPoints,
+        unsigned int localSize) {
+    for (unsigned int i = 0; i < numPoints / localSize; i++) {
+        RLOGV("positions[%d]=(%f, %f, %f, %f)", i * localSize,
+            positions[i * localSize * 4 + 0],
+            positions[i * localSize * 4 + 1],
+            positions[i * localSize * 4 + 2],
+            positions[i * localSize * 4 + 3]);
+        RLOGV("positions[%d]=(%f, %f, %f, %f)", i * localSize + 1,
+            positions[(i * localSize + 1) * 4 + 0],
+            positions[(i * localSize + 1) * 4 + 1],
+            positions[(i * localSize + 1) * 4 + 2],
+            positions[(i * localSize + 1) * 4 + 3]);
+    }
+}
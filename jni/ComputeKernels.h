@@ -0,0 +1,53 @@
+/*
+ * Copyright 2013 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef COMPUTEKERNELS_H
+#define COMPUTEKERNELS_H 1
+
+#include "CpuCompute.h"
+
+// ----------------------------------------------------------------------------
+// CPU versions of the compute shaders in shaders/, run with cpuDispatch():
+// by Renderer::runCpuKernel() for a CMD_DISPATCH the renderer can't run,
+// by batch compute without GPU compute, and by debug builds to check the
+// GPU results. The broad phase has its own, see BroadPhase.h. Keep them in
+// sync with the shaders.
+
+// N6: max number of points that can be actually retrieved using MapBufferRange
+#define COMPUTE_POINTS (63*1024)
+
+// shaders/compute.comp over numPoints vec4s. debugIds is the DEBUG_IDS
+// feature. The kernel has the default LOCAL_SIZE; to match another
+// variant, run a copy with a different localSize.
+struct VelocityToPositionArgs {
+    const float* velocities;
+    float* positions;
+    unsigned int numPoints;
+    bool debugIds;
+};
+extern const CpuKernel VELOCITY_TO_POSITION_KERNEL;
+
+// The velocities the renderers run the kernel on.
+extern void initComputeVelocities(float* velocities, unsigned int numPoints);
+// Largest magnitudes of the kernel's input and output components for
+// velocities, which size fixed-point storage, see ComputeFormat.h.
+extern void velocityToPositionRange(const float* velocities,
+        unsigned int numPoints, float* maxVelocity, float* maxPosition);
+// Logs the first two positions of each work group of localSize points.
+extern void logComputePositions(const float* positions, unsigned int numPoints,
+        unsigned int localSize);
+
+#endif // COMPUTEKERNELS_H
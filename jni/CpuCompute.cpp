@@ -0,0 +1,119 @@
+/*
+ * Copyright 2013 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "CpuCompute.h"
+#include "ThreadPool.h"
+#include "gles3jni.h"
+
+#include <stdlib.h>
+
+// invocations per task below which splitting a dispatch costs more than it
+// saves
+#define MIN_TASK_INVOCATIONS 4096
+// tasks per thread, so uneven work groups still balance
+#define TASKS_PER_THREAD 4
+
+// scratch blocks are aligned for any type a kernel may keep in them
+static inline size_t alignScratch(size_t size) {
+    return (size + 15) & ~(size_t)15;
+}
+
+struct CpuDispatchJob {
+    const CpuKernel* kernel;
+    const uint32_t* groups;
+    void* user;
+    uint64_t numGroups;
+    unsigned int numTasks;
+    // per task: shared block, then the private blocks of the group
+    unsigned char* scratch;
+    size_t scratchBytes;
+    size_t sharedBytes;
+    size_t invocationBytes;
+};
+
+static void runWorkGroup(const CpuDispatchJob& job, uint64_t group, unsigned char* scratch) {
+    const CpuKernel& kernel = *job.kernel;
+    const uint32_t* size = kernel.localSize;
+    const uint32_t invocations = size[0] * size[1] * size[2];
+
+    CpuInvocation inv;
+    inv.numWorkGroups = job.groups;
+    inv.workGroupId[0] = (uint32_t)(group % job.groups[0]);
+    inv.workGroupId[1] = (uint32_t)(group / job.groups[0] % job.groups[1]);
+    inv.workGroupId[2] = (uint32_t)(group / job.groups[0] / job.groups[1]);
+
+    void* shared = scratch;
+    unsigned char* priv = scratch + job.sharedBytes;
+    for (unsigned int p = 0; p < kernel.numPhases; p++) {
+        for (uint32_t i = 0; i < invocations; i++) {
+            inv.localIndex = i;
+            inv.localId[0] = i % size[0];
+            inv.localId[1] = i / size[0] % size[1];
+            inv.localId[2] = i / size[0] / size[1];
+            for (int d = 0; d < 3; d++)
+                inv.globalId[d] = inv.workGroupId[d] * size[d] + inv.localId[d];
+            kernel.phases[p](inv, shared, priv + i * job.invocationBytes, job.user);
+        }
+    }
+}
+
+static void dispatchTask(void* user, unsigned int task) {
+    const CpuDispatchJob& job = *(const CpuDispatchJob*)user;
+    const uint64_t begin = job.numGroups * task / job.numTasks;
+    const uint64_t end = job.numGroups * (task + 1) / job.numTasks;
+    unsigned char* scratch = job.scratch + task * job.scratchBytes;
+    for (uint64_t group = begin; group < end; group++)
+        runWorkGroup(job, group, scratch);
+}
+
+bool cpuDispatch(const CpuKernel& kernel, const uint32_t groups[3], void* user) {
+    const uint64_t numGroups = (uint64_t)groups[0] * groups[1] * groups[2];
+    const uint64_t invocations =
+            (uint64_t)kernel.localSize[0] * kernel.localSize[1] * kernel.localSize[2];
+    if (numGroups == 0 || invocations == 0)
+        return true;
+
+    ThreadPool& pool = ThreadPool::shared();
+    uint64_t numTasks = numGroups * invocations / MIN_TASK_INVOCATIONS;
+    if (numTasks > pool.threads() * TASKS_PER_THREAD)
+        numTasks = pool.threads() * TASKS_PER_THREAD;
+    if (numTasks > numGroups)
+        numTasks = numGroups;
+    if (numTasks == 0)
+        numTasks = 1;
+
+    CpuDispatchJob job;
+    job.kernel = &kernel;
+    job.groups = groups;
+    job.user = user;
+    job.numGroups = numGroups;
+    job.numTasks = (unsigned int)numTasks;
+    job.sharedBytes = alignScratch(kernel.sharedBytes);
+    job.invocationBytes = alignScratch(kernel.invocationBytes);
+    job.scratchBytes = job.sharedBytes + invocations * job.invocationBytes;
+    job.scratch = NULL;
+    if (job.scratchBytes) {
+        job.scratch = (unsigned char*)malloc(numTasks * job.scratchBytes);
+        if (!job.scratch) {
+            ALOGE("CPU compute: out of memory for %s scratch", kernel.name);
+            return false;
+        }
+    }
+
+    pool.run(job.numTasks, dispatchTask, &job);
+    free(job.scratch);
+    return true;
+}
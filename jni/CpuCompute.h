@@ -0,0 +1,71 @@
+/*
+ * Copyright 2013 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CPUCOMPUTE_H
+#define CPUCOMPUTE_H 1
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ----------------------------------------------------------------------------
+// Runs compute kernels on the CPU with the execution model of ES 3.1
+// compute shaders, for devices without them and as a reference to check
+// the GPU versions against.
+//
+// A kernel is a list of phases, each a function run once per invocation.
+// The step from one phase to the next acts as barrier() followed by
+// memoryBarrierShared(): every invocation of a work group finishes a phase
+// before any of them starts the next. Work group shared variables live in
+// a block of sharedBytes, and values an invocation keeps across a barrier
+// in a private block of invocationBytes. Both start out undefined, as on
+// the GPU.
+//
+// Work groups are spread over ThreadPool::shared(); the invocations of one
+// group run on one thread, in local index order. As on the GPU, work groups
+// must not depend on each other, and writes from different groups to the
+// same memory must use atomics (the __atomic builtins).
+
+struct CpuInvocation {
+    // gl_GlobalInvocationID, gl_LocalInvocationID, gl_WorkGroupID
+    uint32_t globalId[3];
+    uint32_t localId[3];
+    uint32_t workGroupId[3];
+    // gl_LocalInvocationIndex
+    uint32_t localIndex;
+    // gl_NumWorkGroups
+    const uint32_t* numWorkGroups;
+};
+
+struct CpuKernel {
+    typedef void (*Phase)(const CpuInvocation& invocation, void* shared,
+            void* priv, void* user);
+
+    const char* name;
+    // layout(local_size_x, local_size_y, local_size_z)
+    uint32_t localSize[3];
+    size_t sharedBytes;
+    size_t invocationBytes;
+    const Phase* phases;
+    unsigned int numPhases;
+};
+
+// Runs groups[0] x groups[1] x groups[2] work groups of kernel, passing
+// user to every phase, and returns once all of them are done. Returns false
+// if out of memory, with nothing run.
+extern bool cpuDispatch(const CpuKernel& kernel, const uint32_t groups[3],
+        void* user);
+
+#endif // CPUCOMPUTE_H
@@ -0,0 +1,173 @@
+/*
+ * Copyright 2013 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DeviceCaps.h"
+
+#include <limits.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+
+// Bump when DeviceCaps, or how it is probed, changes.
+#define CACHE_FORMAT 2
+#define CACHE_FILE "devicecaps.bin"
+
+struct CacheHeader {
+    char magic[4];
+    unsigned int format;
+    unsigned int size;
+};
+
+static char sCacheDir[PATH_MAX];
+static pthread_once_t sOnce = PTHREAD_ONCE_INIT;
+static DeviceCaps sCaps;
+
+void setDeviceCapsCacheDir(const char* dir) {
+    snprintf(sCacheDir, sizeof(sCacheDir), "%s", dir ? dir : "");
+}
+
+static void copyGlString(char* dst, size_t size, GLenum name) {
+    const char* s = (const char*)glGetString(name);
+    snprintf(dst, size, "%s", s ? s : "");
+}
+
+static bool cachePath(char* path, size_t size) {
+    if (!sCacheDir[0])
+        return false;
+    return (size_t)snprintf(path, size, "%s/%s", sCacheDir, CACHE_FILE) < size;
+}
+
+// Returns true if the cached profile is for the same renderer and driver.
+static bool loadCache(DeviceCaps* caps) {
+    char path[PATH_MAX];
+    if (!cachePath(path, sizeof(path)))
+        return false;
+    FILE* f = fopen(path, "rb");
+    if (!f)
+        return false;
+
+    CacheHeader header;
+    DeviceCaps cached;
+    bool ok = fread(&header, sizeof(header), 1, f) == 1 &&
+            memcmp(header.magic, "DCAP", 4) == 0 &&
+            header.format == CACHE_FORMAT &&
+            header.size == sizeof(DeviceCaps) &&
+            fread(&cached, sizeof(cached), 1, f) == 1;
+    fclose(f);
+    if (!ok || strcmp(cached.renderer, caps->renderer) != 0 ||
+            strcmp(cached.version, caps->version) != 0) {
+        return false;
+    }
+    *caps = cached;
+    return true;
+}
+
+static void saveCache(const DeviceCaps& caps) {
+    char path[PATH_MAX], tmp[PATH_MAX];
+    if (!cachePath(path, sizeof(path)) ||
+            (size_t)snprintf(tmp, sizeof(tmp), "%s.tmp", path) >= sizeof(tmp)) {
+        return;
+    }
+    FILE* f = fopen(tmp, "wb");
+    if (!f) {
+        ALOGE("Could not write %s", tmp);
+        return;
+    }
+    CacheHeader header;
+    memcpy(header.magic, "DCAP", 4);
+    header.format = CACHE_FORMAT;
+    header.size = sizeof(DeviceCaps);
+    bool ok = fwrite(&header, sizeof(header), 1, f) == 1 &&
+            fwrite(&caps, sizeof(caps), 1, f) == 1;
+    ok = fclose(f) == 0 && ok;
+    // Renaming is atomic, so a crash never leaves a torn profile behind.
+    if (!ok || rename(tmp, path) != 0) {
+        ALOGE("Could not write %s", path);
+        remove(tmp);
+    }
+}
+
+static void probe(DeviceCaps* caps) {
+    copyGlString(caps->vendor, sizeof(caps->vendor), GL_VENDOR);
+    caps->glCaps = probeGlCaps();
+
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &caps->maxTextureSize);
+    glGetIntegerv(GL_MAX_VERTEX_UNIFORM_VECTORS, &caps->maxVertexUniformVectors);
+    if (caps->glCaps & GLCAP_ES30)
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &caps->uniformBufferOffsetAlignment);
+
+    if (caps->glCaps & GLCAP_ES31) {
+        glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT,
+                &caps->shaderStorageBufferOffsetAlignment);
+        glGetInteger64v(GL_MAX_SHADER_STORAGE_BLOCK_SIZE, &caps->maxShaderStorageBlockSize);
+        glGetIntegerv(GL_MAX_COMPUTE_SHARED_MEMORY_SIZE, &caps->maxComputeSharedMemorySize);
+        glGetIntegerv(GL_MAX_COMPUTE_SHADER_STORAGE_BLOCKS,
+                &caps->maxComputeShaderStorageBlocks);
+        glGetIntegerv(GL_MAX_COMPUTE_WORK_GROUP_INVOCATIONS,
+                &caps->maxComputeWorkGroupInvocations);
+        for (GLuint i = 0; i < 3; i++) {
+            glGetIntegeri_v(GL_MAX_COMPUTE_WORK_GROUP_COUNT, i, &caps->maxComputeWorkGroupCount[i]);
+            glGetIntegeri_v(GL_MAX_COMPUTE_WORK_GROUP_SIZE, i, &caps->maxComputeWorkGroupSize[i]);
+        }
+    }
+
+    if (caps->glCaps & GLCAP_TEXTURE_BUFFER) {
+        glGetIntegerv(GL_TEXTURE_BUFFER_OFFSET_ALIGNMENT_EXT,
+                &caps->textureBufferOffsetAlignment);
+        glGetInteger64v(GL_MAX_TEXTURE_BUFFER_SIZE_EXT, &caps->maxTextureBufferSize);
+    }
+
+    if (caps->glCaps & GLCAP_DISJOINT_TIMER_QUERY)
+        glGetQueryivEXT(GL_TIMESTAMP_EXT, GL_QUERY_COUNTER_BITS_EXT, &caps->timestampBits);
+
+    // A driver that rejects one of the queries leaves that limit at 0.
+    checkGlError("DeviceCaps probe");
+}
+
+static void initDeviceCaps() {
+    DeviceCaps* caps = &sCaps;
+    memset(caps, 0, sizeof(*caps));
+    copyGlString(caps->renderer, sizeof(caps->renderer), GL_RENDERER);
+    copyGlString(caps->version, sizeof(caps->version), GL_VERSION);
+
+    bool cached = loadCache(caps);
+    if (!cached) {
+        probe(caps);
+        saveCache(*caps);
+    }
+
+    char names[512];
+    formatGlCaps(caps->glCaps, names, sizeof(names));
+    ALOGV("GL %s on %s (%s), %s", caps->version, caps->renderer, caps->vendor,
+            cached ? "cached profile" : "probed");
+    ALOGV("GL caps: %s", names);
+    if (caps->glCaps & GLCAP_ES31) {
+        ALOGV("GL compute: %d invocations, work groups (%d, %d, %d) of up to "
+                "(%d, %d, %d), %d bytes shared, %lld byte storage blocks",
+                caps->maxComputeWorkGroupInvocations,
+                caps->maxComputeWorkGroupCount[0], caps->maxComputeWorkGroupCount[1],
+                caps->maxComputeWorkGroupCount[2],
+                caps->maxComputeWorkGroupSize[0], caps->maxComputeWorkGroupSize[1],
+                caps->maxComputeWorkGroupSize[2],
+                caps->maxComputeSharedMemorySize,
+                (long long)caps->maxShaderStorageBlockSize);
+    }
+}
+
+const DeviceCaps& deviceCaps() {
+    pthread_once(&sOnce, initDeviceCaps);
+    return sCaps;
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright 2013 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DEVICECAPS_H
+#define DEVICECAPS_H 1
+
+#include "gles3jni.h"
+
+// ----------------------------------------------------------------------------
+// What the GPU and driver can do, in one place. Every subsystem that picks
+// a code path or sizes something after the hardware reads it from here
+// rather than asking GL.
+//
+// The profile is probed once per process, from the first context that
+// asks. It is then saved in the cache directory the app passes in (see
+// setDeviceCapsCacheDir()), keyed by GL_RENDERER and GL_VERSION, so that
+// later starts with the same GPU and driver only read those two strings.
+// A driver update changes GL_VERSION and so triggers a new probe.
+//
+// Limits of features the context doesn't have (see glCaps) are 0.
+
+struct DeviceCaps {
+    char vendor[64];
+    char renderer[128];
+    char version[128];
+
+    // GlCap bitmask
+    unsigned int glCaps;
+
+    GLint maxTextureSize;
+    GLint maxVertexUniformVectors;
+    GLint uniformBufferOffsetAlignment;
+
+    // ES 3.1
+    GLint shaderStorageBufferOffsetAlignment;
+    GLint64 maxShaderStorageBlockSize;
+    GLint maxComputeSharedMemorySize;
+    GLint maxComputeShaderStorageBlocks;
+    GLint maxComputeWorkGroupInvocations;
+    GLint maxComputeWorkGroupCount[3];
+    GLint maxComputeWorkGroupSize[3];
+
+    // GLCAP_TEXTURE_BUFFER
+    GLint textureBufferOffsetAlignment;
+    GLint64 maxTextureBufferSize;
+
+    // GLCAP_DISJOINT_TIMER_QUERY: bits of the GL_TIMESTAMP_EXT counter,
+    // 0 if only TIME_ELAPSED queries work
+    GLint timestampBits;
+};
+
+// Where the profile is cached. Call before the first context is created;
+// without it the profile is probed on every start.
+extern void setDeviceCapsCacheDir(const char* dir);
+// The profile of this device. The first call needs a current context.
+extern const DeviceCaps& deviceCaps();
+
+#endif // DEVICECAPS_H
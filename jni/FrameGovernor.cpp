@@ -0,0 +1,215 @@
+/*
+ * Copyright 2013 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FrameGovernor.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// Best quality first, which is the work of a frame without a governor, so
+// every other level only sheds work. Resolution goes first, and instances
+// only as a last resort.
+static const GovernorLevel LEVELS[] = {
+    {1.00f, 1.00f},
+    {1.00f, 0.85f},
+    {1.00f, 0.70f},
+    {0.75f, 0.70f},
+    {0.50f, 0.60f},
+    {0.25f, 0.50f},
+};
+static const unsigned int NUM_LEVELS = sizeof(LEVELS) / sizeof(LEVELS[0]);
+
+#define DEFAULT_TARGET_MS 16.6f
+#define DEFAULT_P99_BOUND_MS 20.0f
+// upgrade only while the p99 stays below this fraction of the target
+#define UPGRADE_HEADROOM 0.7f
+
+static const char* const REASON_NAMES[] = {"p99", "mean", "headroom", "budget"};
+
+static uint64_t monotonicNs() {
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec*1000000000ull + now.tv_nsec;
+}
+
+static int compareFloats(const void* a, const void* b) {
+    float fa = *(const float*)a;
+    float fb = *(const float*)b;
+    return fa < fb ? -1 : fa > fb ? 1 : 0;
+}
+
+void FrameGovernor::Window::add(float v) {
+    ms[next] = v;
+    next = (next + 1) % WINDOW_FRAMES;
+    if (count < WINDOW_FRAMES)
+        count++;
+}
+
+void FrameGovernor::Window::stats(float* mean, float* p99) const {
+    *mean = *p99 = 0.0f;
+    if (!count)
+        return;
+    float sorted[WINDOW_FRAMES];
+    float sum = 0.0f;
+    for (unsigned int i = 0; i < count; i++) {
+        sorted[i] = ms[i];
+        sum += ms[i];
+    }
+    qsort(sorted, count, sizeof(float), compareFloats);
+    *mean = sum / count;
+    *p99 = sorted[(count * 99) / 100];
+}
+
+FrameGovernor::FrameGovernor()
+:   mTargetMs(DEFAULT_TARGET_MS),
+    mP99BoundMs(DEFAULT_P99_BOUND_MS),
+    mLevel(0),
+    mUpgradeEvals(0),
+    mGpuTimerInit(false),
+    mGpuStale(0),
+    mInFrame(false),
+    mFrameStartNs(0),
+    mFrame(0),
+    mSinceEval(0),
+    mLogNext(0),
+    mLogCount(0)
+{
+    mCpu.reset();
+    mGpu.reset();
+}
+
+void FrameGovernor::setBudget(float targetMs, float p99BoundMs) {
+    mTargetMs = targetMs;
+    mP99BoundMs = p99BoundMs > targetMs ? p99BoundMs : targetMs;
+    changeLevel(0, REASON_BUDGET, 0.0f, 0.0f, 0.0f, 0.0f);
+}
+
+void FrameGovernor::beginFrame() {
+    if (mInFrame)
+        return;
+    if (!mGpuTimerInit) {
+        mGpuTimer.init();
+        mGpuTimerInit = true;
+    }
+    mInFrame = true;
+    mFrameStartNs = monotonicNs();
+    mGpuTimer.begin();
+}
+
+void FrameGovernor::endFrame() {
+    if (!mInFrame)
+        return;
+    mGpuTimer.end();
+    mInFrame = false;
+    mFrame++;
+    if (mTargetMs <= 0.0f)
+        return;
+
+    mCpu.add((monotonicNs() - mFrameStartNs) * 0.000001f);
+    uint64_t gpuNs;
+    while (mGpuTimer.poll(&gpuNs)) {
+        if (mGpuStale > 0)
+            mGpuStale--;
+        else
+            mGpu.add(gpuNs * 0.000001f);
+    }
+
+    if (++mSinceEval >= EVAL_INTERVAL && mCpu.count == WINDOW_FRAMES) {
+        mSinceEval = 0;
+        evaluate();
+    }
+}
+
+void FrameGovernor::destroy() {
+    mGpuTimer.destroy();
+    mGpuTimerInit = false;
+    mInFrame = false;
+}
+
+const GovernorLevel& FrameGovernor::level() const {
+    return LEVELS[mLevel];
+}
+
+unsigned int FrameGovernor::scaleInstances(unsigned int count) const {
+    unsigned int scaled = (unsigned int)(count * LEVELS[mLevel].instanceFraction + 0.5f);
+    return scaled > 0 || count == 0 ? scaled : 1;
+}
+
+void FrameGovernor::evaluate() {
+    float cpuMean, cpuP99, gpuMean, gpuP99;
+    mCpu.stats(&cpuMean, &cpuP99);
+    mGpu.stats(&gpuMean, &gpuP99);
+    // CPU and GPU work overlap, so the frame is as slow as the slower one.
+    float mean = fmaxf(cpuMean, gpuMean);
+    float p99 = fmaxf(cpuP99, gpuP99);
+
+    if (p99 > mP99BoundMs || mean > mTargetMs) {
+        mUpgradeEvals = 0;
+        if (mLevel + 1 < NUM_LEVELS) {
+            changeLevel(mLevel + 1, p99 > mP99BoundMs ? REASON_P99 : REASON_MEAN,
+                    cpuMean, cpuP99, gpuMean, gpuP99);
+        }
+    } else if (p99 < mTargetMs * UPGRADE_HEADROOM) {
+        if (++mUpgradeEvals >= UPGRADE_EVALS && mLevel > 0) {
+            changeLevel(mLevel - 1, REASON_HEADROOM,
+                    cpuMean, cpuP99, gpuMean, gpuP99);
+        }
+    } else {
+        mUpgradeEvals = 0;
+    }
+}
+
+void FrameGovernor::changeLevel(unsigned int level, Reason reason,
+        float cpuMean, float cpuP99, float gpuMean, float gpuP99) {
+    Decision& d = mLog[mLogNext];
+    d.frame = mFrame;
+    d.fromLevel = mLevel;
+    d.toLevel = level;
+    d.reason = reason;
+    d.cpuMeanMs = cpuMean;
+    d.cpuP99Ms = cpuP99;
+    d.gpuMeanMs = gpuMean;
+    d.gpuP99Ms = gpuP99;
+    mLogNext = (mLogNext + 1) % LOG_SIZE;
+    if (mLogCount < LOG_SIZE)
+        mLogCount++;
+
+    RLOGV("Governor: level %u -> %u (%s) at frame %llu, cpu %.2f/%.2f ms,"
+            " gpu %.2f/%.2f ms", mLevel, level, REASON_NAMES[reason],
+            (unsigned long long)mFrame, cpuMean, cpuP99, gpuMean, gpuP99);
+
+    mLevel = level;
+    mUpgradeEvals = 0;
+    mSinceEval = 0;
+    mCpu.reset();
+    mGpu.reset();
+    mGpuStale = mGpuTimer.pending();
+}
+
+size_t FrameGovernor::formatLog(char* buf, size_t size) const {
+    size_t len = snprintf(buf, size,
+            "frame,from,to,reason,cpu_mean_ms,cpu_p99_ms,gpu_mean_ms,gpu_p99_ms\n");
+    for (unsigned int i = 0; i < mLogCount; i++) {
+        const Decision& d = mLog[(mLogNext + LOG_SIZE - mLogCount + i) % LOG_SIZE];
+        len += snprintf(len < size ? buf + len : NULL, len < size ? size - len : 0,
+                "%llu,%u,%u,%s,%.3f,%.3f,%.3f,%.3f\n",
+                (unsigned long long)d.frame, d.fromLevel, d.toLevel,
+                REASON_NAMES[d.reason], d.cpuMeanMs, d.cpuP99Ms,
+                d.gpuMeanMs, d.gpuP99Ms);
+    }
+    return len;
+}
@@ -0,0 +1,126 @@
+/*
+ * Copyright 2013 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FRAMEGOVERNOR_H
+#define FRAMEGOVERNOR_H 1
+
+#include "GpuTimer.h"
+
+// ----------------------------------------------------------------------------
+// Scales the per-frame workload to hold a frame time budget.
+//
+// The governor measures the CPU time of each frame and, where available, its
+// GPU time (see GpuTimer). Every EVAL_INTERVAL frames it looks at the last
+// WINDOW_FRAMES samples of each and moves along a ladder of quality levels,
+// each trading off instance count and render resolution:
+// - one step down as soon as the p99 exceeds the p99 bound, or the mean
+//   exceeds the target
+// - one step up only after UPGRADE_EVALS evaluations in a row with the p99
+//   comfortably under the target
+// After each change the window restarts, so a level is judged only on its
+// own frames. Changes are logged and kept in a small ring for export.
+
+struct GovernorLevel {
+    // fraction of the built-in instances to animate and draw
+    float instanceFraction;
+    // render resolution relative to the surface, per axis
+    float resolutionScale;
+};
+
+class FrameGovernor {
+public:
+    enum Reason {
+        REASON_P99,      // degraded: p99 over the bound
+        REASON_MEAN,     // degraded: mean over the target
+        REASON_HEADROOM, // upgraded
+        REASON_BUDGET,   // budget changed, back to the top level
+    };
+
+    struct Decision {
+        uint64_t frame;
+        unsigned int fromLevel;
+        unsigned int toLevel;
+        Reason reason;
+        float cpuMeanMs, cpuP99Ms;
+        // zero without GPU timing
+        float gpuMeanMs, gpuP99Ms;
+    };
+
+    FrameGovernor();
+
+    // Sets the frame time target and the bound on its p99, in milliseconds.
+    // A target <= 0 disables the governor and restores full quality.
+    void setBudget(float targetMs, float p99BoundMs);
+
+    // Bracket the work of one frame. The GL context must be current.
+    // beginFrame() may be called more than once per frame; only the first
+    // call counts.
+    void beginFrame();
+    void endFrame();
+    // Deletes the GPU timer queries. The context must be current.
+    void destroy();
+
+    const GovernorLevel& level() const;
+    unsigned int scaleInstances(unsigned int count) const;
+
+    // Writes the decision log as CSV, oldest first, NUL-terminated and
+    // truncated to size bytes. Returns the length of the full text.
+    size_t formatLog(char* buf, size_t size) const;
+
+private:
+    enum {
+        WINDOW_FRAMES = 120,
+        EVAL_INTERVAL = 30,
+        UPGRADE_EVALS = 4,
+        LOG_SIZE = 64,
+    };
+
+    struct Window {
+        float ms[WINDOW_FRAMES];
+        unsigned int next;
+        unsigned int count;
+        void reset() { next = count = 0; }
+        void add(float v);
+        // mean and p99 of the samples; zero if empty
+        void stats(float* mean, float* p99) const;
+    };
+
+    void evaluate();
+    void changeLevel(unsigned int level, Reason reason,
+            float cpuMean, float cpuP99, float gpuMean, float gpuP99);
+
+    float mTargetMs;
+    float mP99BoundMs;
+    unsigned int mLevel;
+    unsigned int mUpgradeEvals;
+
+    GpuTimer mGpuTimer;
+    bool mGpuTimerInit;
+    // GPU results still in flight from before the last level change
+    unsigned int mGpuStale;
+    bool mInFrame;
+    uint64_t mFrameStartNs;
+    uint64_t mFrame;
+    unsigned int mSinceEval;
+    Window mCpu;
+    Window mGpu;
+
+    Decision mLog[LOG_SIZE];
+    unsigned int mLogNext;
+    unsigned int mLogCount;
+};
+
+#endif // FRAMEGOVERNOR_H
@@ -0,0 +1,112 @@
+/*
+ * Copyright 2013 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FrameScheduler.h"
+#include "SharedResources.h"
+
+#include <string.h>
+
+// Every way the renderers read kernel outputs on the GPU.
+static const GLbitfield CONSUMER_BARRIER_BITS =
+        GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT |
+        GL_SHADER_STORAGE_BARRIER_BIT |
+        GL_SHADER_IMAGE_ACCESS_BARRIER_BIT |
+        GL_TEXTURE_FETCH_BARRIER_BIT;
+
+FrameScheduler::FrameScheduler()
+:   mNumQueued(0),
+    mFence(0),
+    mIssuing(false),
+    mBatches(0),
+    mOverlapped(0),
+    mDispatches(0),
+    mDropped(0)
+{
+    memset(mQueue, 0, sizeof(mQueue));
+}
+
+void FrameScheduler::destroy(bool contextCurrent, SharedResources* shared) {
+    logStats();
+    if (mFence) {
+        if (contextCurrent)
+            glDeleteSync(mFence);
+        else
+            shared->deferDeleteSync(mFence);
+        mFence = 0;
+    }
+    mNumQueued = 0;
+}
+
+bool FrameScheduler::queue(unsigned int kernel, GLuint groupsX, GLuint groupsY,
+        GLuint groupsZ) {
+    if (mNumQueued == MAX_DISPATCHES) {
+        mDropped++;
+        return false;
+    }
+    Dispatch& d = mQueue[mNumQueued++];
+    d.kernel = kernel;
+    d.groups[0] = groupsX;
+    d.groups[1] = groupsY;
+    d.groups[2] = groupsZ;
+    d.job = 0;
+    memset(d.baseGroup, 0, sizeof(d.baseGroup));
+    return true;
+}
+
+bool FrameScheduler::queueSlice(unsigned int job, unsigned int kernel,
+        const GLuint baseGroup[3], const GLuint groups[3]) {
+    if (!queue(kernel, groups[0], groups[1], groups[2]))
+        return false;
+    Dispatch& d = mQueue[mNumQueued - 1];
+    d.job = job;
+    memcpy(d.baseGroup, baseGroup, sizeof(d.baseGroup));
+    return true;
+}
+
+unsigned int FrameScheduler::beginBatch(const Dispatch** dispatches) {
+    if (mFence) {
+        // A zero timeout only polls; the GPU has had a whole frame.
+        GLenum status = glClientWaitSync(mFence, 0, 0);
+        if (status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED)
+            mOverlapped++;
+        glDeleteSync(mFence);
+        mFence = 0;
+        glMemoryBarrier(CONSUMER_BARRIER_BITS);
+    }
+    *dispatches = mQueue;
+    mIssuing = mNumQueued > 0;
+    return mNumQueued;
+}
+
+void FrameScheduler::endBatch() {
+    if (!mIssuing)
+        return;
+    mFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    mBatches++;
+    mDispatches += mNumQueued;
+    mNumQueued = 0;
+    mIssuing = false;
+}
+
+void FrameScheduler::logStats() const {
+    if (!mBatches && !mDropped)
+        return;
+    unsigned int checked = checkedBatches();
+    ALOGV("Frame scheduler: %u dispatches in %u batches, %u of %u (%.1f%%) "
+            "finished within the next frame, %u dropped",
+            mDispatches, mBatches, mOverlapped, checked,
+            checked ? 100.0f * mOverlapped / checked : 0.0f, mDropped);
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright 2013 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FRAMESCHEDULER_H
+#define FRAMESCHEDULER_H 1
+
+#include "gles3jni.h"
+
+class SharedResources;
+
+// ----------------------------------------------------------------------------
+// Pipelines compute dispatches with rendering. Dispatches requested during
+// frame N are issued at the start of frame N's GPU work, ahead of its
+// draws, and their results are consumed from frame N+1 on. Nothing orders
+// the two, so the GPU is free to run frame N+1's compute alongside frame
+// N's rendering.
+//
+// A frame's GPU work is therefore
+//     memory barrier   (makes the previous batch visible)
+//     dispatches       (the next frame's compute)
+//     draws            (this frame)
+// The barrier only has the bits for the ways kernel outputs are consumed
+// on the GPU: vertex fetch, storage buffers, images and texel fetches.
+// Readbacks to the CPU need a barrier of their own.
+//
+// Each batch is fenced. When the next frame's barrier is issued the fence
+// tells whether the batch had already finished, i.e. whether it ran fully
+// in the shadow of the previous frame, or the barrier may hold up the GPU.
+// That ratio is the overlap reported by logStats() and, through the
+// renderer, by Renderer::dispatchStats().
+
+class FrameScheduler {
+public:
+    struct Dispatch {
+        unsigned int kernel;
+        GLuint groups[3];
+        // for a slice of a ComputeJobs job, its id and first work group;
+        // 0 for whole dispatches
+        unsigned int job;
+        GLuint baseGroup[3];
+    };
+
+    FrameScheduler();
+
+    // Logs the stats and deletes the fence. If the context isn't current
+    // the fence is handed to shared->deferDeleteSync() instead.
+    void destroy(bool contextCurrent, SharedResources* shared);
+
+    // Queues a dispatch for the next batch. Returns false if the batch is
+    // full.
+    bool queue(unsigned int kernel, GLuint groupsX, GLuint groupsY,
+            GLuint groupsZ);
+    // Queues a slice of a job, see ComputeJobs.
+    bool queueSlice(unsigned int job, unsigned int kernel, const GLuint baseGroup[3],
+            const GLuint groups[3]);
+
+    // Starts a frame's GPU work: issues the barrier for the previous batch,
+    // if there was one, and returns the dispatches queued since. The
+    // caller issues them, then calls endBatch(), before drawing.
+    unsigned int beginBatch(const Dispatch** dispatches);
+    void endBatch();
+
+    // dispatches and batches issued; batches whose fence was checked at
+    // the next frame's barrier, and how many of those had finished by
+    // then; dispatches dropped because a batch was full
+    unsigned int dispatches() const { return mDispatches; }
+    unsigned int batches() const { return mBatches; }
+    unsigned int checkedBatches() const { return mBatches - (mFence ? 1 : 0); }
+    unsigned int overlapped() const { return mOverlapped; }
+    unsigned int dropped() const { return mDropped; }
+    void logStats() const;
+
+private:
+    enum {MAX_DISPATCHES = 16};
+
+    Dispatch mQueue[MAX_DISPATCHES];
+    unsigned int mNumQueued;
+    // fence after the last batch, until the next frame's barrier
+    GLsync mFence;
+    bool mIssuing;
+
+    unsigned int mBatches;
+    unsigned int mOverlapped;
+    unsigned int mDispatches;
+    unsigned int mDropped;
+};
+
+#endif // FRAMESCHEDULER_H
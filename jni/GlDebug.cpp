@@ -0,0 +1,65 @@
+/*
+ * Copyright 2013 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "GlDebug.h"
+
+static int sLevel = GL_CHECK_FRAME < GL_CHECK_MAX_LEVEL ?
+        GL_CHECK_FRAME : GL_CHECK_MAX_LEVEL;
+
+void setGlCheckLevel(int level) {
+    if (level < GL_CHECK_OFF)
+        level = GL_CHECK_OFF;
+    if (level > GL_CHECK_MAX_LEVEL)
+        level = GL_CHECK_MAX_LEVEL;
+    __atomic_store_n(&sLevel, level, __ATOMIC_RELAXED);
+}
+
+int glCheckLevel() {
+    return __atomic_load_n(&sLevel, __ATOMIC_RELAXED);
+}
+
+#if GL_CHECK_MAX_LEVEL > GL_CHECK_OFF
+static void GL_APIENTRY debugMessage(GLenum source, GLenum type, GLuint id,
+        GLenum severity, GLsizei length, const GLchar* message,
+        const void* userParam) {
+    if (type == GL_DEBUG_TYPE_ERROR_KHR || severity == GL_DEBUG_SEVERITY_HIGH_KHR)
+        ALOGE("GL debug: %s", message);
+    else
+        ALOGV("GL debug: %s", message);
+}
+#endif
+
+int applyGlCheckLevel() {
+    int level = glCheckLevel();
+#if GL_CHECK_MAX_LEVEL > GL_CHECK_OFF
+    if (!hasGlCaps(GLCAP_DEBUG))
+        return level;
+    if (level == GL_CHECK_OFF) {
+        glDisable(GL_DEBUG_OUTPUT_KHR);
+        return level;
+    }
+    glDebugMessageCallbackKHR(debugMessage, NULL);
+    // Notifications are mostly about buffer placement; too chatty.
+    glDebugMessageControlKHR(GL_DONT_CARE, GL_DONT_CARE,
+            GL_DEBUG_SEVERITY_NOTIFICATION_KHR, 0, NULL, GL_FALSE);
+    glEnable(GL_DEBUG_OUTPUT_KHR);
+    if (level >= GL_CHECK_CALL)
+        glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS_KHR);
+    else
+        glDisable(GL_DEBUG_OUTPUT_SYNCHRONOUS_KHR);
+#endif
+    return level;
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright 2013 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GLDEBUG_H
+#define GLDEBUG_H 1
+
+#include "gles3jni.h"
+
+// ----------------------------------------------------------------------------
+// GL error checking in tiers, since glGetError() can make the driver
+// synchronize with the GPU:
+// - GL_CHECK_OFF: no checks at all
+// - GL_CHECK_FRAME: one glGetError() per frame, plus KHR_debug messages as
+//   the driver reports them
+// - GL_CHECK_CALL: glGetError() after each CHECK_GL_CALL() site, and
+//   KHR_debug messages delivered synchronously, inside the offending call
+//
+// GL_CHECK_MAX_LEVEL caps the tier at build time; checks above it compile
+// to nothing, so release builds pay nothing. Within that cap the tier can
+// be changed at runtime with setGlCheckLevel(). KHR_debug messages only
+// arrive where the extension is supported, and some drivers only report
+// much in debug contexts.
+
+enum GlCheckLevel {
+    GL_CHECK_OFF,
+    GL_CHECK_FRAME,
+    GL_CHECK_CALL,
+};
+
+#ifndef GL_CHECK_MAX_LEVEL
+#if DEBUG
+#define GL_CHECK_MAX_LEVEL GL_CHECK_CALL
+#else
+#define GL_CHECK_MAX_LEVEL GL_CHECK_OFF
+#endif
+#endif
+
+// Any thread. Clamped to GL_CHECK_MAX_LEVEL; defaults to GL_CHECK_FRAME.
+extern void setGlCheckLevel(int level);
+extern int glCheckLevel();
+// Sets up KHR_debug output in the current context to match glCheckLevel(),
+// and returns the level applied. Renderers call this whenever the level
+// changes.
+extern int applyGlCheckLevel();
+
+#define CHECK_GL_CALL(what) \
+    do { \
+        if (GL_CHECK_MAX_LEVEL >= GL_CHECK_CALL && glCheckLevel() >= GL_CHECK_CALL) \
+            checkGlError(what); \
+    } while (0)
+
+#endif // GLDEBUG_H
@@ -0,0 +1,155 @@
+/*
+ * Copyright 2013 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gles3jni.h"
+#include "DeviceCaps.h"
+#include <EGL/egl.h>
+
+#include <stdio.h>
+#include <string.h>
+
+// ----------------------------------------------------------------------------
+// Lazy entry points. A missing function is reported once and then behaves
+// as a no-op returning zero, rather than crashing in a driver-less stub:
+// its pointer is set to a no-op, so it isn't looked up again on every
+// call. Two threads resolving the same function concurrently store the
+// same pointer, which is harmless.
+
+template <typename T>
+static inline T missingProcResult() {
+    return T();
+}
+
+// Extension functions promoted to core in ES 3.2 keep their signatures
+// but drop the vendor suffix, and a 3.2 context needn't list the
+// extension, so a name that doesn't resolve is retried without it.
+static void* resolveProc(const char* name) {
+    void* proc = (void*)eglGetProcAddress(name);
+    const size_t len = strlen(name);
+    if (!proc && len > 3 && (strcmp(name + len - 3, "EXT") == 0 ||
+            strcmp(name + len - 3, "KHR") == 0 || strcmp(name + len - 3, "OES") == 0)) {
+        char core[64];
+        if (len - 3 < sizeof(core)) {
+            memcpy(core, name, len - 3);
+            core[len - 3] = '\0';
+            proc = (void*)eglGetProcAddress(core);
+        }
+    }
+    if (!proc)
+        ALOGE("%s is not available", name);
+    return proc;
+}
+
+#define GL_PROC_DEFINE(ret, name, params, args) \
+    static ret GL_APIENTRY missing_##name params { \
+        return missingProcResult<ret>(); \
+    } \
+    static ret GL_APIENTRY lazy_##name params { \
+        void* proc = resolveProc(#name); \
+        name = proc ? (ret (GL_APIENTRY*) params)proc : missing_##name; \
+        return name args; \
+    } \
+    ret (GL_APIENTRY* name) params = lazy_##name;
+
+extern "C" {
+#if DYNAMIC_ES3
+GL_PROCS_ES30(GL_PROC_DEFINE)
+GL_PROCS_ES31(GL_PROC_DEFINE)
+#endif
+GL_PROCS_EXT(GL_PROC_DEFINE)
+}
+#undef GL_PROC_DEFINE
+
+// ----------------------------------------------------------------------------
+// Capabilities
+
+static const unsigned int AEP_CAPS = GLCAP_TEXTURE_BUFFER | GLCAP_DEBUG |
+        GLCAP_SHADER_IMAGE_ATOMIC | GLCAP_COPY_IMAGE | GLCAP_GEOMETRY_SHADER |
+        GLCAP_TESSELLATION_SHADER;
+
+static const struct {
+    const char* name;
+    unsigned int caps;
+} EXTENSION_CAPS[] = {
+    {"GL_ANDROID_extension_pack_es31a", GLCAP_AEP | AEP_CAPS},
+    {"GL_EXT_buffer_storage",           GLCAP_BUFFER_STORAGE},
+    {"GL_EXT_texture_buffer",           GLCAP_TEXTURE_BUFFER},
+    {"GL_EXT_disjoint_timer_query",     GLCAP_DISJOINT_TIMER_QUERY},
+    {"GL_KHR_debug",                    GLCAP_DEBUG},
+    {"GL_EXT_color_buffer_float",       GLCAP_COLOR_BUFFER_FLOAT},
+    {"GL_EXT_color_buffer_half_float",  GLCAP_COLOR_BUFFER_HALF_FLOAT},
+    {"GL_OES_shader_image_atomic",      GLCAP_SHADER_IMAGE_ATOMIC},
+    {"GL_EXT_copy_image",               GLCAP_COPY_IMAGE},
+    {"GL_EXT_geometry_shader",          GLCAP_GEOMETRY_SHADER},
+    {"GL_EXT_tessellation_shader",      GLCAP_TESSELLATION_SHADER},
+};
+
+static const char* const CAP_NAMES[GLCAP_COUNT] = {
+    "ES 3.0", "ES 3.1", "ES 3.2", "AEP", "buffer storage", "texture buffer",
+    "timer query", "debug", "float color buffer", "half float color buffer",
+    "image atomics", "copy image", "geometry shader", "tessellation shader",
+};
+
+unsigned int probeGlCaps() {
+    unsigned int caps = 0;
+
+    int major = 0, minor = 0;
+    const char* version = (const char*)glGetString(GL_VERSION);
+    if (version && sscanf(version, "OpenGL ES %d.%d", &major, &minor) == 2) {
+        if (major >= 3)
+            caps |= GLCAP_ES30;
+        if (major > 3 || (major == 3 && minor >= 1))
+            caps |= GLCAP_ES31;
+        // Texture buffers are core in ES 3.2; the extension string needn't
+        // list them.
+        if (major > 3 || (major == 3 && minor >= 2))
+            caps |= GLCAP_ES32 | GLCAP_TEXTURE_BUFFER;
+    }
+
+    // One pass over the extension string, matching whole names.
+    const char* p = (const char*)glGetString(GL_EXTENSIONS);
+    while (p && *p) {
+        while (*p == ' ')
+            p++;
+        size_t len = strcspn(p, " ");
+        for (unsigned int i = 0; i < sizeof(EXTENSION_CAPS) / sizeof(EXTENSION_CAPS[0]); i++) {
+            if (strlen(EXTENSION_CAPS[i].name) == len &&
+                    strncmp(p, EXTENSION_CAPS[i].name, len) == 0) {
+                caps |= EXTENSION_CAPS[i].caps;
+                break;
+            }
+        }
+        p += len;
+    }
+    return caps;
+}
+
+size_t formatGlCaps(unsigned int caps, char* buf, size_t size) {
+    size_t n = 0;
+    if (size)
+        buf[0] = '\0';
+    for (int i = 0; i < GLCAP_COUNT; i++) {
+        if (!(caps & (1u << i)))
+            continue;
+        n += snprintf(n < size ? buf + n : NULL, n < size ? size - n : 0,
+                "%s%s", n ? ", " : "", CAP_NAMES[i]);
+    }
+    return n;
+}
+
+unsigned int glCaps() {
+    return deviceCaps().glCaps;
+}
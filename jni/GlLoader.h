@@ -0,0 +1,90 @@
+/*
+ * Copyright 2013 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GLLOADER_H
+#define GLLOADER_H 1
+
+#if DYNAMIC_ES3
+#include "gl3stub.h"
+#else
+#include <GLES3/gl3.h>
+#include <GLES2/gl2ext.h>
+#include <GLES3/gl31.h>
+#endif
+#include "GlProcs.h"
+
+#include <stddef.h>
+
+// ----------------------------------------------------------------------------
+// Runtime binding to GL entry points and features.
+//
+// Extension functions (and, in DYNAMIC_ES3 builds, all ES 3.0 and 3.1
+// functions) are function pointers named like the functions themselves.
+// Each starts out pointing at a trampoline that resolves the real entry
+// point with eglGetProcAddress() on the first call, so nothing is looked
+// up that isn't used; one that can't be resolved becomes a no-op, see
+// GlLoader.cpp. eglGetProcAddress() may return a pointer even for
+// functions the context doesn't support, so check glCaps() before calling
+// anything outside ES 3.0.
+//
+// The capabilities are part of the DeviceCaps profile, so they are read
+// once per process from the first context that asks, or from the profile
+// cache. All contexts of the app are created alike, so they are assumed to
+// support the same things.
+
+enum GlCap {
+    GLCAP_ES30                  = 1 << 0,
+    GLCAP_ES31                  = 1 << 1,
+    GLCAP_ES32                  = 1 << 2,
+    // GL_ANDROID_extension_pack_es31a, which implies the extensions below
+    // marked AEP
+    GLCAP_AEP                   = 1 << 3,
+    GLCAP_BUFFER_STORAGE        = 1 << 4,
+    GLCAP_TEXTURE_BUFFER        = 1 << 5,   // AEP, and core in ES 3.2
+    GLCAP_DISJOINT_TIMER_QUERY  = 1 << 6,
+    GLCAP_DEBUG                 = 1 << 7,   // AEP
+    GLCAP_COLOR_BUFFER_FLOAT    = 1 << 8,
+    GLCAP_COLOR_BUFFER_HALF_FLOAT = 1 << 9,
+    GLCAP_SHADER_IMAGE_ATOMIC   = 1 << 10,  // AEP
+    GLCAP_COPY_IMAGE            = 1 << 11,  // AEP
+    GLCAP_GEOMETRY_SHADER       = 1 << 12,  // AEP
+    GLCAP_TESSELLATION_SHADER   = 1 << 13,  // AEP
+    GLCAP_COUNT                 = 14
+};
+
+// Bitmask of GlCap, from deviceCaps(). The first call needs a current
+// context.
+extern unsigned int glCaps();
+// true if all of the given GlCap bits are set
+inline bool hasGlCaps(unsigned int caps) {
+    return (glCaps() & caps) == caps;
+}
+
+// Reads the bitmask from the GL version and extension strings of the
+// current context. Only DeviceCaps calls this.
+extern unsigned int probeGlCaps();
+// Writes the names of the capabilities in caps, comma separated, like
+// snprintf(). For logs.
+extern size_t formatGlCaps(unsigned int caps, char* buf, size_t size);
+
+#define GL_PROC_DECLARE(ret, name, params, args) \
+    extern ret (GL_APIENTRY* name) params;
+extern "C" {
+GL_PROCS_EXT(GL_PROC_DECLARE)
+}
+#undef GL_PROC_DECLARE
+
+#endif // GLLOADER_H
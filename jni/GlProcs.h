@@ -0,0 +1,272 @@
+/*
+ * Copyright 2013 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GLPROCS_H
+#define GLPROCS_H 1
+
+// ----------------------------------------------------------------------------
+// Entry points resolved at runtime by GlLoader, one
+//     X(return type, name, (parameters), (arguments))
+// per function. The core lists are only loaded dynamically in DYNAMIC_ES3
+// builds; the extension list always is, since libGLESv3 doesn't export
+// extension functions.
+//
+// Generated from the Khronos gl3.h, gl31.h and gl2ext.h. Extensions not
+// listed here need to be added before their functions can be called.
+
+#define GL_PROCS_ES30(X) \
+    X(void, glReadBuffer, (GLenum mode), (mode)) \
+    X(void, glDrawRangeElements, (GLenum mode, GLuint start, GLuint end, GLsizei count, GLenum type, const GLvoid* indices), (mode, start, end, count, type, indices)) \
+    X(void, glTexImage3D, (GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLenum format, GLenum type, const GLvoid* pixels), (target, level, internalformat, width, height, depth, border, format, type, pixels)) \
+    X(void, glTexSubImage3D, (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const GLvoid* pixels), (target, level, xoffset, yoffset, zoffset, width, height, depth, format, type, pixels)) \
+    X(void, glCopyTexSubImage3D, (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLint x, GLint y, GLsizei width, GLsizei height), (target, level, xoffset, yoffset, zoffset, x, y, width, height)) \
+    X(void, glCompressedTexImage3D, (GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLsizei imageSize, const GLvoid* data), (target, level, internalformat, width, height, depth, border, imageSize, data)) \
+    X(void, glCompressedTexSubImage3D, (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLsizei imageSize, const GLvoid* data), (target, level, xoffset, yoffset, zoffset, width, height, depth, format, imageSize, data)) \
+    X(void, glGenQueries, (GLsizei n, GLuint* ids), (n, ids)) \
+    X(void, glDeleteQueries, (GLsizei n, const GLuint* ids), (n, ids)) \
+    X(GLboolean, glIsQuery, (GLuint id), (id)) \
+    X(void, glBeginQuery, (GLenum target, GLuint id), (target, id)) \
+    X(void, glEndQuery, (GLenum target), (target)) \
+    X(void, glGetQueryiv, (GLenum target, GLenum pname, GLint* params), (target, pname, params)) \
+    X(void, glGetQueryObjectuiv, (GLuint id, GLenum pname, GLuint* params), (id, pname, params)) \
+    X(GLboolean, glUnmapBuffer, (GLenum target), (target)) \
+    X(void, glGetBufferPointerv, (GLenum target, GLenum pname, GLvoid** params), (target, pname, params)) \
+    X(void, glDrawBuffers, (GLsizei n, const GLenum* bufs), (n, bufs)) \
+    X(void, glUniformMatrix2x3fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat* value), (location, count, transpose, value)) \
+    X(void, glUniformMatrix3x2fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat* value), (location, count, transpose, value)) \
+    X(void, glUniformMatrix2x4fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat* value), (location, count, transpose, value)) \
+    X(void, glUniformMatrix4x2fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat* value), (location, count, transpose, value)) \
+    X(void, glUniformMatrix3x4fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat* value), (location, count, transpose, value)) \
+    X(void, glUniformMatrix4x3fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat* value), (location, count, transpose, value)) \
+    X(void, glBlitFramebuffer, (GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter), (srcX0, srcY0, srcX1, srcY1, dstX0, dstY0, dstX1, dstY1, mask, filter)) \
+    X(void, glRenderbufferStorageMultisample, (GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height), (target, samples, internalformat, width, height)) \
+    X(void, glFramebufferTextureLayer, (GLenum target, GLenum attachment, GLuint texture, GLint level, GLint layer), (target, attachment, texture, level, layer)) \
+    X(GLvoid*, glMapBufferRange, (GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access), (target, offset, length, access)) \
+    X(void, glFlushMappedBufferRange, (GLenum target, GLintptr offset, GLsizeiptr length), (target, offset, length)) \
+    X(void, glBindVertexArray, (GLuint array), (array)) \
+    X(void, glDeleteVertexArrays, (GLsizei n, const GLuint* arrays), (n, arrays)) \
+    X(void, glGenVertexArrays, (GLsizei n, GLuint* arrays), (n, arrays)) \
+    X(GLboolean, glIsVertexArray, (GLuint array), (array)) \
+    X(void, glGetIntegeri_v, (GLenum target, GLuint index, GLint* data), (target, index, data)) \
+    X(void, glBeginTransformFeedback, (GLenum primitiveMode), (primitiveMode)) \
+    X(void, glEndTransformFeedback, (void), ()) \
+    X(void, glBindBufferRange, (GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size), (target, index, buffer, offset, size)) \
+    X(void, glBindBufferBase, (GLenum target, GLuint index, GLuint buffer), (target, index, buffer)) \
+    X(void, glTransformFeedbackVaryings, (GLuint program, GLsizei count, const GLchar* const* varyings, GLenum bufferMode), (program, count, varyings, bufferMode)) \
+    X(void, glGetTransformFeedbackVarying, (GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLsizei* size, GLenum* type, GLchar* name), (program, index, bufSize, length, size, type, name)) \
+    X(void, glVertexAttribIPointer, (GLuint index, GLint size, GLenum type, GLsizei stride, const GLvoid* pointer), (index, size, type, stride, pointer)) \
+    X(void, glGetVertexAttribIiv, (GLuint index, GLenum pname, GLint* params), (index, pname, params)) \
+    X(void, glGetVertexAttribIuiv, (GLuint index, GLenum pname, GLuint* params), (index, pname, params)) \
+    X(void, glVertexAttribI4i, (GLuint index, GLint x, GLint y, GLint z, GLint w), (index, x, y, z, w)) \
+    X(void, glVertexAttribI4ui, (GLuint index, GLuint x, GLuint y, GLuint z, GLuint w), (index, x, y, z, w)) \
+    X(void, glVertexAttribI4iv, (GLuint index, const GLint* v), (index, v)) \
+    X(void, glVertexAttribI4uiv, (GLuint index, const GLuint* v), (index, v)) \
+    X(void, glGetUniformuiv, (GLuint program, GLint location, GLuint* params), (program, location, params)) \
+    X(GLint, glGetFragDataLocation, (GLuint program, const GLchar *name), (program, name)) \
+    X(void, glUniform1ui, (GLint location, GLuint v0), (location, v0)) \
+    X(void, glUniform2ui, (GLint location, GLuint v0, GLuint v1), (location, v0, v1)) \
+    X(void, glUniform3ui, (GLint location, GLuint v0, GLuint v1, GLuint v2), (location, v0, v1, v2)) \
+    X(void, glUniform4ui, (GLint location, GLuint v0, GLuint v1, GLuint v2, GLuint v3), (location, v0, v1, v2, v3)) \
+    X(void, glUniform1uiv, (GLint location, GLsizei count, const GLuint* value), (location, count, value)) \
+    X(void, glUniform2uiv, (GLint location, GLsizei count, const GLuint* value), (location, count, value)) \
+    X(void, glUniform3uiv, (GLint location, GLsizei count, const GLuint* value), (location, count, value)) \
+    X(void, glUniform4uiv, (GLint location, GLsizei count, const GLuint* value), (location, count, value)) \
+    X(void, glClearBufferiv, (GLenum buffer, GLint drawbuffer, const GLint* value), (buffer, drawbuffer, value)) \
+    X(void, glClearBufferuiv, (GLenum buffer, GLint drawbuffer, const GLuint* value), (buffer, drawbuffer, value)) \
+    X(void, glClearBufferfv, (GLenum buffer, GLint drawbuffer, const GLfloat* value), (buffer, drawbuffer, value)) \
+    X(void, glClearBufferfi, (GLenum buffer, GLint drawbuffer, GLfloat depth, GLint stencil), (buffer, drawbuffer, depth, stencil)) \
+    X(const GLubyte*, glGetStringi, (GLenum name, GLuint index), (name, index)) \
+    X(void, glCopyBufferSubData, (GLenum readTarget, GLenum writeTarget, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size), (readTarget, writeTarget, readOffset, writeOffset, size)) \
+    X(void, glGetUniformIndices, (GLuint program, GLsizei uniformCount, const GLchar* const* uniformNames, GLuint* uniformIndices), (program, uniformCount, uniformNames, uniformIndices)) \
+    X(void, glGetActiveUniformsiv, (GLuint program, GLsizei uniformCount, const GLuint* uniformIndices, GLenum pname, GLint* params), (program, uniformCount, uniformIndices, pname, params)) \
+    X(GLuint, glGetUniformBlockIndex, (GLuint program, const GLchar* uniformBlockName), (program, uniformBlockName)) \
+    X(void, glGetActiveUniformBlockiv, (GLuint program, GLuint uniformBlockIndex, GLenum pname, GLint* params), (program, uniformBlockIndex, pname, params)) \
+    X(void, glGetActiveUniformBlockName, (GLuint program, GLuint uniformBlockIndex, GLsizei bufSize, GLsizei* length, GLchar* uniformBlockName), (program, uniformBlockIndex, bufSize, length, uniformBlockName)) \
+    X(void, glUniformBlockBinding, (GLuint program, GLuint uniformBlockIndex, GLuint uniformBlockBinding), (program, uniformBlockIndex, uniformBlockBinding)) \
+    X(void, glDrawArraysInstanced, (GLenum mode, GLint first, GLsizei count, GLsizei instanceCount), (mode, first, count, instanceCount)) \
+    X(void, glDrawElementsInstanced, (GLenum mode, GLsizei count, GLenum type, const GLvoid* indices, GLsizei instanceCount), (mode, count, type, indices, instanceCount)) \
+    X(GLsync, glFenceSync, (GLenum condition, GLbitfield flags), (condition, flags)) \
+    X(GLboolean, glIsSync, (GLsync sync), (sync)) \
+    X(void, glDeleteSync, (GLsync sync), (sync)) \
+    X(GLenum, glClientWaitSync, (GLsync sync, GLbitfield flags, GLuint64 timeout), (sync, flags, timeout)) \
+    X(void, glWaitSync, (GLsync sync, GLbitfield flags, GLuint64 timeout), (sync, flags, timeout)) \
+    X(void, glGetInteger64v, (GLenum pname, GLint64* params), (pname, params)) \
+    X(void, glGetSynciv, (GLsync sync, GLenum pname, GLsizei bufSize, GLsizei* length, GLint* values), (sync, pname, bufSize, length, values)) \
+    X(void, glGetInteger64i_v, (GLenum target, GLuint index, GLint64* data), (target, index, data)) \
+    X(void, glGetBufferParameteri64v, (GLenum target, GLenum pname, GLint64* params), (target, pname, params)) \
+    X(void, glGenSamplers, (GLsizei count, GLuint* samplers), (count, samplers)) \
+    X(void, glDeleteSamplers, (GLsizei count, const GLuint* samplers), (count, samplers)) \
+    X(GLboolean, glIsSampler, (GLuint sampler), (sampler)) \
+    X(void, glBindSampler, (GLuint unit, GLuint sampler), (unit, sampler)) \
+    X(void, glSamplerParameteri, (GLuint sampler, GLenum pname, GLint param), (sampler, pname, param)) \
+    X(void, glSamplerParameteriv, (GLuint sampler, GLenum pname, const GLint* param), (sampler, pname, param)) \
+    X(void, glSamplerParameterf, (GLuint sampler, GLenum pname, GLfloat param), (sampler, pname, param)) \
+    X(void, glSamplerParameterfv, (GLuint sampler, GLenum pname, const GLfloat* param), (sampler, pname, param)) \
+    X(void, glGetSamplerParameteriv, (GLuint sampler, GLenum pname, GLint* params), (sampler, pname, params)) \
+    X(void, glGetSamplerParameterfv, (GLuint sampler, GLenum pname, GLfloat* params), (sampler, pname, params)) \
+    X(void, glVertexAttribDivisor, (GLuint index, GLuint divisor), (index, divisor)) \
+    X(void, glBindTransformFeedback, (GLenum target, GLuint id), (target, id)) \
+    X(void, glDeleteTransformFeedbacks, (GLsizei n, const GLuint* ids), (n, ids)) \
+    X(void, glGenTransformFeedbacks, (GLsizei n, GLuint* ids), (n, ids)) \
+    X(GLboolean, glIsTransformFeedback, (GLuint id), (id)) \
+    X(void, glPauseTransformFeedback, (void), ()) \
+    X(void, glResumeTransformFeedback, (void), ()) \
+    X(void, glGetProgramBinary, (GLuint program, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat, GLvoid* binary), (program, bufSize, length, binaryFormat, binary)) \
+    X(void, glProgramBinary, (GLuint program, GLenum binaryFormat, const GLvoid* binary, GLsizei length), (program, binaryFormat, binary, length)) \
+    X(void, glProgramParameteri, (GLuint program, GLenum pname, GLint value), (program, pname, value)) \
+    X(void, glInvalidateFramebuffer, (GLenum target, GLsizei numAttachments, const GLenum* attachments), (target, numAttachments, attachments)) \
+    X(void, glInvalidateSubFramebuffer, (GLenum target, GLsizei numAttachments, const GLenum* attachments, GLint x, GLint y, GLsizei width, GLsizei height), (target, numAttachments, attachments, x, y, width, height)) \
+    X(void, glTexStorage2D, (GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height), (target, levels, internalformat, width, height)) \
+    X(void, glTexStorage3D, (GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth), (target, levels, internalformat, width, height, depth)) \
+    X(void, glGetInternalformativ, (GLenum target, GLenum internalformat, GLenum pname, GLsizei bufSize, GLint* params), (target, internalformat, pname, bufSize, params))
+
+#define GL_PROCS_ES31(X) \
+    X(void, glDispatchCompute, (GLuint num_groups_x, GLuint num_groups_y, GLuint num_groups_z), (num_groups_x, num_groups_y, num_groups_z)) \
+    X(void, glDispatchComputeIndirect, (GLintptr indirect), (indirect)) \
+    X(void, glDrawArraysIndirect, (GLenum mode, const void *indirect), (mode, indirect)) \
+    X(void, glDrawElementsIndirect, (GLenum mode, GLenum type, const void *indirect), (mode, type, indirect)) \
+    X(void, glFramebufferParameteri, (GLenum target, GLenum pname, GLint param), (target, pname, param)) \
+    X(void, glGetFramebufferParameteriv, (GLenum target, GLenum pname, GLint *params), (target, pname, params)) \
+    X(void, glGetProgramInterfaceiv, (GLuint program, GLenum programInterface, GLenum pname, GLint *params), (program, programInterface, pname, params)) \
+    X(GLuint, glGetProgramResourceIndex, (GLuint program, GLenum programInterface, const GLchar *name), (program, programInterface, name)) \
+    X(void, glGetProgramResourceName, (GLuint program, GLenum programInterface, GLuint index, GLsizei bufSize, GLsizei *length, GLchar *name), (program, programInterface, index, bufSize, length, name)) \
+    X(void, glGetProgramResourceiv, (GLuint program, GLenum programInterface, GLuint index, GLsizei propCount, const GLenum *props, GLsizei bufSize, GLsizei *length, GLint *params), (program, programInterface, index, propCount, props, bufSize, length, params)) \
+    X(GLint, glGetProgramResourceLocation, (GLuint program, GLenum programInterface, const GLchar *name), (program, programInterface, name)) \
+    X(void, glUseProgramStages, (GLuint pipeline, GLbitfield stages, GLuint program), (pipeline, stages, program)) \
+    X(void, glActiveShaderProgram, (GLuint pipeline, GLuint program), (pipeline, program)) \
+    X(GLuint, glCreateShaderProgramv, (GLenum type, GLsizei count, const GLchar *const*strings), (type, count, strings)) \
+    X(void, glBindProgramPipeline, (GLuint pipeline), (pipeline)) \
+    X(void, glDeleteProgramPipelines, (GLsizei n, const GLuint *pipelines), (n, pipelines)) \
+    X(void, glGenProgramPipelines, (GLsizei n, GLuint *pipelines), (n, pipelines)) \
+    X(GLboolean, glIsProgramPipeline, (GLuint pipeline), (pipeline)) \
+    X(void, glGetProgramPipelineiv, (GLuint pipeline, GLenum pname, GLint *params), (pipeline, pname, params)) \
+    X(void, glProgramUniform1i, (GLuint program, GLint location, GLint v0), (program, location, v0)) \
+    X(void, glProgramUniform2i, (GLuint program, GLint location, GLint v0, GLint v1), (program, location, v0, v1)) \
+    X(void, glProgramUniform3i, (GLuint program, GLint location, GLint v0, GLint v1, GLint v2), (program, location, v0, v1, v2)) \
+    X(void, glProgramUniform4i, (GLuint program, GLint location, GLint v0, GLint v1, GLint v2, GLint v3), (program, location, v0, v1, v2, v3)) \
+    X(void, glProgramUniform1ui, (GLuint program, GLint location, GLuint v0), (program, location, v0)) \
+    X(void, glProgramUniform2ui, (GLuint program, GLint location, GLuint v0, GLuint v1), (program, location, v0, v1)) \
+    X(void, glProgramUniform3ui, (GLuint program, GLint location, GLuint v0, GLuint v1, GLuint v2), (program, location, v0, v1, v2)) \
+    X(void, glProgramUniform4ui, (GLuint program, GLint location, GLuint v0, GLuint v1, GLuint v2, GLuint v3), (program, location, v0, v1, v2, v3)) \
+    X(void, glProgramUniform1f, (GLuint program, GLint location, GLfloat v0), (program, location, v0)) \
+    X(void, glProgramUniform2f, (GLuint program, GLint location, GLfloat v0, GLfloat v1), (program, location, v0, v1)) \
+    X(void, glProgramUniform3f, (GLuint program, GLint location, GLfloat v0, GLfloat v1, GLfloat v2), (program, location, v0, v1, v2)) \
+    X(void, glProgramUniform4f, (GLuint program, GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3), (program, location, v0, v1, v2, v3)) \
+    X(void, glProgramUniform1iv, (GLuint program, GLint location, GLsizei count, const GLint *value), (program, location, count, value)) \
+    X(void, glProgramUniform2iv, (GLuint program, GLint location, GLsizei count, const GLint *value), (program, location, count, value)) \
+    X(void, glProgramUniform3iv, (GLuint program, GLint location, GLsizei count, const GLint *value), (program, location, count, value)) \
+    X(void, glProgramUniform4iv, (GLuint program, GLint location, GLsizei count, const GLint *value), (program, location, count, value)) \
+    X(void, glProgramUniform1uiv, (GLuint program, GLint location, GLsizei count, const GLuint *value), (program, location, count, value)) \
+    X(void, glProgramUniform2uiv, (GLuint program, GLint location, GLsizei count, const GLuint *value), (program, location, count, value)) \
+    X(void, glProgramUniform3uiv, (GLuint program, GLint location, GLsizei count, const GLuint *value), (program, location, count, value)) \
+    X(void, glProgramUniform4uiv, (GLuint program, GLint location, GLsizei count, const GLuint *value), (program, location, count, value)) \
+    X(void, glProgramUniform1fv, (GLuint program, GLint location, GLsizei count, const GLfloat *value), (program, location, count, value)) \
+    X(void, glProgramUniform2fv, (GLuint program, GLint location, GLsizei count, const GLfloat *value), (program, location, count, value)) \
+    X(void, glProgramUniform3fv, (GLuint program, GLint location, GLsizei count, const GLfloat *value), (program, location, count, value)) \
+    X(void, glProgramUniform4fv, (GLuint program, GLint location, GLsizei count, const GLfloat *value), (program, location, count, value)) \
+    X(void, glProgramUniformMatrix2fv, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (program, location, count, transpose, value)) \
+    X(void, glProgramUniformMatrix3fv, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (program, location, count, transpose, value)) \
+    X(void, glProgramUniformMatrix4fv, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (program, location, count, transpose, value)) \
+    X(void, glProgramUniformMatrix2x3fv, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (program, location, count, transpose, value)) \
+    X(void, glProgramUniformMatrix3x2fv, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (program, location, count, transpose, value)) \
+    X(void, glProgramUniformMatrix2x4fv, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (program, location, count, transpose, value)) \
+    X(void, glProgramUniformMatrix4x2fv, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (program, location, count, transpose, value)) \
+    X(void, glProgramUniformMatrix3x4fv, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (program, location, count, transpose, value)) \
+    X(void, glProgramUniformMatrix4x3fv, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (program, location, count, transpose, value)) \
+    X(void, glValidateProgramPipeline, (GLuint pipeline), (pipeline)) \
+    X(void, glGetProgramPipelineInfoLog, (GLuint pipeline, GLsizei bufSize, GLsizei *length, GLchar *infoLog), (pipeline, bufSize, length, infoLog)) \
+    X(void, glBindImageTexture, (GLuint unit, GLuint texture, GLint level, GLboolean layered, GLint layer, GLenum access, GLenum format), (unit, texture, level, layered, layer, access, format)) \
+    X(void, glGetBooleani_v, (GLenum target, GLuint index, GLboolean *data), (target, index, data)) \
+    X(void, glMemoryBarrier, (GLbitfield barriers), (barriers)) \
+    X(void, glMemoryBarrierByRegion, (GLbitfield barriers), (barriers)) \
+    X(void, glTexStorage2DMultisample, (GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height, GLboolean fixedsamplelocations), (target, samples, internalformat, width, height, fixedsamplelocations)) \
+    X(void, glGetMultisamplefv, (GLenum pname, GLuint index, GLfloat *val), (pname, index, val)) \
+    X(void, glSampleMaski, (GLuint maskNumber, GLbitfield mask), (maskNumber, mask)) \
+    X(void, glGetTexLevelParameteriv, (GLenum target, GLint level, GLenum pname, GLint *params), (target, level, pname, params)) \
+    X(void, glGetTexLevelParameterfv, (GLenum target, GLint level, GLenum pname, GLfloat *params), (target, level, pname, params)) \
+    X(void, glBindVertexBuffer, (GLuint bindingindex, GLuint buffer, GLintptr offset, GLsizei stride), (bindingindex, buffer, offset, stride)) \
+    X(void, glVertexAttribFormat, (GLuint attribindex, GLint size, GLenum type, GLboolean normalized, GLuint relativeoffset), (attribindex, size, type, normalized, relativeoffset)) \
+    X(void, glVertexAttribIFormat, (GLuint attribindex, GLint size, GLenum type, GLuint relativeoffset), (attribindex, size, type, relativeoffset)) \
+    X(void, glVertexAttribBinding, (GLuint attribindex, GLuint bindingindex), (attribindex, bindingindex)) \
+    X(void, glVertexBindingDivisor, (GLuint bindingindex, GLuint divisor), (bindingindex, divisor))
+
+// The extensions the renderers use, and the ones making up
+// GL_ANDROID_extension_pack_es31a.
+#define GL_PROCS_EXT(X) \
+    /* GL_KHR_blend_equation_advanced */ \
+    X(void, glBlendBarrierKHR, (void), ()) \
+    /* GL_KHR_debug */ \
+    X(void, glDebugMessageControlKHR, (GLenum source, GLenum type, GLenum severity, GLsizei count, const GLuint *ids, GLboolean enabled), (source, type, severity, count, ids, enabled)) \
+    X(void, glDebugMessageInsertKHR, (GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar *buf), (source, type, id, severity, length, buf)) \
+    X(void, glDebugMessageCallbackKHR, (GLDEBUGPROCKHR callback, const void *userParam), (callback, userParam)) \
+    X(GLuint, glGetDebugMessageLogKHR, (GLuint count, GLsizei bufSize, GLenum *sources, GLenum *types, GLuint *ids, GLenum *severities, GLsizei *lengths, GLchar *messageLog), (count, bufSize, sources, types, ids, severities, lengths, messageLog)) \
+    X(void, glPushDebugGroupKHR, (GLenum source, GLuint id, GLsizei length, const GLchar *message), (source, id, length, message)) \
+    X(void, glPopDebugGroupKHR, (void), ()) \
+    X(void, glObjectLabelKHR, (GLenum identifier, GLuint name, GLsizei length, const GLchar *label), (identifier, name, length, label)) \
+    X(void, glGetObjectLabelKHR, (GLenum identifier, GLuint name, GLsizei bufSize, GLsizei *length, GLchar *label), (identifier, name, bufSize, length, label)) \
+    X(void, glObjectPtrLabelKHR, (const void *ptr, GLsizei length, const GLchar *label), (ptr, length, label)) \
+    X(void, glGetObjectPtrLabelKHR, (const void *ptr, GLsizei bufSize, GLsizei *length, GLchar *label), (ptr, bufSize, length, label)) \
+    X(void, glGetPointervKHR, (GLenum pname, void **params), (pname, params)) \
+    /* GL_OES_sample_shading */ \
+    X(void, glMinSampleShadingOES, (GLfloat value), (value)) \
+    /* GL_OES_texture_storage_multisample_2d_array */ \
+    X(void, glTexStorage3DMultisampleOES, (GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth, GLboolean fixedsamplelocations), (target, samples, internalformat, width, height, depth, fixedsamplelocations)) \
+    /* GL_EXT_buffer_storage */ \
+    X(void, glBufferStorageEXT, (GLenum target, GLsizeiptr size, const void *data, GLbitfield flags), (target, size, data, flags)) \
+    /* GL_EXT_copy_image */ \
+    X(void, glCopyImageSubDataEXT, (GLuint srcName, GLenum srcTarget, GLint srcLevel, GLint srcX, GLint srcY, GLint srcZ, GLuint dstName, GLenum dstTarget, GLint dstLevel, GLint dstX, GLint dstY, GLint dstZ, GLsizei srcWidth, GLsizei srcHeight, GLsizei srcDepth), (srcName, srcTarget, srcLevel, srcX, srcY, srcZ, dstName, dstTarget, dstLevel, dstX, dstY, dstZ, srcWidth, srcHeight, srcDepth)) \
+    /* GL_EXT_disjoint_timer_query */ \
+    X(void, glGenQueriesEXT, (GLsizei n, GLuint *ids), (n, ids)) \
+    X(void, glDeleteQueriesEXT, (GLsizei n, const GLuint *ids), (n, ids)) \
+    X(GLboolean, glIsQueryEXT, (GLuint id), (id)) \
+    X(void, glBeginQueryEXT, (GLenum target, GLuint id), (target, id)) \
+    X(void, glEndQueryEXT, (GLenum target), (target)) \
+    X(void, glQueryCounterEXT, (GLuint id, GLenum target), (id, target)) \
+    X(void, glGetQueryivEXT, (GLenum target, GLenum pname, GLint *params), (target, pname, params)) \
+    X(void, glGetQueryObjectivEXT, (GLuint id, GLenum pname, GLint *params), (id, pname, params)) \
+    X(void, glGetQueryObjectuivEXT, (GLuint id, GLenum pname, GLuint *params), (id, pname, params)) \
+    X(void, glGetQueryObjecti64vEXT, (GLuint id, GLenum pname, GLint64 *params), (id, pname, params)) \
+    X(void, glGetQueryObjectui64vEXT, (GLuint id, GLenum pname, GLuint64 *params), (id, pname, params)) \
+    X(void, glGetInteger64vEXT, (GLenum pname, GLint64 *data), (pname, data)) \
+    /* GL_EXT_draw_buffers_indexed */ \
+    X(void, glEnableiEXT, (GLenum target, GLuint index), (target, index)) \
+    X(void, glDisableiEXT, (GLenum target, GLuint index), (target, index)) \
+    X(void, glBlendEquationiEXT, (GLuint buf, GLenum mode), (buf, mode)) \
+    X(void, glBlendEquationSeparateiEXT, (GLuint buf, GLenum modeRGB, GLenum modeAlpha), (buf, modeRGB, modeAlpha)) \
+    X(void, glBlendFunciEXT, (GLuint buf, GLenum src, GLenum dst), (buf, src, dst)) \
+    X(void, glBlendFuncSeparateiEXT, (GLuint buf, GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha), (buf, srcRGB, dstRGB, srcAlpha, dstAlpha)) \
+    X(void, glColorMaskiEXT, (GLuint index, GLboolean r, GLboolean g, GLboolean b, GLboolean a), (index, r, g, b, a)) \
+    X(GLboolean, glIsEnablediEXT, (GLenum target, GLuint index), (target, index)) \
+    /* GL_EXT_geometry_shader */ \
+    X(void, glFramebufferTextureEXT, (GLenum target, GLenum attachment, GLuint texture, GLint level), (target, attachment, texture, level)) \
+    /* GL_EXT_primitive_bounding_box */ \
+    X(void, glPrimitiveBoundingBoxEXT, (GLfloat minX, GLfloat minY, GLfloat minZ, GLfloat minW, GLfloat maxX, GLfloat maxY, GLfloat maxZ, GLfloat maxW), (minX, minY, minZ, minW, maxX, maxY, maxZ, maxW)) \
+    /* GL_EXT_tessellation_shader */ \
+    X(void, glPatchParameteriEXT, (GLenum pname, GLint value), (pname, value)) \
+    /* GL_EXT_texture_border_clamp */ \
+    X(void, glTexParameterIivEXT, (GLenum target, GLenum pname, const GLint *params), (target, pname, params)) \
+    X(void, glTexParameterIuivEXT, (GLenum target, GLenum pname, const GLuint *params), (target, pname, params)) \
+    X(void, glGetTexParameterIivEXT, (GLenum target, GLenum pname, GLint *params), (target, pname, params)) \
+    X(void, glGetTexParameterIuivEXT, (GLenum target, GLenum pname, GLuint *params), (target, pname, params)) \
+    X(void, glSamplerParameterIivEXT, (GLuint sampler, GLenum pname, const GLint *param), (sampler, pname, param)) \
+    X(void, glSamplerParameterIuivEXT, (GLuint sampler, GLenum pname, const GLuint *param), (sampler, pname, param)) \
+    X(void, glGetSamplerParameterIivEXT, (GLuint sampler, GLenum pname, GLint *params), (sampler, pname, params)) \
+    X(void, glGetSamplerParameterIuivEXT, (GLuint sampler, GLenum pname, GLuint *params), (sampler, pname, params)) \
+    /* GL_EXT_texture_buffer */ \
+    X(void, glTexBufferEXT, (GLenum target, GLenum internalformat, GLuint buffer), (target, internalformat, buffer)) \
+    X(void, glTexBufferRangeEXT, (GLenum target, GLenum internalformat, GLuint buffer, GLintptr offset, GLsizeiptr size), (target, internalformat, buffer, offset, size))
+
+#endif // GLPROCS_H
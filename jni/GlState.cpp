@@ -0,0 +1,231 @@
+/*
+ * Copyright 2013 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "GlState.h"
+
+#include <string.h>
+
+// Shadow value for state that may be anything. Never a valid object name
+// in practice.
+static const GLuint UNKNOWN = ~0u;
+
+static const char* const STAT_NAMES[] = {
+    "program", "vertex array", "buffer", "framebuffer", "texture", "image",
+};
+
+GlState::GlState() {
+    memset(mCalls, 0, sizeof(mCalls));
+    memset(mFiltered, 0, sizeof(mFiltered));
+    invalidate();
+}
+
+void GlState::invalidate() {
+    mProgram = UNKNOWN;
+    mVertexArray = UNKNOWN;
+    for (int i = 0; i < BT_COUNT; i++)
+        mBuffers[i] = UNKNOWN;
+    mDrawFramebuffer = UNKNOWN;
+    mReadFramebuffer = UNKNOWN;
+    mActiveTexture = UNKNOWN;
+    for (int u = 0; u < MAX_TEXTURE_UNITS; u++) {
+        for (int t = 0; t < TT_COUNT; t++)
+            mTextures[u][t] = UNKNOWN;
+    }
+    for (int i = 0; i < MAX_IMAGE_UNITS; i++)
+        mImages[i].texture = UNKNOWN;
+}
+
+bool GlState::changes(Stat stat, GLuint* shadow, GLuint value) {
+    mCalls[stat]++;
+    if (*shadow == value) {
+        mFiltered[stat]++;
+        return false;
+    }
+    *shadow = value;
+    return true;
+}
+
+void GlState::useProgram(GLuint program) {
+    if (changes(STAT_PROGRAM, &mProgram, program))
+        glUseProgram(program);
+}
+
+void GlState::bindVertexArray(GLuint vao) {
+    if (!changes(STAT_VERTEX_ARRAY, &mVertexArray, vao))
+        return;
+    glBindVertexArray(vao);
+    // The element array binding is part of the VAO.
+    mBuffers[BT_ELEMENT_ARRAY] = UNKNOWN;
+}
+
+GlState::BufferTarget GlState::bufferTarget(GLenum target) {
+    switch (target) {
+    case GL_ARRAY_BUFFER:              return BT_ARRAY;
+    case GL_ELEMENT_ARRAY_BUFFER:      return BT_ELEMENT_ARRAY;
+    case GL_COPY_READ_BUFFER:          return BT_COPY_READ;
+    case GL_COPY_WRITE_BUFFER:         return BT_COPY_WRITE;
+    case GL_PIXEL_PACK_BUFFER:         return BT_PIXEL_PACK;
+    case GL_PIXEL_UNPACK_BUFFER:       return BT_PIXEL_UNPACK;
+    case GL_UNIFORM_BUFFER:            return BT_UNIFORM;
+    case GL_TRANSFORM_FEEDBACK_BUFFER: return BT_TRANSFORM_FEEDBACK;
+    case GL_TEXTURE_BUFFER_EXT:        return BT_TEXTURE;
+    case GL_SHADER_STORAGE_BUFFER:     return BT_SHADER_STORAGE;
+    case GL_ATOMIC_COUNTER_BUFFER:     return BT_ATOMIC_COUNTER;
+    case GL_DISPATCH_INDIRECT_BUFFER:  return BT_DISPATCH_INDIRECT;
+    case GL_DRAW_INDIRECT_BUFFER:      return BT_DRAW_INDIRECT;
+    default:                           return BT_COUNT;
+    }
+}
+
+void GlState::bindBuffer(GLenum target, GLuint buffer) {
+    BufferTarget i = bufferTarget(target);
+    if (i == BT_COUNT) {
+        mCalls[STAT_BUFFER]++;
+        glBindBuffer(target, buffer);
+        return;
+    }
+    if (changes(STAT_BUFFER, &mBuffers[i], buffer))
+        glBindBuffer(target, buffer);
+}
+
+void GlState::bindBufferRange(GLenum target, GLuint index, GLuint buffer,
+        GLintptr offset, GLsizeiptr size) {
+    mCalls[STAT_BUFFER]++;
+    BufferTarget i = bufferTarget(target);
+    if (i != BT_COUNT)
+        mBuffers[i] = buffer;
+    glBindBufferRange(target, index, buffer, offset, size);
+}
+
+void GlState::bindFramebuffer(GLenum target, GLuint fbo) {
+    bool draw = target != GL_READ_FRAMEBUFFER;
+    bool read = target != GL_DRAW_FRAMEBUFFER;
+    mCalls[STAT_FRAMEBUFFER]++;
+    if ((!draw || mDrawFramebuffer == fbo) && (!read || mReadFramebuffer == fbo)) {
+        mFiltered[STAT_FRAMEBUFFER]++;
+        return;
+    }
+    if (draw)
+        mDrawFramebuffer = fbo;
+    if (read)
+        mReadFramebuffer = fbo;
+    glBindFramebuffer(target, fbo);
+}
+
+void GlState::bindTexture(unsigned int unit, GLenum target, GLuint texture) {
+    int t;
+    switch (target) {
+    case GL_TEXTURE_2D:         t = TT_2D; break;
+    case GL_TEXTURE_2D_ARRAY:   t = TT_2D_ARRAY; break;
+    case GL_TEXTURE_3D:         t = TT_3D; break;
+    case GL_TEXTURE_CUBE_MAP:   t = TT_CUBE_MAP; break;
+    case GL_TEXTURE_BUFFER_EXT: t = TT_BUFFER; break;
+    default:                    t = TT_COUNT; break;
+    }
+    if (unit < MAX_TEXTURE_UNITS && t < TT_COUNT) {
+        if (!changes(STAT_TEXTURE, &mTextures[unit][t], texture))
+            return;
+    } else {
+        mCalls[STAT_TEXTURE]++;
+    }
+    GLenum active = GL_TEXTURE0 + unit;
+    if (mActiveTexture != active) {
+        glActiveTexture(active);
+        mActiveTexture = active;
+    }
+    glBindTexture(target, texture);
+}
+
+void GlState::bindImageTexture(GLuint unit, GLuint texture, GLint level,
+        GLboolean layered, GLint layer, GLenum access, GLenum format) {
+    mCalls[STAT_IMAGE]++;
+    if (unit < MAX_IMAGE_UNITS) {
+        ImageBinding& b = mImages[unit];
+        if (b.texture == texture && b.level == level && b.layered == layered &&
+                b.layer == layer && b.access == access && b.format == format) {
+            mFiltered[STAT_IMAGE]++;
+            return;
+        }
+        b.texture = texture;
+        b.level = level;
+        b.layered = layered;
+        b.layer = layer;
+        b.access = access;
+        b.format = format;
+    }
+    glBindImageTexture(unit, texture, level, layered, layer, access, format);
+}
+
+void GlState::deleteBuffers(GLsizei n, const GLuint* buffers) {
+    for (GLsizei i = 0; i < n; i++) {
+        for (int t = 0; t < BT_COUNT; t++) {
+            if (buffers[i] && mBuffers[t] == buffers[i])
+                mBuffers[t] = 0;
+        }
+    }
+    glDeleteBuffers(n, buffers);
+}
+
+void GlState::deleteTextures(GLsizei n, const GLuint* textures) {
+    for (GLsizei i = 0; i < n; i++) {
+        if (!textures[i])
+            continue;
+        for (int u = 0; u < MAX_TEXTURE_UNITS; u++) {
+            for (int t = 0; t < TT_COUNT; t++) {
+                if (mTextures[u][t] == textures[i])
+                    mTextures[u][t] = 0;
+            }
+        }
+        // Drivers disagree on what happens to image units; rebind.
+        for (int u = 0; u < MAX_IMAGE_UNITS; u++) {
+            if (mImages[u].texture == textures[i])
+                mImages[u].texture = UNKNOWN;
+        }
+    }
+    glDeleteTextures(n, textures);
+}
+
+void GlState::deleteVertexArrays(GLsizei n, const GLuint* vaos) {
+    for (GLsizei i = 0; i < n; i++) {
+        if (vaos[i] && mVertexArray == vaos[i]) {
+            mVertexArray = 0;
+            mBuffers[BT_ELEMENT_ARRAY] = UNKNOWN;
+        }
+    }
+    glDeleteVertexArrays(n, vaos);
+}
+
+void GlState::deleteFramebuffers(GLsizei n, const GLuint* fbos) {
+    for (GLsizei i = 0; i < n; i++) {
+        if (!fbos[i])
+            continue;
+        if (mDrawFramebuffer == fbos[i])
+            mDrawFramebuffer = 0;
+        if (mReadFramebuffer == fbos[i])
+            mReadFramebuffer = 0;
+    }
+    glDeleteFramebuffers(n, fbos);
+}
+
+void GlState::logStats() const {
+    for (int i = 0; i < STAT_COUNT; i++) {
+        if (!mCalls[i])
+            continue;
+        ALOGV("GL state: %u of %u %s binds filtered (%.1f%%)",
+                mFiltered[i], mCalls[i], STAT_NAMES[i],
+                100.0f * mFiltered[i] / mCalls[i]);
+    }
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright 2013 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GLSTATE_H
+#define GLSTATE_H 1
+
+#include "gles3jni.h"
+
+// ----------------------------------------------------------------------------
+// Shadow of the binding state of one context. The wrappers skip calls that
+// wouldn't change anything and count how many they skipped.
+//
+// The shadow starts out unknown, so the first call of each kind always
+// reaches GL. Renderers own one per context; a new context comes with a new
+// renderer and so a fresh shadow. Code that binds things behind the
+// tracker's back must call invalidate() afterwards.
+//
+// Deleting a bound object unbinds it, so objects must be deleted through
+// the tracker too, at least in the context it belongs to.
+
+class GlState {
+public:
+    enum Stat {
+        STAT_PROGRAM,
+        STAT_VERTEX_ARRAY,
+        STAT_BUFFER,
+        STAT_FRAMEBUFFER,
+        STAT_TEXTURE,
+        STAT_IMAGE,
+        STAT_COUNT
+    };
+
+    GlState();
+
+    void invalidate();
+
+    void useProgram(GLuint program);
+    void bindVertexArray(GLuint vao);
+    void bindBuffer(GLenum target, GLuint buffer);
+    // Binds a range to an indexed target, which binds the whole buffer to
+    // the generic target too. Indexed bindings aren't shadowed.
+    void bindBufferRange(GLenum target, GLuint index, GLuint buffer,
+            GLintptr offset, GLsizeiptr size);
+    // target is GL_FRAMEBUFFER, GL_DRAW_FRAMEBUFFER or GL_READ_FRAMEBUFFER
+    void bindFramebuffer(GLenum target, GLuint fbo);
+    // Binds texture to unit, making that the active texture unit.
+    void bindTexture(unsigned int unit, GLenum target, GLuint texture);
+    void bindImageTexture(GLuint unit, GLuint texture, GLint level,
+            GLboolean layered, GLint layer, GLenum access, GLenum format);
+
+    void deleteBuffers(GLsizei n, const GLuint* buffers);
+    void deleteTextures(GLsizei n, const GLuint* textures);
+    void deleteVertexArrays(GLsizei n, const GLuint* vaos);
+    void deleteFramebuffers(GLsizei n, const GLuint* fbos);
+
+    // calls made through the tracker, and how many of those were dropped
+    unsigned int calls(Stat stat) const { return mCalls[stat]; }
+    unsigned int filtered(Stat stat) const { return mFiltered[stat]; }
+    void logStats() const;
+
+private:
+    enum {
+        MAX_TEXTURE_UNITS = 8,
+        MAX_IMAGE_UNITS = 8,
+    };
+    enum BufferTarget {
+        BT_ARRAY,
+        BT_ELEMENT_ARRAY,
+        BT_COPY_READ,
+        BT_COPY_WRITE,
+        BT_PIXEL_PACK,
+        BT_PIXEL_UNPACK,
+        BT_UNIFORM,
+        BT_TRANSFORM_FEEDBACK,
+        BT_TEXTURE,
+        BT_SHADER_STORAGE,
+        BT_ATOMIC_COUNTER,
+        BT_DISPATCH_INDIRECT,
+        BT_DRAW_INDIRECT,
+        BT_COUNT
+    };
+    enum TextureTarget {
+        TT_2D,
+        TT_2D_ARRAY,
+        TT_3D,
+        TT_CUBE_MAP,
+        TT_BUFFER,
+        TT_COUNT
+    };
+    struct ImageBinding {
+        GLuint texture;
+        GLint level;
+        GLboolean layered;
+        GLint layer;
+        GLenum access;
+        GLenum format;
+    };
+
+    // BT_COUNT for targets that aren't shadowed
+    static BufferTarget bufferTarget(GLenum target);
+    // Returns true if the call must be made; updates the stats either way.
+    bool changes(Stat stat, GLuint* shadow, GLuint value);
+
+    GLuint mProgram;
+    GLuint mVertexArray;
+    GLuint mBuffers[BT_COUNT];
+    GLuint mDrawFramebuffer;
+    GLuint mReadFramebuffer;
+    GLenum mActiveTexture;
+    GLuint mTextures[MAX_TEXTURE_UNITS][TT_COUNT];
+    ImageBinding mImages[MAX_IMAGE_UNITS];
+
+    unsigned int mCalls[STAT_COUNT];
+    unsigned int mFiltered[STAT_COUNT];
+};
+
+#endif // GLSTATE_H
@@ -0,0 +1,132 @@
+/*
+ * Copyright 2013 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "GpuTimer.h"
+#include "DeviceCaps.h"
+
+#include <string.h>
+
+GpuTimer::GpuTimer()
+:   mTimestamps(false),
+    mFirst(0),
+    mCount(0),
+    mActive(false),
+    mDiscard(0)
+{
+    memset(mQueries, 0, sizeof(mQueries));
+}
+
+bool GpuTimer::init() {
+    if (available())
+        return true;
+    if (!hasGlCaps(GLCAP_DISJOINT_TIMER_QUERY))
+        return false;
+
+    // Some drivers expose the extension with a zero-bit timestamp counter;
+    // those only support TIME_ELAPSED.
+    mTimestamps = deviceCaps().timestampBits > 0;
+
+    glGenQueriesEXT(mTimestamps ? 2 * MAX_PENDING : MAX_PENDING, mQueries);
+    if (!mTimestamps) {
+        // Keep startQuery(i) valid: spread the queries over the even slots.
+        for (int i = MAX_PENDING - 1; i > 0; i--) {
+            mQueries[2*i] = mQueries[i];
+            mQueries[i] = 0;
+        }
+    }
+    // Reading GL_GPU_DISJOINT_EXT resets it, so start from a clean state.
+    GLint disjoint;
+    glGetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+
+    if (checkGlError("GpuTimer::init")) {
+        destroy();
+        return false;
+    }
+    ALOGV("GPU timing with %s queries",
+            mTimestamps ? "timestamp" : "time elapsed");
+    return true;
+}
+
+void GpuTimer::destroy() {
+    if (!available())
+        return;
+    if (mActive)
+        end();
+    for (unsigned int i = 0; i < 2 * MAX_PENDING; i++) {
+        if (mQueries[i])
+            glDeleteQueriesEXT(1, &mQueries[i]);
+    }
+    memset(mQueries, 0, sizeof(mQueries));
+    mFirst = mCount = mDiscard = 0;
+}
+
+bool GpuTimer::begin() {
+    if (!available() || mActive || mCount == MAX_PENDING)
+        return false;
+    unsigned int slot = (mFirst + mCount) % MAX_PENDING;
+    if (mTimestamps)
+        glQueryCounterEXT(startQuery(slot), GL_TIMESTAMP_EXT);
+    else
+        glBeginQueryEXT(GL_TIME_ELAPSED_EXT, startQuery(slot));
+    mActive = true;
+    return true;
+}
+
+void GpuTimer::end() {
+    if (!mActive)
+        return;
+    unsigned int slot = (mFirst + mCount) % MAX_PENDING;
+    if (mTimestamps)
+        glQueryCounterEXT(endQuery(slot), GL_TIMESTAMP_EXT);
+    else
+        glEndQueryEXT(GL_TIME_ELAPSED_EXT);
+    mActive = false;
+    mCount++;
+}
+
+bool GpuTimer::poll(uint64_t* ns) {
+    while (mCount > 0) {
+        GLint disjoint = 0;
+        glGetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+        if (disjoint)
+            mDiscard = mCount + (mActive ? 1 : 0);
+
+        unsigned int slot = mFirst;
+        GLuint last = mTimestamps ? endQuery(slot) : startQuery(slot);
+        GLuint ready = GL_FALSE;
+        glGetQueryObjectuivEXT(last, GL_QUERY_RESULT_AVAILABLE_EXT, &ready);
+        if (!ready)
+            return false;
+
+        GLuint64 result = 0;
+        glGetQueryObjectui64vEXT(last, GL_QUERY_RESULT_EXT, &result);
+        if (mTimestamps) {
+            GLuint64 start = 0;
+            glGetQueryObjectui64vEXT(startQuery(slot), GL_QUERY_RESULT_EXT, &start);
+            result = result > start ? result - start : 0;
+        }
+        mFirst = (mFirst + 1) % MAX_PENDING;
+        mCount--;
+
+        if (mDiscard > 0) {
+            mDiscard--;
+            continue;
+        }
+        *ns = result;
+        return true;
+    }
+    return false;
+}
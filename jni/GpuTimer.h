@@ -0,0 +1,74 @@
+/*
+ * Copyright 2013 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GPUTIMER_H
+#define GPUTIMER_H 1
+
+#include "gles3jni.h"
+
+// ----------------------------------------------------------------------------
+// Asynchronous GPU timing with GL_EXT_disjoint_timer_query.
+//
+// Each measurement brackets a range of GL commands. Results become available
+// a few frames later; poll() returns them in submission order without ever
+// stalling the pipeline. Up to MAX_PENDING measurements can be in flight, a
+// begin() beyond that is skipped.
+//
+// Timestamp queries are used where the driver supports them, so timers can
+// overlap freely. Otherwise each measurement is a TIME_ELAPSED query, and
+// only one of those may be active in a context at a time.
+
+class GpuTimer {
+public:
+    GpuTimer();
+
+    // Creates the queries in the current context. Returns false if GPU
+    // timing isn't supported, in which case the other calls do nothing.
+    bool init();
+    // Deletes the queries. The context init() ran in must be current.
+    void destroy();
+
+    bool available() const { return mQueries[0] != 0; }
+    // true if measurements are timestamp pairs, which may nest inside
+    // another timer's; TIME_ELAPSED measurements can't
+    bool timestamps() const { return mTimestamps; }
+    // measurements begun but not yet returned by poll()
+    unsigned int pending() const { return mCount; }
+
+    bool begin();
+    void end();
+    // Pops the oldest finished measurement. Returns false if none is ready.
+    // Measurements spanning a disjoint event (e.g. a GPU clock change) are
+    // dropped.
+    bool poll(uint64_t* ns);
+
+private:
+    enum {MAX_PENDING = 8};
+
+    GLuint startQuery(unsigned int slot) const { return mQueries[2*slot]; }
+    GLuint endQuery(unsigned int slot) const { return mQueries[2*slot + 1]; }
+
+    bool mTimestamps;
+    GLuint mQueries[2 * MAX_PENDING];
+    // ring of in-flight measurements, oldest first
+    unsigned int mFirst;
+    unsigned int mCount;
+    bool mActive;
+    // in-flight measurements to drop after a disjoint event
+    unsigned int mDiscard;
+};
+
+#endif // GPUTIMER_H
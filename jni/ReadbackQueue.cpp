@@ -0,0 +1,135 @@
+/*
+ * Copyright 2013 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ReadbackQueue.h"
+#include "GlDebug.h"
+#include "GlState.h"
+#include "SharedResources.h"
+
+#include <string.h>
+
+ReadbackQueue::ReadbackQueue(GlState& gl, BufferArena& arena)
+:   mGl(gl),
+    mArena(arena),
+    mFirst(0),
+    mCount(0)
+{
+    memset(mPending, 0, sizeof(mPending));
+}
+
+ReadbackQueue::Readback* ReadbackQueue::reserve(GLsizeiptr size) {
+    if (mCount == MAX_PENDING) {
+        ALOGE("Readback queue full, dropping a %ld byte readback", (long)size);
+        return NULL;
+    }
+    Readback& r = mPending[(mFirst + mCount) % MAX_PENDING];
+    if (!mArena.allocate(size, BufferArena::ARENA_READBACK, &r.staging))
+        return NULL;
+    return &r;
+}
+
+bool ReadbackQueue::submit(Readback* r, Callback callback, void* user) {
+    // Only a missing fence fails the request. glGetError() would cost a
+    // round trip on every readback, so copy errors are only checked at the
+    // per-call tier, see GlDebug.h.
+    r->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    CHECK_GL_CALL("ReadbackQueue::submit");
+    if (!r->fence) {
+        mArena.free(&r->staging);
+        return false;
+    }
+    r->callback = callback;
+    r->user = user;
+    mCount++;
+    return true;
+}
+
+bool ReadbackQueue::request(GLuint buffer, GLintptr offset, GLsizeiptr size,
+        Callback callback, void* user) {
+    Readback* r = reserve(size);
+    if (!r)
+        return false;
+
+    // Buffer copies read shader writes only after this barrier.
+    glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+    mGl.bindBuffer(GL_COPY_READ_BUFFER, buffer);
+    mGl.bindBuffer(GL_COPY_WRITE_BUFFER, r->staging.buffer);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER,
+            offset, r->staging.offset, size);
+    return submit(r, callback, user);
+}
+
+bool ReadbackQueue::requestPixels(GLint x, GLint y, GLsizei width, GLsizei height,
+        Callback callback, void* user) {
+    Readback* r = reserve(width * height * 4);
+    if (!r)
+        return false;
+
+    // With a pack buffer bound, glReadPixels() only queues the copy.
+    mGl.bindBuffer(GL_PIXEL_PACK_BUFFER, r->staging.buffer);
+    glReadPixels(x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE,
+            (GLvoid*)r->staging.offset);
+    mGl.bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    return submit(r, callback, user);
+}
+
+void ReadbackQueue::poll() {
+    while (mCount > 0) {
+        Readback& r = mPending[mFirst];
+        // Polling only, but make sure the fence gets to the GPU.
+        GLenum status = glClientWaitSync(r.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+            return;
+
+        if (r.staging.map) {
+            complete(r.staging.map);
+            continue;
+        }
+        const GLuint buffer = r.staging.buffer;
+        mGl.bindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+        const void* data = glMapBufferRange(GL_COPY_WRITE_BUFFER,
+                r.staging.offset, r.staging.size, GL_MAP_READ_BIT);
+        if (!data)
+            checkGlError("glMapBufferRange(readback)");
+        complete(data);
+        if (data) {
+            // The callback may have bound other buffers.
+            mGl.bindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+            glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+        }
+    }
+}
+
+void ReadbackQueue::complete(const void* data) {
+    Readback r = mPending[mFirst];
+    mFirst = (mFirst + 1) % MAX_PENDING;
+    mCount--;
+    if (r.fence)
+        glDeleteSync(r.fence);
+    if (r.callback)
+        r.callback(data, r.staging.size, r.user);
+    mArena.free(&r.staging);
+}
+
+void ReadbackQueue::destroy(bool contextCurrent, SharedResources* shared) {
+    while (mCount > 0) {
+        if (!contextCurrent) {
+            shared->deferDeleteSync(mPending[mFirst].fence);
+            mPending[mFirst].fence = 0;
+        }
+        complete(NULL);
+    }
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright 2013 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef READBACKQUEUE_H
+#define READBACKQUEUE_H 1
+
+#include "BufferArena.h"
+
+class GlState;
+class SharedResources;
+
+// ----------------------------------------------------------------------------
+// Reads GPU buffers back without stalling. request() copies the source
+// range into a staging range with glCopyBufferSubData(), requestPixels()
+// reads pixels into one, and both fence the copy; poll(), called once per
+// frame, hands each copy to its callback once the fence has signalled.
+// Results arrive a frame or two after the request, in request order.
+//
+// Staging ranges come from the renderer's BufferArena. With persistent
+// mapping the callback reads the coherent mapping directly, otherwise the
+// range is mapped for reading after the fence, which then doesn't wait.
+
+class ReadbackQueue {
+public:
+    // data is only valid during the call. It is NULL if the readback
+    // failed or was dropped because the queue was destroyed first.
+    typedef void (*Callback)(const void* data, GLsizeiptr size, void* user);
+
+    ReadbackQueue(GlState& gl, BufferArena& arena);
+
+    // Queues a copy of size bytes at offset in buffer. Shader writes to the
+    // buffer must have been dispatched already; the barrier making them
+    // visible to the copy is issued here. Returns false, without calling
+    // callback, if too many readbacks are in flight or staging memory ran
+    // out.
+    bool request(GLuint buffer, GLintptr offset, GLsizeiptr size,
+            Callback callback, void* user);
+    // Queues a read of a rectangle of the read framebuffer's color buffer
+    // as GL_RGBA/GL_UNSIGNED_BYTE, tightly packed, which is what the
+    // default GL_PACK_ALIGNMENT of 4 gives. Returns false as request().
+    bool requestPixels(GLint x, GLint y, GLsizei width, GLsizei height,
+            Callback callback, void* user);
+    // Delivers the finished readbacks.
+    void poll();
+    // Drops the readbacks in flight, calling their callbacks with NULL
+    // data. Staging memory goes with the arena. If the context isn't
+    // current, fences are handed to shared->deferDeleteSync().
+    void destroy(bool contextCurrent, SharedResources* shared);
+
+    unsigned int pending() const { return mCount; }
+
+private:
+    enum {MAX_PENDING = 8};
+
+    struct Readback {
+        BufferRange staging;
+        GLsync fence;
+        Callback callback;
+        void* user;
+    };
+
+    // Next free entry with size bytes of staging, or NULL.
+    Readback* reserve(GLsizeiptr size);
+    // Fences the copy into r's staging and queues r.
+    bool submit(Readback* r, Callback callback, void* user);
+    // Removes the oldest readback and calls its callback with data.
+    void complete(const void* data);
+
+    GlState& mGl;
+    BufferArena& mArena;
+    // ring of readbacks in flight, oldest first
+    Readback mPending[MAX_PENDING];
+    unsigned int mFirst;
+    unsigned int mCount;
+};
+
+#endif // READBACKQUEUE_H
@@ -0,0 +1,285 @@
+/*
+ * Copyright 2013 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gles3jni.h"
+#include "ShaderSources.h"
+#include "SharedResources.h"
+#include "DeviceCaps.h"
+#include "GlState.h"
+#include <EGL/egl.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+// uniform vectors left to camera and whatever the driver reserves
+#define RESERVED_UNIFORM_VECTORS 8
+
+// ES 2.0 has no instanced draws. Instead the mesh holds a batch worth of
+// quads, each tagged with its index in the batch, and every draw call
+// uploads the transforms of one batch to uniform arrays, see
+// shaders/draw_es2.vert. Each instance takes one vector for its transform
+// and half of one for its offset, so the batch size follows from
+// GL_MAX_VERTEX_UNIFORM_VECTORS: 80 instances at the ES 2.0 minimum of 128.
+//
+// Quads are drawn in instance order with the same transforms as
+// RendererES3, so the output is the same, at full resolution (ES 2.0 has no
+// framebuffer blits for the governor's render scale). Depth mode works the
+// same too; overdraw isn't counted, as ES 2.0 can't read pixels back
+// without stalling.
+
+struct BatchVertex {
+    GLfloat pos[2];
+    GLubyte rgba[4];
+    GLfloat instance;
+};
+
+class RendererES2: public Renderer {
+public:
+    RendererES2(SharedResources* shared, SimulationState* sim);
+    virtual ~RendererES2();
+    bool init();
+
+private:
+    enum {BUF_VERTICES, BUF_INDICES, BUF_COUNT};
+    enum {ATTRIB_POS, ATTRIB_COLOR, ATTRIB_INSTANCE, ATTRIB_COUNT};
+    // draw_es2 without and with the DEPTH feature
+    enum {DV_PLAIN, DV_DEPTH, DV_COUNT};
+
+    struct DrawProgram {
+        GLuint program;
+        GLint scaleRotLoc;
+        GLint offsetsLoc;
+        GLint cameraLoc;
+        GLint depthStepLoc;
+        GLint batchFirstLoc;
+        GLint attribs[ATTRIB_COUNT];
+    };
+
+    // Plain memory stands in for the instance buffers; the uniforms are
+    // set from it at draw time.
+    virtual float* mapOffsetBuf() { return mOffsets; }
+    virtual void unmapOffsetBuf() {}
+    virtual float* mapTransformBuf() { return mTransforms; }
+    virtual void unmapTransformBuf() {}
+    virtual void draw(unsigned int numInstances);
+
+    bool initBatchMesh();
+    bool initProgram(unsigned int variant, const ShaderVariantKey& key);
+    // Points the attributes of variant's program at the batch mesh.
+    void bindAttribs(unsigned int variant);
+
+    const EGLContext mEglContext;
+    GlState mGl;
+    SharedResources* mShared;
+    unsigned int mBatchSize;
+    DrawProgram mDraw[DV_COUNT];
+    // variant the attributes are set up for, DV_COUNT for none
+    unsigned int mAttribVariant;
+    bool mDepthTest;
+    GLuint mBuffers[BUF_COUNT];
+
+    float mTransforms[MAX_INSTANCES * 4];
+    // The last batch may upload half a vector past the last offset.
+    float mOffsets[MAX_INSTANCES * 2 + 2];
+};
+
+Renderer* createES2Renderer(SharedResources* shared, SimulationState* sim) {
+    RendererES2* renderer = new RendererES2(shared, sim);
+    if (!renderer->init()) {
+        delete renderer;
+        return NULL;
+    }
+    return renderer;
+}
+
+RendererES2::RendererES2(SharedResources* shared, SimulationState* sim)
+:   Renderer(sim),
+    mEglContext(eglGetCurrentContext()),
+    mShared(shared),
+    mBatchSize(0),
+    mAttribVariant(DV_COUNT),
+    mDepthTest(false)
+{
+    memset(mDraw, 0, sizeof(mDraw));
+    for (int i = 0; i < BUF_COUNT; i++)
+        mBuffers[i] = 0;
+    memset(mTransforms, 0, sizeof(mTransforms));
+    memset(mOffsets, 0, sizeof(mOffsets));
+}
+
+bool RendererES2::init() {
+    // Batches that don't fit in a driver's uniform space fail to link, so
+    // step down until one does.
+    int vectors = deviceCaps().maxVertexUniformVectors - RESERVED_UNIFORM_VECTORS;
+    unsigned int batchSize = vectors > 3 ? 2 * vectors / 3 : 2;
+    if (batchSize > MAX_INSTANCES)
+        batchSize = MAX_INSTANCES;
+    ShaderVariantKey key = defaultVariantKey(DRAW_ES2_SHADER);
+    const int batchConstant = findShaderConstant(DRAW_ES2_SHADER, "BATCH_SIZE");
+    const uint32_t depthFeature = 1u << findShaderFeature(DRAW_ES2_SHADER, "DEPTH");
+    key.features &= ~depthFeature;
+    for (; batchSize >= 1; batchSize /= 2) {
+        key.constants[batchConstant] = batchSize;
+        if (initProgram(DV_PLAIN, key))
+            break;
+    }
+    if (!mDraw[DV_PLAIN].program)
+        return false;
+    mBatchSize = batchSize;
+    // The depth variant takes two more uniforms, which the reserve covers;
+    // without it depth mode draws in instance order.
+    key.features |= depthFeature;
+    if (!initProgram(DV_DEPTH, key))
+        ALOGE("draw_es2 with DEPTH doesn't link; depth mode is off");
+
+    if (!initBatchMesh())
+        return false;
+
+    ALOGV("Using OpenGL ES 2.0 renderer, %u instances per draw", mBatchSize);
+    return true;
+}
+
+bool RendererES2::initBatchMesh() {
+    BatchVertex* vertices = (BatchVertex*)malloc(mBatchSize * 4 * sizeof(BatchVertex));
+    GLushort* indices = (GLushort*)malloc(mBatchSize * 6 * sizeof(GLushort));
+    if (!vertices || !indices) {
+        ALOGE("Out of memory for a %u quad batch", mBatchSize);
+        free(vertices);
+        free(indices);
+        return false;
+    }
+    // Two triangles per quad, as the triangle strip RendererES3 draws.
+    static const GLushort QUAD_INDICES[6] = {0, 1, 2, 2, 1, 3};
+    for (unsigned int q = 0; q < mBatchSize; q++) {
+        for (int v = 0; v < 4; v++) {
+            BatchVertex& vertex = vertices[4*q + v];
+            memcpy(vertex.pos, QUAD[v].pos, sizeof(vertex.pos));
+            memcpy(vertex.rgba, QUAD[v].rgba, sizeof(vertex.rgba));
+            vertex.instance = (GLfloat)q;
+        }
+        for (int i = 0; i < 6; i++)
+            indices[6*q + i] = (GLushort)(4*q + QUAD_INDICES[i]);
+    }
+
+    glGenBuffers(BUF_COUNT, mBuffers);
+    mGl.bindBuffer(GL_ARRAY_BUFFER, mBuffers[BUF_VERTICES]);
+    glBufferData(GL_ARRAY_BUFFER, mBatchSize * 4 * sizeof(BatchVertex),
+            vertices, GL_STATIC_DRAW);
+    mGl.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, mBuffers[BUF_INDICES]);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, mBatchSize * 6 * sizeof(GLushort),
+            indices, GL_STATIC_DRAW);
+    free(vertices);
+    free(indices);
+
+    bindAttribs(DV_PLAIN);
+    return !checkGlError("RendererES2::initBatchMesh");
+}
+
+bool RendererES2::initProgram(unsigned int variant, const ShaderVariantKey& key) {
+    DrawProgram& draw = mDraw[variant];
+    draw.program = mShared->program(DRAW_ES2_SHADER, key);
+    if (!draw.program)
+        return false;
+    draw.scaleRotLoc = glGetUniformLocation(draw.program, "scaleRot");
+    draw.offsetsLoc = glGetUniformLocation(draw.program, "offsets");
+    draw.cameraLoc = glGetUniformLocation(draw.program, "camera");
+    draw.depthStepLoc = glGetUniformLocation(draw.program, "depthStep");
+    draw.batchFirstLoc = glGetUniformLocation(draw.program, "batchFirst");
+    draw.attribs[ATTRIB_POS] = glGetAttribLocation(draw.program, "pos");
+    draw.attribs[ATTRIB_COLOR] = glGetAttribLocation(draw.program, "color");
+    draw.attribs[ATTRIB_INSTANCE] = glGetAttribLocation(draw.program, "instance");
+    for (int i = 0; i < ATTRIB_COUNT; i++) {
+        if (draw.attribs[i] < 0) {
+            ALOGE("draw_es2 is missing vertex attributes");
+            draw.program = 0;
+            return false;
+        }
+    }
+    return true;
+}
+
+void RendererES2::bindAttribs(unsigned int variant) {
+    // Without VAOs this is context state, which nothing else in the
+    // renderer's context touches, so it only changes with the variant;
+    // the variants are linked separately and may place attributes
+    // differently.
+    if (variant == mAttribVariant)
+        return;
+    if (mAttribVariant != DV_COUNT) {
+        for (int i = 0; i < ATTRIB_COUNT; i++)
+            glDisableVertexAttribArray(mDraw[mAttribVariant].attribs[i]);
+    }
+    const GLint* attribs = mDraw[variant].attribs;
+    mGl.bindBuffer(GL_ARRAY_BUFFER, mBuffers[BUF_VERTICES]);
+    glVertexAttribPointer(attribs[ATTRIB_POS], 2, GL_FLOAT, GL_FALSE, sizeof(BatchVertex),
+            (const GLvoid*)offsetof(BatchVertex, pos));
+    glVertexAttribPointer(attribs[ATTRIB_COLOR], 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(BatchVertex),
+            (const GLvoid*)offsetof(BatchVertex, rgba));
+    glVertexAttribPointer(attribs[ATTRIB_INSTANCE], 1, GL_FLOAT, GL_FALSE, sizeof(BatchVertex),
+            (const GLvoid*)offsetof(BatchVertex, instance));
+    for (int i = 0; i < ATTRIB_COUNT; i++)
+        glEnableVertexAttribArray(attribs[i]);
+    mAttribVariant = variant;
+}
+
+RendererES2::~RendererES2() {
+    /* The destructor may be called after our context has already been
+     * destroyed, in which case the buffers are left to another renderer of
+     * the share group, see RendererES3.
+     */
+    mGl.logStats();
+    if (eglGetCurrentContext() != mEglContext) {
+        mShared->deferDelete(mBuffers, BUF_COUNT, NULL, 0);
+        mShared->release(false);
+        return;
+    }
+    destroyTimerQueries();
+    mGl.deleteBuffers(BUF_COUNT, mBuffers);
+    mShared->release(true);
+}
+
+void RendererES2::draw(unsigned int numInstances) {
+    mShared->collectPrewarmed(1);
+    mShared->collectGarbage();
+
+    // Instances are in slots nearest first in depth mode, see
+    // Renderer::drawOrder(), and get depths by rank as in RendererES3.
+    const unsigned int variant =
+            depthMode() && mDraw[DV_DEPTH].program ? DV_DEPTH : DV_PLAIN;
+    const DrawProgram& draw = mDraw[variant];
+    if ((variant == DV_DEPTH) != mDepthTest) {
+        mDepthTest = variant == DV_DEPTH;
+        if (mDepthTest)
+            glEnable(GL_DEPTH_TEST);
+        else
+            glDisable(GL_DEPTH_TEST);
+    }
+    bindAttribs(variant);
+    mGl.useProgram(draw.program);
+    glUniform3fv(draw.cameraLoc, 1, camera());
+    if (variant == DV_DEPTH)
+        glUniform1f(draw.depthStepLoc, 2.0f / (numInstances ? numInstances : 1));
+    for (unsigned int first = 0; first < numInstances; first += mBatchSize) {
+        unsigned int count = numInstances - first;
+        if (count > mBatchSize)
+            count = mBatchSize;
+        glUniform4fv(draw.scaleRotLoc, count, mTransforms + 4*first);
+        glUniform4fv(draw.offsetsLoc, (count + 1) / 2, mOffsets + 2*first);
+        if (variant == DV_DEPTH)
+            glUniform1f(draw.batchFirstLoc, (GLfloat)first);
+        glDrawElements(GL_TRIANGLES, 6 * count, GL_UNSIGNED_SHORT, 0);
+    }
+}
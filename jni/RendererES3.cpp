@@ -15,64 +15,183 @@
  */
 
 #include "gles3jni.h"
+#include "ShaderSources.h"
+#include "BatchCompute.h"
+#include "CommandStream.h"
+#include "ComputeFormat.h"
+#include "ComputeJobs.h"
+#include "ComputeKernels.h"
+#include "SharedResources.h"
+#include "GlDebug.h"
+#include "GlState.h"
+#include "BufferArena.h"
+#include "BroadPhase.h"
+#include "DeviceCaps.h"
+#include "FrameScheduler.h"
+#include "GpuTimer.h"
+#include "ReadbackQueue.h"
 #include <EGL/egl.h>
 
+#include <math.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <time.h>
 
-#define STR(s) #s
-#define STRV(s) STR(s)
-
+// Must match the attribute locations in shaders/draw.vert.
 #define POS_ATTRIB 0
 #define COLOR_ATTRIB 1
 #define SCALEROT_ATTRIB 2
 #define OFFSET_ATTRIB 3
 
-static const char VERTEX_SHADER[] =
-    "#version 300 es\n"
-    "layout(location = " STRV(POS_ATTRIB) ") in vec2 pos;\n"
-    "layout(location=" STRV(COLOR_ATTRIB) ") in vec4 color;\n"
-    "layout(location=" STRV(SCALEROT_ATTRIB) ") in vec4 scaleRot;\n"
-    "layout(location=" STRV(OFFSET_ATTRIB) ") in vec2 offset;\n"
-    "out vec4 vColor;\n"
-    "void main() {\n"
-    "    mat2 sr = mat2(scaleRot.xy, scaleRot.zw);\n"
-    "    gl_Position = vec4(sr*pos + offset, 0.0, 1.0);\n"
-    "    vColor = color;\n"
-    "}\n";
-
-static const char FRAGMENT_SHADER[] =
-    "#version 300 es\n"
-    "precision mediump float;\n"
-    "in vec4 vColor;\n"
-    "out vec4 outColor;\n"
-    "void main() {\n"
-    "    outColor = vColor;\n"
-    "}\n";
+// With persistent mapping the transform buffer holds this many frames worth
+// of transforms, so the CPU can fill one while the GPU still reads the
+// previous ones.
+#define TRANSFORM_FRAMES 3
+#define TRANSFORM_FRAME_FLOATS (MAX_INSTANCES * 4)
+
+// N6: only 1MB out of 134,217,728 max texture size works with MapBufferRange
+#define COMPUTE_BUF_SIZE (COMPUTE_POINTS * 4 * sizeof(float))
+
+// kernel runs per format in compareComputeFormats()
+#define FORMAT_COMPARISON_DISPATCHES 8
 
 class RendererES3: public Renderer {
 public:
-    RendererES3();
+    RendererES3(SharedResources* shared, SimulationState* sim);
     virtual ~RendererES3();
     bool init();
 
 private:
-    enum {VB_INSTANCE, VB_SCALEROT, VB_OFFSET, VB_COUNT};
+    // The quad itself is shared, see SharedResources::quadBuffer().
+    enum {VB_SCALEROT, VB_OFFSET, VB_COUNT};
+    enum {CB_POSITION, CB_VELOCITY, CB_COUNT};
+    enum {ST_COLOR, ST_DEPTH, ST_COUNT};
+    // Draw program variants, by the DEPTH and OVERDRAW features of
+    // shaders/draw.vert and draw.frag.
+    enum {DV_DEPTH = 1, DV_OVERDRAW = 2, DV_COUNT = 4};
+
+    struct DrawProgram {
+        GLuint program;
+        GLint cameraLoc;
+        GLint depthStepLoc;
+    };
+
+    // A broad phase readback in flight, with the slot order the pairs
+    // refer to. Debug builds keep the bounds the GPU worked on, to check
+    // its pairs against BroadPhaseCpu.
+    struct BroadPhaseReadback {
+        RendererES3* renderer;
+        uint16_t order[MAX_INSTANCES];
+#if DEBUG
+        unsigned int count;
+        BroadPhaseGrid grid;
+        float bounds[MAX_INSTANCES * 4];
+#endif
+    };
 
     virtual float* mapOffsetBuf();
     virtual void unmapOffsetBuf();
     virtual float* mapTransformBuf();
     virtual void unmapTransformBuf();
+    virtual void beginScene(float scale);
+    virtual void endScene();
     virtual void draw(unsigned int numInstances);
+    virtual bool dispatchKernel(unsigned int kernel, unsigned int groupsX,
+            unsigned int groupsY, unsigned int groupsZ);
+    virtual bool runGpuBatch(BatchFiles& files, int64_t* written);
+    virtual bool useComputeFormats(unsigned int velocity, unsigned int position);
+    virtual bool runFormatComparison(ComputeFormatReport* report);
+    virtual unsigned int queueComputeJob(unsigned int kernel, const GLuint groups[3]);
+    virtual bool findComputeJob(unsigned int job, ComputeJobProgress* progress) const;
+    virtual bool schedulerStats(DispatchStats* stats) const;
+
+    bool initComputeBuffers();
+    // Compute key and storage for the given formats, with fixed-point
+    // ranges calibrated on the kernel's input.
+    void computeStorage(unsigned int velocity, unsigned int position,
+            ShaderVariantKey* key, ComputeStorage storage[CB_COUNT]) const;
+    // Points the compute texture buffers at mComputeStorage's formats and
+    // fills the velocity buffer in its format.
+    bool applyComputeStorage();
+    void bindComputeImages();
+    // Uses a variant of the compute program, setting its baseGroup; NULL
+    // for whole dispatches.
+    void useComputeProgram(GLuint program, const GLuint* baseGroup);
+    void* mapComputeBuf(int cb, GLbitfield access);
+    void unmapComputeBuf(int cb);
+    void tryComputeShader();
+    static void onComputeJobDone(unsigned int job, bool completed, void* user);
+    void issueDispatch(const FrameScheduler::Dispatch& dispatch);
+    void dispatchBroadPhase();
+    static void onBroadPhasePairs(const void* data, GLsizeiptr size, void* user);
+    void checkBroadPhase(const BroadPhaseReadback& readback,
+            const uint32_t* pairs, unsigned int count);
+    bool ensureSceneTarget(int w, int h);
+    void waitForTransformFrame(unsigned int frame);
+    void waitForTransformFrames();
+    // Looks the variant up on first use; NULL if it doesn't link.
+    const DrawProgram* drawProgram(unsigned int variant);
+    void setDepthTest(bool enabled);
+    void drawInstances(unsigned int variant, unsigned int numInstances);
+    bool ensureOverdrawTarget(int w, int h);
+    void drawOverdraw(unsigned int numInstances);
+    static void onOverdrawPixels(const void* data, GLsizeiptr size, void* user);
 
     const EGLContext mEglContext;
-    GLuint mProgram;
-    GLuint mVB[VB_COUNT];
-    GLuint mVBState;
+    GlState mGl;
+    SharedResources* mShared;
+    DrawProgram mDraw[DV_COUNT];
+    // feature bits of DV_DEPTH and DV_OVERDRAW in draw variant keys
+    uint32_t mDrawFeatures[2];
+    bool mDepthTest;
+    ShaderVariantKey mComputeKey;
+    // the program of mComputeKey, looked up whenever the key changes so
+    // that dispatches skip the shared cache and its lock
+    GLuint mDispatchProgram;
+    BufferArena mArena;
+    BufferRange mVB[VB_COUNT];
+    GLuint mVBState[TRANSFORM_FRAMES];
+
+    // Non-NULL when the arena keeps buffers persistently mapped.
+    float* mTransformMap;
+    unsigned int mTransformFrame;
+    GLsync mTransformFence[TRANSFORM_FRAMES];
+
+    // Compute needs ES 3.1, texture buffers and room for the kernel's work
+    // group; without them mCompute is false and kernels aren't dispatched.
+    bool mCompute;
+    BufferRange mComputeBuf[CB_COUNT];
+    GLuint mComputeTex[CB_COUNT];
+    ComputeStorage mComputeStorage[CB_COUNT];
+    // the compute program baseGroupLoc was looked up in
+    GLuint mComputeProgram;
+    GLint mBaseGroupLoc;
+    FrameScheduler mScheduler;
+    ComputeJobs mJobs;
+    ReadbackQueue mReadback;
+    // Set if the broad phase runs on the GPU; otherwise Renderer runs it.
+    bool mGpuBroadPhase;
+    BroadPhaseGpu mBroadPhase;
+
+    // Offscreen target for rendering below surface resolution. Its
+    // textures only ever grow, so changing the render size from one frame
+    // to the next is just a different viewport.
+    GLuint mSceneFbo;
+    GLuint mSceneTex[ST_COUNT];
+    int mSceneTexWidth, mSceneTexHeight;
+    // size of the current frame's scene in the target; 0 when the frame
+    // is drawn straight to the surface
+    int mSceneWidth, mSceneHeight;
+
+    // Fragment counting target for overdrawFrame(), a quarter of the
+    // surface each way: every fragment adds 1 to red, see draw.frag.
+    GLuint mOverdrawFbo;
+    GLuint mOverdrawTex[ST_COUNT];
+    int mOverdrawWidth, mOverdrawHeight;
 };
 
-Renderer* createES3Renderer() {
-    RendererES3* renderer = new RendererES3;
+Renderer* createES3Renderer(SharedResources* shared, SimulationState* sim) {
+    RendererES3* renderer = new RendererES3(shared, sim);
     if (!renderer->init()) {
         delete renderer;
         return NULL;
@@ -80,286 +199,1038 @@ Renderer* createES3Renderer() {
     return renderer;
 }
 
-RendererES3::RendererES3()
-:   mEglContext(eglGetCurrentContext()),
-    mProgram(0),
-    mVBState(0)
+RendererES3::RendererES3(SharedResources* shared, SimulationState* sim)
+:   Renderer(sim),
+    mEglContext(eglGetCurrentContext()),
+    mShared(shared),
+    mDepthTest(false),
+    mDispatchProgram(0),
+    mArena(mGl),
+    mTransformMap(NULL),
+    mTransformFrame(0),
+    mCompute(false),
+    mComputeProgram(0),
+    mBaseGroupLoc(-1),
+    mReadback(mGl, mArena),
+    mGpuBroadPhase(false),
+    mBroadPhase(mGl, mArena),
+    mSceneFbo(0),
+    mSceneTexWidth(0),
+    mSceneTexHeight(0),
+    mSceneWidth(0),
+    mSceneHeight(0),
+    mOverdrawFbo(0),
+    mOverdrawWidth(0),
+    mOverdrawHeight(0)
 {
-    for (int i = 0; i < VB_COUNT; i++)
-        mVB[i] = 0;
+    memset(mDraw, 0, sizeof(mDraw));
+    memset(mDrawFeatures, 0, sizeof(mDrawFeatures));
+    memset(mVB, 0, sizeof(mVB));
+    for (int i = 0; i < TRANSFORM_FRAMES; i++) {
+        mVBState[i] = 0;
+        mTransformFence[i] = 0;
+    }
+    memset(mComputeBuf, 0, sizeof(mComputeBuf));
+    for (int i = 0; i < CB_COUNT; i++) {
+        mComputeTex[i] = 0;
+        mComputeStorage[i].format = COMPUTE_FORMAT_RGBA32F;
+        mComputeStorage[i].fracBits = 0;
+    }
+    for (int i = 0; i < ST_COUNT; i++)
+        mSceneTex[i] = mOverdrawTex[i] = 0;
 }
 
-#define stats(v) { \
-    GLint64 i64; \
-    glGetInteger64v(v, &i64); \
-    long long int lli = (long long int)i64; \
-    ALOGV(#v ": %lld", lli); \
+bool RendererES3::initComputeBuffers() {
+    glGenTextures(CB_COUNT, mComputeTex);
+    CHECK_GL_CALL("gen compute textures");
+
+    // Sized for RGBA32F, the largest format.
+    for (int i = 0; i < CB_COUNT; i++) {
+        if (!mArena.allocate(COMPUTE_BUF_SIZE, BufferArena::ARENA_COMPUTE,
+                    &mComputeBuf[i])) {
+            ALOGE("Could not allocate compute buffers, disabling compute");
+            return false;
+        }
+    }
+    return true;
 }
 
-#define stats32_3(v) { \
-    GLint i1, i2, i3; \
-    glGetIntegeri_v(v, 0, &i1); \
-    glGetIntegeri_v(v, 1, &i2); \
-    glGetIntegeri_v(v, 2, &i3); \
-    ALOGV(#v ": (%d, %d, %d)", i1, i2, i3); \
+void* RendererES3::mapComputeBuf(int cb, GLbitfield access) {
+    const BufferRange& buf = mComputeBuf[cb];
+    if (buf.map)
+        return buf.map;
+    mGl.bindBuffer(GL_TEXTURE_BUFFER_EXT, buf.buffer);
+    RLOGV("Going to glMapBufferRange for %ld bytes", (long)buf.size);
+    return glMapBufferRange(GL_TEXTURE_BUFFER_EXT,
+            buf.offset, buf.size, access);
 }
 
-void printOpenGLStats() {
-    stats(GL_MAX_TEXTURE_BUFFER_SIZE_EXT);
-    stats(GL_MAX_COMPUTE_SHARED_MEMORY_SIZE);
-    stats(GL_MAX_SHADER_STORAGE_BLOCK_SIZE);
-    stats(GL_MAX_COMPUTE_SHADER_STORAGE_BLOCKS);
-    stats(GL_MAX_COMPUTE_WORK_GROUP_INVOCATIONS);
-    stats32_3(GL_MAX_COMPUTE_WORK_GROUP_COUNT);
-    stats32_3(GL_MAX_COMPUTE_WORK_GROUP_SIZE);
+void RendererES3::unmapComputeBuf(int cb) {
+    if (mComputeBuf[cb].map)
+        return;
+    glUnmapBuffer(GL_TEXTURE_BUFFER_EXT);
 }
 
-void assertNoGLErrors(const char *step) {
-    GLenum err = glGetError();
-    if (err != GL_NO_ERROR) {
-        ALOGE("Failed to %s: %d", step, err);
-    } else {
-        ALOGV("Completed %s", step);
+void RendererES3::computeStorage(unsigned int velocity, unsigned int position,
+        ShaderVariantKey* key, ComputeStorage storage[CB_COUNT]) const {
+    storage[CB_VELOCITY].format = (ComputeFormat)velocity;
+    storage[CB_POSITION].format = (ComputeFormat)position;
+    storage[CB_VELOCITY].fracBits = storage[CB_POSITION].fracBits = 0;
+    float* velocities = (float*)malloc(COMPUTE_POINTS * 4 * sizeof(float));
+    if (velocities) {
+        float maxVelocity, maxPosition;
+        initComputeVelocities(velocities, COMPUTE_POINTS);
+        velocityToPositionRange(velocities, COMPUTE_POINTS, &maxVelocity, &maxPosition);
+        storage[CB_VELOCITY].fracBits = computeFixedFracBits(maxVelocity);
+        storage[CB_POSITION].fracBits = computeFixedFracBits(maxPosition);
+        free(velocities);
     }
+
+    *key = mComputeKey;
+    key->constants[findShaderConstant(COMPUTE_SHADER, "VELOCITY_FORMAT")] = velocity;
+    key->constants[findShaderConstant(COMPUTE_SHADER, "POSITION_FORMAT")] = position;
+    key->constants[findShaderConstant(COMPUTE_SHADER, "VELOCITY_FRAC_BITS")] =
+            storage[CB_VELOCITY].fracBits;
+    key->constants[findShaderConstant(COMPUTE_SHADER, "POSITION_FRAC_BITS")] =
+            storage[CB_POSITION].fracBits;
 }
 
-void tryComputeShader() {
-    int i;
+bool RendererES3::applyComputeStorage() {
+    for (int i = 0; i < CB_COUNT; i++) {
+        const BufferRange& buf = mComputeBuf[i];
+        if (!buf.buffer)
+            return false;
+        const ComputeFormatInfo& format = COMPUTE_FORMATS[mComputeStorage[i].format];
+        mGl.bindTexture(0, GL_TEXTURE_BUFFER_EXT, mComputeTex[i]);
+        glTexBufferRangeEXT(GL_TEXTURE_BUFFER_EXT, format.internalFormat,
+                buf.buffer, buf.offset, COMPUTE_POINTS * format.bytesPerPoint);
+        CHECK_GL_CALL("tex compute buffer");
+    }
 
-   // Initialize our compute program
-    GLuint compute_prog = glCreateProgram();
-    assertNoGLErrors("create program");
+    const ComputeStorage& storage = mComputeStorage[CB_VELOCITY];
+    float* velocities = (float*)malloc(COMPUTE_POINTS * 4 * sizeof(float));
+    if (!velocities)
+        return false;
+    initComputeVelocities(velocities, COMPUTE_POINTS);
+    void* mapped = mapComputeBuf(CB_VELOCITY, GL_MAP_WRITE_BIT);
+    CHECK_GL_CALL("map velocity buffer range");
+    if (mapped) {
+        encodeComputePoints(velocities, COMPUTE_POINTS, storage, mapped);
+        unmapComputeBuf(CB_VELOCITY);
+        CHECK_GL_CALL("unmap velocity buffer");
+    }
+    free(velocities);
+    return mapped != NULL;
+}
 
-    const int workgroupSize = 1024; // max supported by Nexus 6
+void RendererES3::bindComputeImages() {
+    mGl.bindImageTexture(0, mComputeTex[CB_VELOCITY], 0, false, 0, GL_READ_ONLY,
+            COMPUTE_FORMATS[mComputeStorage[CB_VELOCITY].format].internalFormat);
+    mGl.bindImageTexture(1, mComputeTex[CB_POSITION], 0, false, 0, GL_WRITE_ONLY,
+            COMPUTE_FORMATS[mComputeStorage[CB_POSITION].format].internalFormat);
+}
 
-    static const char compute_shader_header[] =
-R"(#version 310 es
-#define LOCAL_SIZE )";
-    static const char compute_shader_body[] =
-R"(#extension GL_ANDROID_extension_pack_es31a : require
+void RendererES3::useComputeProgram(GLuint program, const GLuint* baseGroup) {
+    mGl.useProgram(program);
+    if (program != mComputeProgram) {
+        mComputeProgram = program;
+        mBaseGroupLoc = glGetUniformLocation(program, "baseGroup");
+    }
+    // Programs are shared, so another context may have changed it.
+    static const GLuint ZERO[3] = {0, 0, 0};
+    const GLuint* base = baseGroup ? baseGroup : ZERO;
+    glUniform3ui(mBaseGroupLoc, base[0], base[1], base[2]);
+}
 
-layout(local_size_x = LOCAL_SIZE) in;
-layout(binding=0, rgba32f) uniform mediump readonly imageBuffer velocity_buffer;
-layout(binding=1, rgba32f) uniform mediump writeonly imageBuffer position_buffer;
+// The variant tryComputeShader() ran, for logComputeResults().
+struct ComputeReadback {
+    RendererES3* renderer;
+    int workgroupSize;
+    bool debugIds;
+    ComputeStorage storage[2];
+};
 
-void main()
-{
-    vec4 vel = imageLoad(velocity_buffer, int(gl_GlobalInvocationID.x));
-    vel += vec4(0.0f, 0.0f, 25.0f, 12.5f);
-    vec4 result = vec4(gl_LocalInvocationID.x, gl_WorkGroupID.x, gl_LocalInvocationID.y, gl_WorkGroupID.y);
-    imageStore(position_buffer, int(gl_GlobalInvocationID.x), result);
-}
-)";
-
-    const int compute_shader_source_max_len = strlen(compute_shader_header) + 32 + strlen(compute_shader_body);
-    char compute_shader_source[compute_shader_source_max_len];
-    snprintf(compute_shader_source, compute_shader_source_max_len,
-        R"(%s%d
-           %s)", compute_shader_header, workgroupSize, compute_shader_body);
-
-
-    GLuint shader = glCreateShader(GL_COMPUTE_SHADER);
-    assertNoGLErrors("create shader");
-    const GLchar* sources = { compute_shader_source };
-    glShaderSource(shader, 1, &sources, NULL);
-    assertNoGLErrors("shader source");
-    glCompileShader(shader);
-    assertNoGLErrors("compile shader");
-
-    GLint shader_ok = 0;
-    glGetShaderiv(shader, GL_COMPILE_STATUS, &shader_ok);
-    if (shader_ok != GL_TRUE) {
-        ALOGE("Could not compile shader:\n");
-        GLint log_len;
-        glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &log_len);
-        char* log = (char*)malloc(log_len * sizeof(char));
-        glGetShaderInfoLog(shader, log_len, NULL, log);
-        ALOGE("%s\n", log);
-        glDeleteShader(shader);
+// Debug builds run the CPU version of the kernel on the same velocities,
+// as stored, and report where the GPU disagrees by more than the rounding
+// of the position format.
+static void checkComputeResults(const float* positions, unsigned int points,
+        const ComputeReadback& variant) {
+    const ComputeStorage& velocityStorage = variant.storage[0];
+    const ComputeStorage& positionStorage = variant.storage[1];
+    float* velocities = (float*)malloc(2 * points * 4 * sizeof(float));
+    void* stored = malloc(points * COMPUTE_FORMATS[velocityStorage.format].bytesPerPoint);
+    if (!velocities || !stored) {
+        free(velocities);
+        free(stored);
         return;
     }
+    float* expected = velocities + points * 4;
+    initComputeVelocities(velocities, points);
+    encodeComputePoints(velocities, points, velocityStorage, stored);
+    decodeComputePoints(stored, points, velocityStorage, velocities);
+    free(stored);
+    VelocityToPositionArgs args = {velocities, expected, points, variant.debugIds};
+    CpuKernel kernel = VELOCITY_TO_POSITION_KERNEL;
+    kernel.localSize[0] = variant.workgroupSize;
+    const uint32_t groups[3] = {2 * points / variant.workgroupSize, 1, 1};
+    if (cpuDispatch(kernel, groups, &args)) {
+        for (unsigned int i = 0; i < points * 4; i++) {
+            if (fabsf(positions[i] - expected[i]) >
+                    computeStorageTolerance(positionStorage, expected[i])) {
+                RLOGW("Compute: positions[%u] is %f on the GPU, %f on the CPU",
+                        i / 4, positions[i], expected[i]);
+                break;
+            }
+        }
+    }
+    free(velocities);
+}
 
-    glAttachShader(compute_prog, shader);
-    assertNoGLErrors("attach shader");
-    glLinkProgram(compute_prog);
-    assertNoGLErrors("link shader");
-
-    ALOGV("Program linked");
-    const int POINTS = 63*1024;  // N6: max number of points that can be actually retrieved using MapBufferRange
-    const size_t sizeInBytes = POINTS * 4 * sizeof(float); // N6: only 1MB out of 134,217,728 max texture size works with MapBufferRange
-    GLuint buffers[2];
-    glGenBuffers(2, buffers);
-    GLuint position_buffer = buffers[0];
-    GLuint velocity_buffer = buffers[1];
-
-    printOpenGLStats();
-
-    glBindBuffer(GL_TEXTURE_BUFFER_EXT, velocity_buffer);
-    assertNoGLErrors("bind velocity buffer");
-    glBufferData(GL_TEXTURE_BUFFER_EXT, sizeInBytes, NULL, GL_DYNAMIC_COPY);
-    assertNoGLErrors("buffer velocity data");
-
-    long unsigned int luiSizeInBytes = (long unsigned int)sizeInBytes;
-    ALOGV("Going to glMapBufferRange for %lu bytes", luiSizeInBytes);
-    float *velocities = (float*)glMapBufferRange(GL_TEXTURE_BUFFER_EXT,
-                                                0,
-                                                sizeInBytes,
-                                                GL_MAP_WRITE_BIT);
-    assertNoGLErrors("map velocity buffer range");
-    for (i = 0; i < POINTS; i++) {
-        velocities[i * 4 + 0] = -i * 4;
-        velocities[i * 4 + 1] = i * 4 + 1;
-        velocities[i * 4 + 2] = -i * 4 + 2;
-        velocities[i * 4 + 3] = i * 4 + 3;
+// ReadbackQueue callback for tryComputeShader(); user is the
+// ComputeReadback.
+static void logComputeResults(const void* data, GLsizeiptr size, void* user) {
+    ComputeReadback* variant = (ComputeReadback*)user;
+    const ComputeStorage& storage = variant->storage[1];
+    const unsigned int points =
+            (unsigned int)(size / COMPUTE_FORMATS[storage.format].bytesPerPoint);
+    float* decoded = NULL;
+    if (data && storage.format != COMPUTE_FORMAT_RGBA32F) {
+        decoded = (float*)malloc(points * 4 * sizeof(float));
+        if (decoded)
+            decodeComputePoints(data, points, storage, decoded);
+        data = decoded;
     }
-    glUnmapBuffer(GL_TEXTURE_BUFFER_EXT);
-    assertNoGLErrors("unmap velocity buffer");
+    if (data) {
+        const float* positions = (const float*)data;
+        logComputePositions(positions, points, variant->workgroupSize);
+        if (DEBUG)
+            checkComputeResults(positions, points, *variant);
+        RLOGV("Compute results read back");
+    }
+    free(decoded);
+    free(variant);
+}
 
-    glBindBuffer(GL_TEXTURE_BUFFER_EXT, position_buffer);
-    assertNoGLErrors("bind position buffer");
-    glBufferData(GL_TEXTURE_BUFFER_EXT, sizeInBytes, NULL, GL_DYNAMIC_COPY);
-    assertNoGLErrors("buffer position data");
+void RendererES3::tryComputeShader() {
+    // Initialize our compute program
+    const int workgroupSize =
+            mComputeKey.constants[findShaderConstant(COMPUTE_SHADER, "LOCAL_SIZE")];
 
-    GLuint tbos[2];
-    glGenTextures(2, tbos);
-    assertNoGLErrors("gen textures");
+    GLuint compute_prog = mShared->program(COMPUTE_SHADER, mComputeKey);
+    mDispatchProgram = compute_prog;
+    if (!compute_prog)
+        return;
 
-    int velocity_tbo = tbos[0];
-    glBindTexture(GL_TEXTURE_BUFFER_EXT, velocity_tbo);
-    assertNoGLErrors("bind velocity texture");
-    glTexBufferEXT(GL_TEXTURE_BUFFER_EXT, GL_RGBA32F, velocity_buffer);
-    assertNoGLErrors("tex velocity buffer");
+    ALOGV("Program linked");
+    const int POINTS = COMPUTE_POINTS;
 
-    int position_tbo = tbos[1];
-    glBindTexture(GL_TEXTURE_BUFFER_EXT, position_tbo);
-    assertNoGLErrors("bind position texture");
-    glTexBufferEXT(GL_TEXTURE_BUFFER_EXT, GL_RGBA32F, position_buffer);
-    assertNoGLErrors("tex position buffer");
+    if (!applyComputeStorage())
+        return;
 
     // === End of initialization and setup ===
 
     // === Run the compute shader and retrieve the results ===
 
-    glUseProgram(compute_prog);
-    assertNoGLErrors("use program");
-
-    glBindImageTexture(0, velocity_tbo, 0, false, 0, GL_READ_ONLY, GL_RGBA32F);
-    assertNoGLErrors("bind image texture for velocity tbo");
-    glBindImageTexture(1, position_tbo, 0, false, 0, GL_WRITE_ONLY, GL_RGBA32F);
-    assertNoGLErrors("bind image texture for position tbo");
-
-    glDispatchCompute(2 * POINTS / workgroupSize, 1, 1);
-    assertNoGLErrors("dispatch compute");
-
-    glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
-    assertNoGLErrors("memory barrier");
-    glFinish();
-    assertNoGLErrors("finish");
-    ALOGV("Program completed");
-
-    float *positions = (float*)glMapBufferRange(GL_TEXTURE_BUFFER_EXT,
-                                                0,
-                                                sizeInBytes,
-                                                GL_MAP_READ_BIT);
-    assertNoGLErrors("map positions buffer");
-    for (i = 0; i < POINTS / workgroupSize; i++) {
-        // if ((i < 2 * workgroupSize) || (i > POINTS - 2 * workgroupSize)) {
-            ALOGV("positions[%d]=(%f, %f, %f, %f)\n", i * workgroupSize,
-                positions[i * workgroupSize * 4 + 0],
-                positions[i * workgroupSize * 4 + 1],
-                positions[i * workgroupSize * 4 + 2],
-                positions[i * workgroupSize * 4 + 3]);
-            ALOGV("positions[%d]=(%f, %f, %f, %f)\n", i * workgroupSize + 1,
-                positions[(i * workgroupSize + 1) * 4 + 0],
-                positions[(i * workgroupSize + 1) * 4 + 1],
-                positions[(i * workgroupSize + 1) * 4 + 2],
-                positions[(i * workgroupSize + 1) * 4 + 3]);
+    // The kernel runs as a job, in slices over the first frames, see
+    // ComputeJobs. onComputeJobDone() then reads the results back for
+    // logComputeResults() instead of waiting for them here.
+    ComputeReadback* variant = (ComputeReadback*)malloc(sizeof(ComputeReadback));
+    if (!variant)
+        return;
+    variant->renderer = this;
+    variant->workgroupSize = workgroupSize;
+    const int debugIds = findShaderFeature(COMPUTE_SHADER, "DEBUG_IDS");
+    variant->debugIds = debugIds >= 0 && (mComputeKey.features & (1u << debugIds));
+    variant->storage[0] = mComputeStorage[CB_VELOCITY];
+    variant->storage[1] = mComputeStorage[CB_POSITION];
+    const GLuint groups[3] = {(GLuint)(2 * POINTS / workgroupSize), 1, 1};
+    if (!mJobs.submit(KERNEL_VELOCITY_TO_POSITION, groups, onComputeJobDone, variant)) {
+        free(variant);
+        return;
     }
-    glUnmapBuffer(GL_TEXTURE_BUFFER_EXT);
-    assertNoGLErrors("unmap positions buffer");
 
     ALOGV("All done with tryComputeShader");
     return;
 }
 
-
+// ComputeJobs callback for tryComputeShader(); user is the ComputeReadback.
+void RendererES3::onComputeJobDone(unsigned int job, bool completed, void* user) {
+    ComputeReadback* variant = (ComputeReadback*)user;
+    if (!completed) {
+        free(variant);
+        return;
+    }
+    RendererES3* renderer = variant->renderer;
+    const BufferRange& positions = renderer->mComputeBuf[CB_POSITION];
+    const GLsizeiptr positionsSize = COMPUTE_POINTS *
+            COMPUTE_FORMATS[variant->storage[1].format].bytesPerPoint;
+    if (!renderer->mReadback.request(positions.buffer, positions.offset,
+            positionsSize, logComputeResults, variant)) {
+        ALOGE("Could not read back compute results");
+        free(variant);
+    }
+    CHECK_GL_CALL("request positions readback");
+}
 
 bool RendererES3::init() {
-    mProgram = createProgram(VERTEX_SHADER, FRAGMENT_SHADER);
-    if (!mProgram)
+    const DeviceCaps& caps = deviceCaps();
+    mComputeKey = defaultVariantKey(COMPUTE_SHADER);
+    // ES 3.1 only guarantees 128 invocations per work group, so shrink
+    // the shader's default size to fit rather than giving up on compute.
+    const int localSizeConstant = findShaderConstant(COMPUTE_SHADER, "LOCAL_SIZE");
+    int workgroupSize = mComputeKey.constants[localSizeConstant];
+    while (workgroupSize > 1 && (workgroupSize > caps.maxComputeWorkGroupSize[0] ||
+            workgroupSize > caps.maxComputeWorkGroupInvocations))
+        workgroupSize >>= 1;
+    mComputeKey.constants[localSizeConstant] = workgroupSize;
+    mCompute = hasGlCaps(GLCAP_ES31 | GLCAP_TEXTURE_BUFFER);
+
+    // Start every compute permutation compiling in the driver while the
+    // draw program is built; the one tryComputeShader needs is then
+    // usually ready without a stall.
+    if (mCompute)
+        mShared->prewarmAllFeatures(COMPUTE_SHADER, mComputeKey);
+
+    // The depth and overdraw variants are only needed once the app asks
+    // for them; compile them in the background meanwhile.
+    const ShaderVariantKey drawKey = defaultVariantKey(DRAW_SHADER);
+    mDrawFeatures[0] = 1u << findShaderFeature(DRAW_SHADER, "DEPTH");
+    mDrawFeatures[1] = 1u << findShaderFeature(DRAW_SHADER, "OVERDRAW");
+    if (!drawProgram(0))
         return false;
+    mShared->prewarmAllFeatures(DRAW_SHADER, drawKey);
+
+    mArena.init();
+
+    if (mCompute)
+        mCompute = initComputeBuffers();
+    if (mCompute) {
+        mJobs.init();
+        tryComputeShader();
+    }
 
-    tryComputeShader();
+    // Three frames of transforms when persistently mapped, see draw().
+    // Otherwise instance data is re-specified every frame by orphaning, which
+    // only works on whole buffers, so each stream gets a page of its own.
+    const bool persistent = mArena.persistent();
+    int numVBStates = persistent ? TRANSFORM_FRAMES : 1;
+    if (!mArena.allocate(numVBStates * TRANSFORM_FRAME_FLOATS * sizeof(float),
+                BufferArena::ARENA_INSTANCES, &mVB[VB_SCALEROT], !persistent) ||
+            !mArena.allocate(MAX_INSTANCES * 2*sizeof(float),
+                BufferArena::ARENA_INSTANCES, &mVB[VB_OFFSET], !persistent)) {
+        return false;
+    }
+    mTransformMap = (float*)mVB[VB_SCALEROT].map;
 
-    glGenBuffers(VB_COUNT, mVB);
-    glBindBuffer(GL_ARRAY_BUFFER, mVB[VB_INSTANCE]);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(QUAD), &QUAD[0], GL_STATIC_DRAW);
-    glBindBuffer(GL_ARRAY_BUFFER, mVB[VB_SCALEROT]);
-    glBufferData(GL_ARRAY_BUFFER, MAX_INSTANCES * 4*sizeof(float), NULL, GL_DYNAMIC_DRAW);
-    glBindBuffer(GL_ARRAY_BUFFER, mVB[VB_OFFSET]);
-    glBufferData(GL_ARRAY_BUFFER, MAX_INSTANCES * 2*sizeof(float), NULL, GL_STATIC_DRAW);
+    // The passes read the instance buffers as shader storage, so this
+    // comes after them.
+    mGpuBroadPhase = mBroadPhase.init(mShared, BROADPHASE_SHADER,
+            MAX_INSTANCES, MAX_COLLISION_PAIRS);
 
-    glGenVertexArrays(1, &mVBState);
-    glBindVertexArray(mVBState);
+    // One VAO per transform frame, so that switching frames is a single
+    // glBindVertexArray rather than re-specifying the attribute pointer.
+    glGenVertexArrays(numVBStates, mVBState);
+    for (int i = 0; i < numVBStates; i++) {
+        mGl.bindVertexArray(mVBState[i]);
 
-    glBindBuffer(GL_ARRAY_BUFFER, mVB[VB_INSTANCE]);
-    glVertexAttribPointer(POS_ATTRIB, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (const GLvoid*)offsetof(Vertex, pos));
-    glVertexAttribPointer(COLOR_ATTRIB, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex), (const GLvoid*)offsetof(Vertex, rgba));
-    glEnableVertexAttribArray(POS_ATTRIB);
-    glEnableVertexAttribArray(COLOR_ATTRIB);
+        mGl.bindBuffer(GL_ARRAY_BUFFER, mShared->quadBuffer());
+        glVertexAttribPointer(POS_ATTRIB, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (const GLvoid*)offsetof(Vertex, pos));
+        glVertexAttribPointer(COLOR_ATTRIB, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex), (const GLvoid*)offsetof(Vertex, rgba));
+        glEnableVertexAttribArray(POS_ATTRIB);
+        glEnableVertexAttribArray(COLOR_ATTRIB);
 
-    glBindBuffer(GL_ARRAY_BUFFER, mVB[VB_SCALEROT]);
-    glVertexAttribPointer(SCALEROT_ATTRIB, 4, GL_FLOAT, GL_FALSE, 4*sizeof(float), 0);
-    glEnableVertexAttribArray(SCALEROT_ATTRIB);
-    glVertexAttribDivisor(SCALEROT_ATTRIB, 1);
+        mGl.bindBuffer(GL_ARRAY_BUFFER, mVB[VB_SCALEROT].buffer);
+        glVertexAttribPointer(SCALEROT_ATTRIB, 4, GL_FLOAT, GL_FALSE, 4*sizeof(float),
+                (const GLvoid*)(mVB[VB_SCALEROT].offset +
+                        i * TRANSFORM_FRAME_FLOATS * sizeof(float)));
+        glEnableVertexAttribArray(SCALEROT_ATTRIB);
+        glVertexAttribDivisor(SCALEROT_ATTRIB, 1);
 
-    glBindBuffer(GL_ARRAY_BUFFER, mVB[VB_OFFSET]);
-    glVertexAttribPointer(OFFSET_ATTRIB, 2, GL_FLOAT, GL_FALSE, 2*sizeof(float), 0);
-    glEnableVertexAttribArray(OFFSET_ATTRIB);
-    glVertexAttribDivisor(OFFSET_ATTRIB, 1);
+        mGl.bindBuffer(GL_ARRAY_BUFFER, mVB[VB_OFFSET].buffer);
+        glVertexAttribPointer(OFFSET_ATTRIB, 2, GL_FLOAT, GL_FALSE, 2*sizeof(float),
+                (const GLvoid*)mVB[VB_OFFSET].offset);
+        glEnableVertexAttribArray(OFFSET_ATTRIB);
+        glVertexAttribDivisor(OFFSET_ATTRIB, 1);
+    }
 
-    ALOGV("Using OpenGL ES 3.0 renderer");
+    ALOGV("Using OpenGL ES 3.0 renderer%s",
+            mTransformMap ? " with persistent transform buffer" : "");
     return true;
 }
 
 RendererES3::~RendererES3() {
-    /* The destructor may be called after the context has already been
-     * destroyed, in which case our objects have already been destroyed.
+    /* The destructor may be called after our context has already been
+     * destroyed. Its VAOs are gone with it, but buffers, textures and
+     * syncs belong to the share group and may still be alive in other
+     * contexts, so they are left for another renderer of the group to
+     * delete.
      *
-     * If the context exists, it must be current. This only happens when we're
-     * cleaning up after a failed init().
+     * If the context exists, it must be current.
      */
-    if (eglGetCurrentContext() != mEglContext)
+    mGl.logStats();
+    if (eglGetCurrentContext() != mEglContext) {
+        for (int i = 0; i < TRANSFORM_FRAMES; i++)
+            mShared->deferDeleteSync(mTransformFence[i]);
+        mJobs.destroy(false, mShared);
+        mScheduler.destroy(false, mShared);
+        mReadback.destroy(false, mShared);
+        mArena.destroy(false, mShared);
+        mShared->deferDelete(NULL, 0, mComputeTex, CB_COUNT);
+        mShared->deferDelete(NULL, 0, mSceneTex, ST_COUNT);
+        mShared->deferDelete(NULL, 0, mOverdrawTex, ST_COUNT);
+        mShared->release(false);
         return;
-    glDeleteVertexArrays(1, &mVBState);
-    glDeleteBuffers(VB_COUNT, mVB);
-    glDeleteProgram(mProgram);
+    }
+    for (int i = 0; i < TRANSFORM_FRAMES; i++) {
+        if (mTransformFence[i])
+            glDeleteSync(mTransformFence[i]);
+    }
+    destroyTimerQueries();
+    mJobs.destroy(true, mShared);
+    mScheduler.destroy(true, mShared);
+    mGl.deleteFramebuffers(1, &mSceneFbo);
+    mGl.deleteTextures(ST_COUNT, mSceneTex);
+    mGl.deleteFramebuffers(1, &mOverdrawFbo);
+    mGl.deleteTextures(ST_COUNT, mOverdrawTex);
+    // Deleting a buffer also unmaps any persistent mapping of it.
+    mGl.deleteVertexArrays(TRANSFORM_FRAMES, mVBState);
+    mGl.deleteTextures(CB_COUNT, mComputeTex);
+    mReadback.destroy(true, mShared);
+    mArena.destroy(true, mShared);
+    mShared->release(true);
+}
+
+// The frame's transforms get overwritten next, so this must not return
+// before the GPU is done with them: keep waiting past a timeout, and fall
+// back to glFinish() if the wait itself fails.
+void RendererES3::waitForTransformFrame(unsigned int frame) {
+    GLsync fence = mTransformFence[frame];
+    if (!fence)
+        return;
+    GLenum status = glClientWaitSync(fence,
+            GL_SYNC_FLUSH_COMMANDS_BIT, 100000000ull /* 100ms */);
+    while (status == GL_TIMEOUT_EXPIRED) {
+        RLOGW("Transform frame %u still in use after 100ms", frame);
+        status = glClientWaitSync(fence, 0, 100000000ull /* 100ms */);
+    }
+    if (status == GL_WAIT_FAILED) {
+        checkGlError("glClientWaitSync(transform frame)");
+        glFinish();
+    }
+    glDeleteSync(fence);
+    mTransformFence[frame] = 0;
+}
+
+void RendererES3::waitForTransformFrames() {
+    for (unsigned int i = 0; i < TRANSFORM_FRAMES; i++)
+        waitForTransformFrame(i);
 }
 
 float* RendererES3::mapOffsetBuf() {
-    glBindBuffer(GL_ARRAY_BUFFER, mVB[VB_OFFSET]);
+    if (mVB[VB_OFFSET].map) {
+        // Offsets aren't multi-buffered. They only change on resize or
+        // through commands, so just let the GPU finish reading them.
+        waitForTransformFrames();
+        return (float*)mVB[VB_OFFSET].map;
+    }
+    mGl.bindBuffer(GL_ARRAY_BUFFER, mVB[VB_OFFSET].buffer);
     return (float*)glMapBufferRange(GL_ARRAY_BUFFER,
-            0, MAX_INSTANCES * 2*sizeof(float),
+            mVB[VB_OFFSET].offset, mVB[VB_OFFSET].size,
             GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
 }
 
 void RendererES3::unmapOffsetBuf() {
+    if (mVB[VB_OFFSET].map)
+        return;
     glUnmapBuffer(GL_ARRAY_BUFFER);
 }
 
 float* RendererES3::mapTransformBuf() {
-    glBindBuffer(GL_ARRAY_BUFFER, mVB[VB_SCALEROT]);
+    if (mTransformMap) {
+        // draw() already waited for the GPU to finish with the next frame.
+        // It only becomes current in unmapTransformBuf(), so a draw() in
+        // between still uses the last complete frame.
+        const unsigned int next = (mTransformFrame + 1) % TRANSFORM_FRAMES;
+        return mTransformMap + next * TRANSFORM_FRAME_FLOATS;
+    }
+    mGl.bindBuffer(GL_ARRAY_BUFFER, mVB[VB_SCALEROT].buffer);
     return (float*)glMapBufferRange(GL_ARRAY_BUFFER,
-            0, MAX_INSTANCES * 4*sizeof(float),
+            mVB[VB_SCALEROT].offset, mVB[VB_SCALEROT].size,
             GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
 }
 
 void RendererES3::unmapTransformBuf() {
+    // The persistent mapping is coherent, nothing to flush.
+    if (mTransformMap) {
+        mTransformFrame = (mTransformFrame + 1) % TRANSFORM_FRAMES;
+        return;
+    }
     glUnmapBuffer(GL_ARRAY_BUFFER);
 }
 
+bool RendererES3::ensureSceneTarget(int w, int h) {
+    if (mSceneFbo && w <= mSceneTexWidth && h <= mSceneTexHeight)
+        return true;
+
+    // Immutable textures can't be resized, so replace them, large enough
+    // for both the old and the new surface (e.g. across rotations).
+    if (mSceneTex[0])
+        mGl.deleteTextures(ST_COUNT, mSceneTex);
+    mSceneTexWidth = w > mSceneTexWidth ? w : mSceneTexWidth;
+    mSceneTexHeight = h > mSceneTexHeight ? h : mSceneTexHeight;
+
+    glGenTextures(ST_COUNT, mSceneTex);
+    mGl.bindTexture(0, GL_TEXTURE_2D, mSceneTex[ST_COLOR]);
+    glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, mSceneTexWidth, mSceneTexHeight);
+    mGl.bindTexture(0, GL_TEXTURE_2D, mSceneTex[ST_DEPTH]);
+    glTexStorage2D(GL_TEXTURE_2D, 1, GL_DEPTH_COMPONENT16,
+            mSceneTexWidth, mSceneTexHeight);
+    mGl.bindTexture(0, GL_TEXTURE_2D, 0);
+
+    if (!mSceneFbo)
+        glGenFramebuffers(1, &mSceneFbo);
+    mGl.bindFramebuffer(GL_FRAMEBUFFER, mSceneFbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+            GL_TEXTURE_2D, mSceneTex[ST_COLOR], 0);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,
+            GL_TEXTURE_2D, mSceneTex[ST_DEPTH], 0);
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    mGl.bindFramebuffer(GL_FRAMEBUFFER, 0);
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        ALOGE("Scene framebuffer %dx%d incomplete: 0x%04x",
+                mSceneTexWidth, mSceneTexHeight, status);
+        mGl.deleteFramebuffers(1, &mSceneFbo);
+        mGl.deleteTextures(ST_COUNT, mSceneTex);
+        mSceneFbo = 0;
+        mSceneTex[ST_COLOR] = mSceneTex[ST_DEPTH] = 0;
+        mSceneTexWidth = mSceneTexHeight = 0;
+        return false;
+    }
+    RLOGV("Allocated %dx%d scene target", mSceneTexWidth, mSceneTexHeight);
+    return true;
+}
+
+bool RendererES3::ensureOverdrawTarget(int w, int h) {
+    if (mOverdrawFbo && w == mOverdrawWidth && h == mOverdrawHeight)
+        return true;
+    if (mOverdrawTex[0])
+        mGl.deleteTextures(ST_COUNT, mOverdrawTex);
+    mOverdrawWidth = w;
+    mOverdrawHeight = h;
+
+    glGenTextures(ST_COUNT, mOverdrawTex);
+    mGl.bindTexture(0, GL_TEXTURE_2D, mOverdrawTex[ST_COLOR]);
+    glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, w, h);
+    mGl.bindTexture(0, GL_TEXTURE_2D, mOverdrawTex[ST_DEPTH]);
+    glTexStorage2D(GL_TEXTURE_2D, 1, GL_DEPTH_COMPONENT16, w, h);
+    mGl.bindTexture(0, GL_TEXTURE_2D, 0);
+
+    if (!mOverdrawFbo)
+        glGenFramebuffers(1, &mOverdrawFbo);
+    mGl.bindFramebuffer(GL_FRAMEBUFFER, mOverdrawFbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+            GL_TEXTURE_2D, mOverdrawTex[ST_COLOR], 0);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,
+            GL_TEXTURE_2D, mOverdrawTex[ST_DEPTH], 0);
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        ALOGE("Overdraw framebuffer %dx%d incomplete: 0x%04x", w, h, status);
+        mGl.bindFramebuffer(GL_FRAMEBUFFER, 0);
+        mGl.deleteFramebuffers(1, &mOverdrawFbo);
+        mGl.deleteTextures(ST_COUNT, mOverdrawTex);
+        mOverdrawFbo = 0;
+        mOverdrawTex[ST_COLOR] = mOverdrawTex[ST_DEPTH] = 0;
+        mOverdrawWidth = mOverdrawHeight = 0;
+        return false;
+    }
+    RLOGV("Allocated %dx%d overdraw target", w, h);
+    return true;
+}
+
+void RendererES3::beginScene(float scale) {
+    mReadback.poll();
+    mJobs.poll();
+
+    // Compute queued during this frame goes ahead of its draws, see
+    // FrameScheduler, and so does a slice of the oldest compute job.
+    ComputeJobs::Slice slice;
+    if (mJobs.nextSlice(computeSliceBudgetNs(), &slice))
+        mScheduler.queueSlice(slice.job, slice.kernel, slice.baseGroup, slice.groups);
+    const FrameScheduler::Dispatch* dispatches;
+    unsigned int numDispatches = mScheduler.beginBatch(&dispatches);
+    for (unsigned int i = 0; i < numDispatches; i++)
+        issueDispatch(dispatches[i]);
+    mScheduler.endBatch();
+
+    const int w = surfaceWidth();
+    const int h = surfaceHeight();
+    int sw = (int)(w * scale + 0.5f);
+    int sh = (int)(h * scale + 0.5f);
+    sw = sw > 0 ? sw : 1;
+    sh = sh > 0 ? sh : 1;
+
+    // At full resolution the blit would only cost bandwidth.
+    if ((sw >= w && sh >= h) || !ensureSceneTarget(w, h)) {
+        mSceneWidth = mSceneHeight = 0;
+        glViewport(0, 0, w, h);
+        return;
+    }
+    mSceneWidth = sw;
+    mSceneHeight = sh;
+    mGl.bindFramebuffer(GL_FRAMEBUFFER, mSceneFbo);
+    glViewport(0, 0, sw, sh);
+}
+
+void RendererES3::endScene() {
+    // Depth is cleared every frame and never read back, so on tilers
+    // invalidating it saves writing it out to memory.
+    if (!mSceneWidth) {
+        static const GLenum SURFACE_DEPTH = GL_DEPTH;
+        glInvalidateFramebuffer(GL_FRAMEBUFFER, 1, &SURFACE_DEPTH);
+        return;
+    }
+    static const GLenum SCENE_DEPTH = GL_DEPTH_ATTACHMENT;
+    static const GLenum SCENE_COLOR = GL_COLOR_ATTACHMENT0;
+    glInvalidateFramebuffer(GL_FRAMEBUFFER, 1, &SCENE_DEPTH);
+
+    mGl.bindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    glBlitFramebuffer(0, 0, mSceneWidth, mSceneHeight,
+            0, 0, surfaceWidth(), surfaceHeight(),
+            GL_COLOR_BUFFER_BIT, GL_LINEAR);
+    // The next frame clears the scene again.
+    glInvalidateFramebuffer(GL_READ_FRAMEBUFFER, 1, &SCENE_COLOR);
+    mGl.bindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+}
+
 void RendererES3::draw(unsigned int numInstances) {
-    glUseProgram(mProgram);
-    glBindVertexArray(mVBState);
+    // Pick up at most one prewarmed variant per frame, and delete whatever
+    // renderers of other views left behind.
+    mShared->collectPrewarmed(1);
+    mShared->collectGarbage();
+
+    const unsigned int variant = depthMode() ? DV_DEPTH : 0;
+    setDepthTest(depthMode());
+    drawInstances(variant, numInstances);
+    if (overdrawFrame())
+        drawOverdraw(numInstances);
+
+    if (mTransformMap) {
+        // Fence the frame just drawn, then make sure the GPU is done with
+        // the frame the next mapTransformBuf() hands out. That fence was
+        // set TRANSFORM_FRAMES-1 frames ago, so this rarely blocks.
+        if (mTransformFence[mTransformFrame])
+            glDeleteSync(mTransformFence[mTransformFrame]);
+        mTransformFence[mTransformFrame] =
+                glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        waitForTransformFrame((mTransformFrame + 1) % TRANSFORM_FRAMES);
+    }
+}
+
+const RendererES3::DrawProgram* RendererES3::drawProgram(unsigned int variant) {
+    DrawProgram& draw = mDraw[variant];
+    if (draw.program)
+        return &draw;
+    ShaderVariantKey key = defaultVariantKey(DRAW_SHADER);
+    key.features &= ~(mDrawFeatures[0] | mDrawFeatures[1]);
+    if (variant & DV_DEPTH)
+        key.features |= mDrawFeatures[0];
+    if (variant & DV_OVERDRAW)
+        key.features |= mDrawFeatures[1];
+    draw.program = mShared->program(DRAW_SHADER, key);
+    if (!draw.program)
+        return NULL;
+    draw.cameraLoc = glGetUniformLocation(draw.program, "camera");
+    draw.depthStepLoc = glGetUniformLocation(draw.program, "depthStep");
+    return &draw;
+}
+
+void RendererES3::setDepthTest(bool enabled) {
+    if (enabled == mDepthTest)
+        return;
+    if (enabled)
+        glEnable(GL_DEPTH_TEST);
+    else
+        glDisable(GL_DEPTH_TEST);
+    mDepthTest = enabled;
+}
+
+void RendererES3::drawInstances(unsigned int variant, unsigned int numInstances) {
+    const DrawProgram* draw = drawProgram(variant);
+    if (!draw)
+        return;
+    mGl.useProgram(draw->program);
+    glUniform3fv(draw->cameraLoc, 1, camera());
+    // Instances are in slots nearest first, see Renderer::drawOrder(); the
+    // shader spreads their ranks over the depth range.
+    if (variant & DV_DEPTH)
+        glUniform1f(draw->depthStepLoc, 2.0f / (numInstances ? numInstances : 1));
+    mGl.bindVertexArray(mVBState[mTransformFrame]);
     glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, numInstances);
 }
+
+// Draws the frame again into the counting target with additive blending,
+// so that each pixel ends up with the number of fragments shaded there,
+// and reads it back for onOverdrawPixels(). In depth mode the pass depth
+// tests too, so fragments the test rejects aren't counted, as early-Z
+// wouldn't shade them.
+void RendererES3::drawOverdraw(unsigned int numInstances) {
+    int w = surfaceWidth() / 4;
+    int h = surfaceHeight() / 4;
+    if (!ensureOverdrawTarget(w > 0 ? w : 1, h > 0 ? h : 1))
+        return;
+    mGl.bindFramebuffer(GL_FRAMEBUFFER, mOverdrawFbo);
+    glViewport(0, 0, mOverdrawWidth, mOverdrawHeight);
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_ONE, GL_ONE);
+    drawInstances(DV_OVERDRAW | (depthMode() ? DV_DEPTH : 0), numInstances);
+    glDisable(GL_BLEND);
+
+    if (!mReadback.requestPixels(0, 0, mOverdrawWidth, mOverdrawHeight,
+            onOverdrawPixels, this))
+        ALOGE("Could not read back overdraw counts");
+    static const GLenum OVERDRAW_DEPTH = GL_DEPTH_ATTACHMENT;
+    glInvalidateFramebuffer(GL_FRAMEBUFFER, 1, &OVERDRAW_DEPTH);
+
+    // Back to the frame, which endScene() finishes.
+    if (mSceneWidth) {
+        mGl.bindFramebuffer(GL_FRAMEBUFFER, mSceneFbo);
+        glViewport(0, 0, mSceneWidth, mSceneHeight);
+    } else {
+        mGl.bindFramebuffer(GL_FRAMEBUFFER, 0);
+        glViewport(0, 0, surfaceWidth(), surfaceHeight());
+    }
+}
+
+// ReadbackQueue callback for drawOverdraw(); user is the renderer. Red
+// saturates at 255 fragments per pixel.
+void RendererES3::onOverdrawPixels(const void* data, GLsizeiptr size, void* user) {
+    if (!data)
+        return;
+    const unsigned char* rgba = (const unsigned char*)data;
+    const GLsizeiptr pixels = size / 4;
+    uint64_t shaded = 0, covered = 0;
+    for (GLsizeiptr i = 0; i < pixels; i++) {
+        shaded += rgba[4*i];
+        covered += rgba[4*i] != 0;
+    }
+    ((RendererES3*)user)->setOverdrawCounts(shaded, covered, pixels);
+}
+
+bool RendererES3::dispatchKernel(unsigned int kernel, unsigned int groupsX,
+        unsigned int groupsY, unsigned int groupsZ) {
+    bool supported;
+    switch (kernel) {
+    case KERNEL_VELOCITY_TO_POSITION: supported = mCompute; break;
+    case KERNEL_BROAD_PHASE:          supported = mGpuBroadPhase; break;
+    default:                          supported = false; break;
+    }
+    if (!supported)
+        return false;
+    if (kernel == KERNEL_VELOCITY_TO_POSITION) {
+        // The kernel is one-dimensional over the compute buffers; groups
+        // past their end would only rewrite the same points.
+        const int localSize =
+                mComputeKey.constants[findShaderConstant(COMPUTE_SHADER, "LOCAL_SIZE")];
+        const unsigned int maxGroups = (COMPUTE_POINTS + localSize - 1) / localSize;
+        if ((uint64_t)groupsX * groupsY * groupsZ > maxGroups) {
+            RLOGW("Clamping kernel %u from %ux%ux%u to %u work groups",
+                    kernel, groupsX, groupsY, groupsZ, maxGroups);
+            groupsX = groupsX < maxGroups ? groupsX : maxGroups;
+            groupsY = groupsZ = 1;
+        }
+    }
+    if (!mScheduler.queue(kernel, groupsX, groupsY, groupsZ)) {
+        ALOGE("Too many dispatches in one frame, dropping kernel %u", kernel);
+        return false;
+    }
+    return true;
+}
+
+bool RendererES3::schedulerStats(DispatchStats* stats) const {
+    stats->dispatches = mScheduler.dispatches();
+    stats->batches = mScheduler.batches();
+    stats->checkedBatches = mScheduler.checkedBatches();
+    stats->overlappedBatches = mScheduler.overlapped();
+    stats->dropped = mScheduler.dropped();
+    return true;
+}
+
+unsigned int RendererES3::queueComputeJob(unsigned int kernel, const GLuint groups[3]) {
+    // Only the velocity kernel takes a baseGroup.
+    if (kernel != KERNEL_VELOCITY_TO_POSITION || !mCompute)
+        return 0;
+    unsigned int job = mJobs.submit(kernel, groups, NULL, NULL);
+    if (!job)
+        ALOGE("Too many compute jobs, dropping one of kernel %u", kernel);
+    return job;
+}
+
+bool RendererES3::findComputeJob(unsigned int job, ComputeJobProgress* progress) const {
+    return mJobs.progress(job, progress);
+}
+
+bool RendererES3::runGpuBatch(BatchFiles& files, int64_t* written) {
+    if (!mCompute)
+        return false;
+    // Slots only live for the batch; their pages stay with the arena.
+    BatchComputeGpu batch(mGl, mArena);
+    if (!batch.init(mShared, COMPUTE_SHADER, mComputeKey, 3, BATCH_CHUNK_POINTS))
+        return false;
+    *written = batch.run(files);
+    batch.destroy();
+    return true;
+}
+
+bool RendererES3::useComputeFormats(unsigned int velocity, unsigned int position) {
+    if (!mCompute)
+        return false;
+    ShaderVariantKey key;
+    ComputeStorage storage[CB_COUNT];
+    computeStorage(velocity, position, &key, storage);
+    GLuint program = mShared->program(COMPUTE_SHADER, key);
+    if (!program)
+        return false;
+    mComputeKey = key;
+    mDispatchProgram = program;
+    memcpy(mComputeStorage, storage, sizeof(mComputeStorage));
+    ALOGV("Compute storage: %s velocities, %s positions",
+            COMPUTE_FORMATS[velocity].name, COMPUTE_FORMATS[position].name);
+    return applyComputeStorage();
+}
+
+static uint64_t monotonicNs() {
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec*1000000000ull + now.tv_nsec;
+}
+
+// Runs the kernel FORMAT_COMPARISON_DISPATCHES times per format, with both
+// buffers in that format, on the velocities every format stores as well as
+// it can. The reference is the CPU kernel on the float velocities, which
+// RGBA32F matches exactly. Dispatches are timed with GpuTimer, or on the
+// CPU around a wait for them where timer queries aren't supported.
+bool RendererES3::runFormatComparison(ComputeFormatReport* report) {
+    if (!mCompute || !mComputeBuf[CB_POSITION].buffer || !mComputeBuf[CB_VELOCITY].buffer)
+        return false;
+    const unsigned int points = COMPUTE_POINTS;
+    float* velocities = (float*)malloc(3 * points * 4 * sizeof(float));
+    if (!velocities)
+        return false;
+    float* expected = velocities + points * 4;
+    float* results = expected + points * 4;
+    initComputeVelocities(velocities, points);
+    VelocityToPositionArgs args = {velocities, expected, points, false};
+    const uint32_t localSize = VELOCITY_TO_POSITION_KERNEL.localSize[0];
+    const uint32_t cpuGroups[3] = {(points + localSize - 1) / localSize, 1, 1};
+    if (!cpuDispatch(VELOCITY_TO_POSITION_KERNEL, cpuGroups, &args)) {
+        free(velocities);
+        return false;
+    }
+
+    GpuTimer timer;
+    const bool timed = timer.init();
+    const ShaderVariantKey savedKey = mComputeKey;
+    const GLuint savedProgram = mDispatchProgram;
+    ComputeStorage saved[CB_COUNT];
+    memcpy(saved, mComputeStorage, sizeof(saved));
+    const int debugIds = findShaderFeature(COMPUTE_SHADER, "DEBUG_IDS");
+    const int workgroupSize =
+            mComputeKey.constants[findShaderConstant(COMPUTE_SHADER, "LOCAL_SIZE")];
+    const GLuint groups = (points + workgroupSize - 1) / workgroupSize;
+
+    report->numPoints = points;
+    report->dispatches = FORMAT_COMPARISON_DISPATCHES;
+    for (int f = 0; f < COMPUTE_FORMAT_COUNT; f++) {
+        ComputeFormatReport::Row& row = report->rows[f];
+        row.maxAbsError = row.maxRelError = row.rmsError = INFINITY;
+        ShaderVariantKey key;
+        computeStorage(f, f, &key, mComputeStorage);
+        if (debugIds >= 0)
+            key.features &= ~(1u << debugIds);
+        GLuint program = mShared->program(COMPUTE_SHADER, key);
+        if (!program || !applyComputeStorage()) {
+            ALOGE("Compute format %s unavailable", COMPUTE_FORMATS[f].name);
+            continue;
+        }
+
+        useComputeProgram(program, NULL);
+        bindComputeImages();
+        // The first run pays for any lazy setup in the driver.
+        glDispatchCompute(groups, 1, 1);
+        GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull /* 1s */);
+        glDeleteSync(fence);
+
+        const uint64_t start = monotonicNs();
+        if (timed)
+            timer.begin();
+        for (int i = 0; i < FORMAT_COMPARISON_DISPATCHES; i++)
+            glDispatchCompute(groups, 1, 1);
+        if (timed)
+            timer.end();
+        GLbitfield barriers = GL_BUFFER_UPDATE_BARRIER_BIT;
+        if (mComputeBuf[CB_POSITION].map)
+            barriers |= GL_CLIENT_MAPPED_BUFFER_BARRIER_BIT_EXT;
+        glMemoryBarrier(barriers);
+        fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        GLenum status;
+        do {
+            status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT,
+                    100000000ull /* 100ms */);
+        } while (status == GL_TIMEOUT_EXPIRED);
+        glDeleteSync(fence);
+        uint64_t ns = monotonicNs() - start;
+        // The queries are done along with the dispatches; a measurement
+        // dropped for a disjoint event leaves the CPU time.
+        uint64_t gpuNs;
+        if (timed && timer.poll(&gpuNs))
+            ns = gpuNs;
+        row.gpuNs = ns / FORMAT_COMPARISON_DISPATCHES;
+        const double bytes = (double)points *
+                (COMPUTE_FORMATS[f].bytesPerPoint * 2);
+        row.gbPerSecond = row.gpuNs ? (float)(bytes / row.gpuNs) : 0.0f;
+
+        const void* stored = mapComputeBuf(CB_POSITION, GL_MAP_READ_BIT);
+        if (!stored) {
+            checkGlError("map position buffer range");
+            continue;
+        }
+        decodeComputePoints(stored, points, mComputeStorage[CB_POSITION], results);
+        unmapComputeBuf(CB_POSITION);
+        double sumSquares = 0.0;
+        row.maxAbsError = row.maxRelError = 0.0f;
+        for (unsigned int i = 0; i < points * 4; i++) {
+            const float error = fabsf(results[i] - expected[i]);
+            const float magnitude = fabsf(expected[i]);
+            const float rel = magnitude > 0.0f ? error / magnitude : error;
+            row.maxAbsError = error > row.maxAbsError ? error : row.maxAbsError;
+            row.maxRelError = rel > row.maxRelError ? rel : row.maxRelError;
+            sumSquares += (double)error * error;
+        }
+        row.rmsError = (float)sqrt(sumSquares / (points * 4));
+        ALOGV("Compute format %s: max error %g (%g relative), %.1f us per "
+                "dispatch, %.2f GB/s", COMPUTE_FORMATS[f].name,
+                row.maxAbsError, row.maxRelError, row.gpuNs / 1000.0,
+                row.gbPerSecond);
+    }
+
+    timer.destroy();
+    mComputeKey = savedKey;
+    mDispatchProgram = savedProgram;
+    memcpy(mComputeStorage, saved, sizeof(mComputeStorage));
+    applyComputeStorage();
+    free(velocities);
+    return true;
+}
+
+void RendererES3::issueDispatch(const FrameScheduler::Dispatch& dispatch) {
+    if (dispatch.kernel == KERNEL_BROAD_PHASE) {
+        dispatchBroadPhase();
+        return;
+    }
+    if (!mDispatchProgram)
+        return;
+    useComputeProgram(mDispatchProgram, dispatch.baseGroup);
+    bindComputeImages();
+    if (dispatch.job)
+        mJobs.beginSlice(dispatch.job, dispatch.groups);
+    glDispatchCompute(dispatch.groups[0], dispatch.groups[1], dispatch.groups[2]);
+    if (dispatch.job)
+        mJobs.endSlice();
+}
+
+void RendererES3::dispatchBroadPhase() {
+    // Dispatches are issued after step(), so the current transform frame
+    // holds this frame's transforms. The grid only needs the largest box,
+    // which the CPU knows without reading anything back.
+    const unsigned int count = frameInstances();
+    const float* bounds = frameBounds();
+    const BroadPhaseGrid grid = broadPhaseGrid(bounds, count);
+    BufferRange transforms = mVB[VB_SCALEROT];
+    transforms.offset += mTransformFrame * TRANSFORM_FRAME_FLOATS * sizeof(float);
+    transforms.size = TRANSFORM_FRAME_FLOATS * sizeof(float);
+    mBroadPhase.dispatch(mVB[VB_OFFSET], transforms, count, grid);
+
+    BroadPhaseReadback* readback =
+            (BroadPhaseReadback*)malloc(sizeof(BroadPhaseReadback));
+    if (!readback) {
+        ALOGE("Out of memory for broad phase readback");
+        return;
+    }
+    readback->renderer = this;
+    memcpy(readback->order, drawOrder(), count * sizeof(uint16_t));
+#if DEBUG
+    readback->count = count;
+    readback->grid = grid;
+    memcpy(readback->bounds, bounds, count * 4 * sizeof(float));
+#endif
+    const BufferRange& pairs = mBroadPhase.pairs();
+    if (!mReadback.request(pairs.buffer, pairs.offset, pairs.size,
+            onBroadPhasePairs, readback)) {
+        ALOGE("Could not read back broad phase pairs");
+        free(readback);
+    }
+}
+
+// ReadbackQueue callback for dispatchBroadPhase(); user is the
+// BroadPhaseReadback.
+void RendererES3::onBroadPhasePairs(const void* data, GLsizeiptr size, void* user) {
+    BroadPhaseReadback* readback = (BroadPhaseReadback*)user;
+    if (data) {
+        const uint32_t* words = (const uint32_t*)data;
+        const uint32_t count = words[0];
+        readback->renderer->setCollisionPairs(words + 2, count,
+                readback->order);
+        if (DEBUG)
+            readback->renderer->checkBroadPhase(*readback, words + 2, count);
+    }
+    free(readback);
+}
+
+#if DEBUG
+static int comparePairs(const void* a, const void* b) {
+    const uint32_t* p = (const uint32_t*)a;
+    const uint32_t* q = (const uint32_t*)b;
+    if (p[0] != q[0])
+        return p[0] < q[0] ? -1 : 1;
+    return p[1] < q[1] ? -1 : p[1] > q[1];
+}
+#endif
+
+void RendererES3::checkBroadPhase(const BroadPhaseReadback& readback,
+        const uint32_t* pairs, unsigned int count) {
+#if DEBUG
+    // Pairs come out in any order on both sides; compare them sorted.
+    const size_t pairsSize = MAX_COLLISION_PAIRS * 2 * sizeof(uint32_t);
+    uint32_t* gpu = (uint32_t*)malloc(pairsSize);
+    uint32_t* cpu = (uint32_t*)malloc(pairsSize);
+    BroadPhaseCpu reference;
+    unsigned int expected = 0;
+    if (!gpu || !cpu)
+        goto exit;
+    expected = reference.findPairs(readback.bounds, readback.count,
+            readback.grid, cpu, MAX_COLLISION_PAIRS);
+    if (expected != count) {
+        RLOGW("Broad phase: GPU found %u pairs, CPU %u", count, expected);
+        goto exit;
+    }
+    if (count > MAX_COLLISION_PAIRS)
+        goto exit;
+    memcpy(gpu, pairs, count * 2 * sizeof(uint32_t));
+    qsort(gpu, count, 2 * sizeof(uint32_t), comparePairs);
+    qsort(cpu, count, 2 * sizeof(uint32_t), comparePairs);
+    for (unsigned int i = 0; i < count; i++) {
+        if (gpu[2*i] != cpu[2*i] || gpu[2*i + 1] != cpu[2*i + 1]) {
+            RLOGW("Broad phase: GPU pair %u is (%u, %u), CPU (%u, %u)", i,
+                    gpu[2*i], gpu[2*i + 1], cpu[2*i], cpu[2*i + 1]);
+            break;
+        }
+    }
+
+exit:
+    free(gpu);
+    free(cpu);
+#endif
+}
@@ -0,0 +1,227 @@
+/*
+ * Copyright 2013 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gles3jni.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+// records per thread
+#define RING_SIZE 1024
+#define MAX_RINGS 16
+#define DRAIN_INTERVAL_MS 20
+
+struct Record {
+    const char* fmt;
+    int prio;
+    unsigned int numArgs;
+    RingLogArg args[RING_LOG_MAX_ARGS];
+};
+
+// Single producer (the owning thread), single consumer (whoever holds
+// sDrainLock). head and tail only ever grow; the slot is the index modulo
+// RING_SIZE. When the owning thread exits, its ring is handed to the next
+// thread that attaches; records it left behind are still drained.
+struct Ring {
+    uint32_t owned;
+    uint32_t head;
+    uint32_t tail;
+    uint32_t dropped;
+    Record records[RING_SIZE];
+};
+
+static __thread Ring* tRing;
+static Ring* sRings[MAX_RINGS];
+static unsigned int sNumRings;
+static pthread_mutex_t sAttachLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t sDrainLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t sInitOnce = PTHREAD_ONCE_INIT;
+static pthread_key_t sRingKey;
+static bool sHaveRingKey;
+
+// Formats one record like snprintf() would have. Integer arguments were
+// widened to 64 bits, so each integer conversion gets an ll length
+// modifier in place of its own.
+static void formatRecord(const Record& r, char* out, size_t size) {
+    size_t n = 0;
+    unsigned int arg = 0;
+    const char* p = r.fmt;
+    while (*p && n + 1 < size) {
+        if (*p != '%') {
+            out[n++] = *p++;
+            continue;
+        }
+        if (p[1] == '%') {
+            out[n++] = '%';
+            p += 2;
+            continue;
+        }
+        // Copy flags, width and precision; drop length modifiers.
+        char spec[32];
+        size_t s = 0;
+        spec[s++] = *p++;
+        while (*p && strchr("-+ #0123456789.*", *p) && s < sizeof(spec) - 4)
+            spec[s++] = *p++;
+        while (*p && strchr("hljztL", *p))
+            p++;
+        const char conv = *p ? *p++ : 's';
+        const bool integer = strchr("diouxXc", conv) != NULL;
+        if (integer && conv != 'c') {
+            spec[s++] = 'l';
+            spec[s++] = 'l';
+        }
+        spec[s++] = conv;
+        spec[s] = '\0';
+
+        int written;
+        if (arg >= r.numArgs) {
+            written = snprintf(out + n, size - n, "<?>");
+        } else if (integer) {
+            if (conv == 'c')
+                written = snprintf(out + n, size - n, spec, (int)r.args[arg].i);
+            else
+                written = snprintf(out + n, size - n, spec, (long long)r.args[arg].i);
+        } else if (strchr("fFeEgGaA", conv)) {
+            written = snprintf(out + n, size - n, spec, r.args[arg].d);
+        } else if (conv == 's') {
+            written = snprintf(out + n, size - n, spec,
+                    r.args[arg].p ? (const char*)r.args[arg].p : "(null)");
+        } else {
+            written = snprintf(out + n, size - n, spec, r.args[arg].p);
+        }
+        arg++;
+        if (written > 0)
+            n += (size_t)written < size - n ? (size_t)written : size - n - 1;
+    }
+    out[n] = '\0';
+}
+
+static void drainAll() {
+    char line[512];
+    pthread_mutex_lock(&sDrainLock);
+    unsigned int numRings = __atomic_load_n(&sNumRings, __ATOMIC_ACQUIRE);
+    for (unsigned int i = 0; i < numRings; i++) {
+        Ring* ring = sRings[i];
+        uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+        uint32_t tail = ring->tail;
+        for (; tail != head; tail++) {
+            const Record& r = ring->records[tail % RING_SIZE];
+            formatRecord(r, line, sizeof(line));
+            __android_log_write(r.prio, LOG_TAG, line);
+        }
+        __atomic_store_n(&ring->tail, tail, __ATOMIC_RELEASE);
+
+        uint32_t dropped = __atomic_exchange_n(&ring->dropped, 0, __ATOMIC_RELAXED);
+        if (dropped)
+            ALOGE("Ring log: dropped %u records", dropped);
+    }
+    pthread_mutex_unlock(&sDrainLock);
+}
+
+static void* drainer(void*) {
+    const struct timespec interval = {0, DRAIN_INTERVAL_MS * 1000000L};
+    for (;;) {
+        nanosleep(&interval, NULL);
+        drainAll();
+    }
+    return NULL;
+}
+
+// Runs on thread exit, for threads that attached a ring.
+static void releaseRing(void* p) {
+    Ring* ring = (Ring*)p;
+    tRing = NULL;
+    __atomic_store_n(&ring->owned, 0, __ATOMIC_RELEASE);
+}
+
+static void initRings() {
+    sHaveRingKey = pthread_key_create(&sRingKey, releaseRing) == 0;
+    if (!sHaveRingKey)
+        ALOGE("Ring log: could not create the thread key, rings will not be reused");
+
+    pthread_t thread;
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    if (pthread_create(&thread, &attr, drainer, NULL) != 0)
+        ALOGE("Ring log: could not start the drainer thread");
+    pthread_attr_destroy(&attr);
+}
+
+// Rings are never freed, but GLSurfaceView starts a new render thread
+// each time the view is attached, so a ring released by an exited thread
+// is reused before another is allocated.
+static Ring* attachRing() {
+    pthread_once(&sInitOnce, initRings);
+    Ring* ring = NULL;
+    pthread_mutex_lock(&sAttachLock);
+    for (unsigned int i = 0; i < sNumRings; i++) {
+        if (!__atomic_load_n(&sRings[i]->owned, __ATOMIC_ACQUIRE)) {
+            ring = sRings[i];
+            break;
+        }
+    }
+    if (!ring && sNumRings < MAX_RINGS) {
+        ring = (Ring*)calloc(1, sizeof(Ring));
+        if (ring) {
+            sRings[sNumRings] = ring;
+            __atomic_store_n(&sNumRings, sNumRings + 1, __ATOMIC_RELEASE);
+        }
+    }
+    if (ring)
+        ring->owned = 1;
+    pthread_mutex_unlock(&sAttachLock);
+    if (ring && sHaveRingKey)
+        pthread_setspecific(sRingKey, ring);
+    tRing = ring;
+    return ring;
+}
+
+void ringLogWrite(int prio, const char* fmt, const RingLogArg* args,
+        unsigned int numArgs) {
+    Ring* ring = tRing ? tRing : attachRing();
+    if (!ring) {
+        // Out of rings: format in place rather than lose the record.
+        Record r;
+        r.fmt = fmt;
+        r.prio = prio;
+        r.numArgs = numArgs;
+        memcpy(r.args, args, numArgs * sizeof(RingLogArg));
+        char line[512];
+        formatRecord(r, line, sizeof(line));
+        __android_log_write(prio, LOG_TAG, line);
+        return;
+    }
+
+    uint32_t head = ring->head;
+    if (head - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE) == RING_SIZE) {
+        __atomic_fetch_add(&ring->dropped, 1, __ATOMIC_RELAXED);
+        return;
+    }
+    Record& r = ring->records[head % RING_SIZE];
+    r.fmt = fmt;
+    r.prio = prio;
+    r.numArgs = numArgs;
+    memcpy(r.args, args, numArgs * sizeof(RingLogArg));
+    __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+}
+
+void ringLogFlush() {
+    drainAll();
+}
@@ -0,0 +1,88 @@
+/*
+ * Copyright 2013 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RINGLOG_H
+#define RINGLOG_H 1
+
+#include <android/log.h>
+#include <stdint.h>
+
+// ----------------------------------------------------------------------------
+// Logging for hot paths. RLOGV() and friends take printf-style arguments
+// like ALOGV(), but only store a record of the format string pointer and
+// the raw argument values in a ring owned by the calling thread: no
+// formatting, no locks and no system calls. A background thread drains
+// the rings every few milliseconds, formats the records and hands them to
+// the Android log. A full ring drops records rather than block; the drops
+// are counted and logged.
+//
+// Records below RING_LOG_MIN_LEVEL compile to nothing.
+//
+// Formats are printf conversions on integers, floating point values and
+// pointers. %s arguments are stored as pointers and only read when the
+// record is drained, so they must be string literals or other strings
+// that live forever. Cold paths can keep using ALOGV()/ALOGE().
+
+#ifndef RING_LOG_MIN_LEVEL
+#if DEBUG
+#define RING_LOG_MIN_LEVEL ANDROID_LOG_VERBOSE
+#else
+#define RING_LOG_MIN_LEVEL ANDROID_LOG_INFO
+#endif
+#endif
+
+#define RING_LOG_MAX_ARGS 8
+
+#define RLOG(prio, ...) \
+    do { \
+        if ((prio) >= RING_LOG_MIN_LEVEL) \
+            ringLog(prio, __VA_ARGS__); \
+    } while (0)
+#define RLOGV(...) RLOG(ANDROID_LOG_VERBOSE, __VA_ARGS__)
+#define RLOGD(...) RLOG(ANDROID_LOG_DEBUG, __VA_ARGS__)
+#define RLOGI(...) RLOG(ANDROID_LOG_INFO, __VA_ARGS__)
+#define RLOGW(...) RLOG(ANDROID_LOG_WARN, __VA_ARGS__)
+
+union RingLogArg {
+    int64_t i;
+    double d;
+    const void* p;
+};
+
+inline RingLogArg ringLogArg(int v)                { RingLogArg a; a.i = v; return a; }
+inline RingLogArg ringLogArg(unsigned int v)       { RingLogArg a; a.i = v; return a; }
+inline RingLogArg ringLogArg(long v)               { RingLogArg a; a.i = v; return a; }
+inline RingLogArg ringLogArg(unsigned long v)      { RingLogArg a; a.i = (int64_t)v; return a; }
+inline RingLogArg ringLogArg(long long v)          { RingLogArg a; a.i = v; return a; }
+inline RingLogArg ringLogArg(unsigned long long v) { RingLogArg a; a.i = (int64_t)v; return a; }
+inline RingLogArg ringLogArg(double v)             { RingLogArg a; a.d = v; return a; }
+inline RingLogArg ringLogArg(const void* v)        { RingLogArg a; a.p = v; return a; }
+
+extern void ringLogWrite(int prio, const char* fmt, const RingLogArg* args,
+        unsigned int numArgs);
+
+template <typename... Args>
+inline void ringLog(int prio, const char* fmt, Args... args) {
+    static_assert(sizeof...(args) <= RING_LOG_MAX_ARGS, "too many log arguments");
+    // The extra element keeps the array non-empty.
+    const RingLogArg packed[] = {ringLogArg(args)..., RingLogArg()};
+    ringLogWrite(prio, fmt, packed, sizeof...(args));
+}
+
+// Drains all rings now, e.g. before the process may go away.
+extern void ringLogFlush();
+
+#endif // RINGLOG_H
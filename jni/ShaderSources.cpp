@@ -0,0 +1,617 @@
+// Generated by tools/embed_shaders.py from jni/shaders. Do not edit.
+
+#include "ShaderSources.h"
+
+// draw.vert: 760 bytes, 425 minified
+static constexpr char DRAW_VERT_SRC[] = {
+    0x23, 0x76, 0x65, 0x72, 0x73, 0x69, 0x6f, 0x6e, 0x20, 0x33, 0x30, 0x30,
+    0x20, 0x65, 0x73, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x28, 0x6c,
+    0x6f, 0x63, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x3d, 0x30, 0x29, 0x69, 0x6e,
+    0x20, 0x76, 0x65, 0x63, 0x32, 0x20, 0x70, 0x6f, 0x73, 0x3b, 0x6c, 0x61,
+    0x79, 0x6f, 0x75, 0x74, 0x28, 0x6c, 0x6f, 0x63, 0x61, 0x74, 0x69, 0x6f,
+    0x6e, 0x3d, 0x31, 0x29, 0x69, 0x6e, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20,
+    0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x3b, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74,
+    0x28, 0x6c, 0x6f, 0x63, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x3d, 0x32, 0x29,
+    0x69, 0x6e, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x73, 0x63, 0x61, 0x6c,
+    0x65, 0x52, 0x6f, 0x74, 0x3b, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x28,
+    0x6c, 0x6f, 0x63, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x3d, 0x33, 0x29, 0x69,
+    0x6e, 0x20, 0x76, 0x65, 0x63, 0x32, 0x20, 0x6f, 0x66, 0x66, 0x73, 0x65,
+    0x74, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x76, 0x65,
+    0x63, 0x33, 0x20, 0x63, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x3b, 0x0a, 0x23,
+    0x69, 0x66, 0x20, 0x44, 0x45, 0x50, 0x54, 0x48, 0x0a, 0x75, 0x6e, 0x69,
+    0x66, 0x6f, 0x72, 0x6d, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x64,
+    0x65, 0x70, 0x74, 0x68, 0x53, 0x74, 0x65, 0x70, 0x3b, 0x0a, 0x23, 0x65,
+    0x6e, 0x64, 0x69, 0x66, 0x0a, 0x6f, 0x75, 0x74, 0x20, 0x76, 0x65, 0x63,
+    0x34, 0x20, 0x76, 0x43, 0x6f, 0x6c, 0x6f, 0x72, 0x3b, 0x76, 0x6f, 0x69,
+    0x64, 0x20, 0x6d, 0x61, 0x69, 0x6e, 0x28, 0x29, 0x7b, 0x6d, 0x61, 0x74,
+    0x32, 0x20, 0x73, 0x72, 0x3d, 0x6d, 0x61, 0x74, 0x32, 0x28, 0x73, 0x63,
+    0x61, 0x6c, 0x65, 0x52, 0x6f, 0x74, 0x2e, 0x78, 0x79, 0x2c, 0x73, 0x63,
+    0x61, 0x6c, 0x65, 0x52, 0x6f, 0x74, 0x2e, 0x7a, 0x77, 0x29, 0x3b, 0x67,
+    0x6c, 0x5f, 0x50, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x3d, 0x76,
+    0x65, 0x63, 0x34, 0x28, 0x28, 0x73, 0x72, 0x2a, 0x70, 0x6f, 0x73, 0x2b,
+    0x6f, 0x66, 0x66, 0x73, 0x65, 0x74, 0x2d, 0x63, 0x61, 0x6d, 0x65, 0x72,
+    0x61, 0x2e, 0x78, 0x79, 0x29, 0x2a, 0x63, 0x61, 0x6d, 0x65, 0x72, 0x61,
+    0x2e, 0x7a, 0x2c, 0x30, 0x2e, 0x30, 0x2c, 0x31, 0x2e, 0x30, 0x29, 0x3b,
+    0x0a, 0x23, 0x69, 0x66, 0x20, 0x44, 0x45, 0x50, 0x54, 0x48, 0x0a, 0x67,
+    0x6c, 0x5f, 0x50, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2e, 0x7a,
+    0x3d, 0x28, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x28, 0x67, 0x6c, 0x5f, 0x49,
+    0x6e, 0x73, 0x74, 0x61, 0x6e, 0x63, 0x65, 0x49, 0x44, 0x29, 0x2b, 0x30,
+    0x2e, 0x35, 0x29, 0x2a, 0x64, 0x65, 0x70, 0x74, 0x68, 0x53, 0x74, 0x65,
+    0x70, 0x2d, 0x31, 0x2e, 0x30, 0x3b, 0x0a, 0x23, 0x65, 0x6e, 0x64, 0x69,
+    0x66, 0x0a, 0x76, 0x43, 0x6f, 0x6c, 0x6f, 0x72, 0x3d, 0x63, 0x6f, 0x6c,
+    0x6f, 0x72, 0x3b, 0x7d, 0x0a, 0x00,
+};
+
+// draw.frag: 334 bytes, 157 minified
+static constexpr char DRAW_FRAG_SRC[] = {
+    0x23, 0x76, 0x65, 0x72, 0x73, 0x69, 0x6f, 0x6e, 0x20, 0x33, 0x30, 0x30,
+    0x20, 0x65, 0x73, 0x0a, 0x70, 0x72, 0x65, 0x63, 0x69, 0x73, 0x69, 0x6f,
+    0x6e, 0x20, 0x6d, 0x65, 0x64, 0x69, 0x75, 0x6d, 0x70, 0x20, 0x66, 0x6c,
+    0x6f, 0x61, 0x74, 0x3b, 0x69, 0x6e, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20,
+    0x76, 0x43, 0x6f, 0x6c, 0x6f, 0x72, 0x3b, 0x6f, 0x75, 0x74, 0x20, 0x76,
+    0x65, 0x63, 0x34, 0x20, 0x6f, 0x75, 0x74, 0x43, 0x6f, 0x6c, 0x6f, 0x72,
+    0x3b, 0x76, 0x6f, 0x69, 0x64, 0x20, 0x6d, 0x61, 0x69, 0x6e, 0x28, 0x29,
+    0x7b, 0x0a, 0x23, 0x69, 0x66, 0x20, 0x4f, 0x56, 0x45, 0x52, 0x44, 0x52,
+    0x41, 0x57, 0x0a, 0x6f, 0x75, 0x74, 0x43, 0x6f, 0x6c, 0x6f, 0x72, 0x3d,
+    0x76, 0x65, 0x63, 0x34, 0x28, 0x31, 0x2e, 0x30, 0x2f, 0x32, 0x35, 0x35,
+    0x2e, 0x30, 0x29, 0x3b, 0x0a, 0x23, 0x65, 0x6c, 0x73, 0x65, 0x0a, 0x6f,
+    0x75, 0x74, 0x43, 0x6f, 0x6c, 0x6f, 0x72, 0x3d, 0x76, 0x43, 0x6f, 0x6c,
+    0x6f, 0x72, 0x3b, 0x0a, 0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 0x7d,
+    0x0a, 0x00,
+};
+
+static const char* const DRAW_FEATURES[] = {"DEPTH", "OVERDRAW"};
+
+const ShaderDesc DRAW_SHADER = {
+    "draw", DRAW_VERT_SRC, DRAW_FRAG_SRC, NULL,
+    DRAW_FEATURES, 2, 0x0,
+    NULL, 0,
+    0xcc85151545a0baf0ull,
+};
+
+// compute.comp: 3106 bytes, 2255 minified
+static constexpr char COMPUTE_COMP_SRC[] = {
+    0x23, 0x76, 0x65, 0x72, 0x73, 0x69, 0x6f, 0x6e, 0x20, 0x33, 0x31, 0x30,
+    0x20, 0x65, 0x73, 0x0a, 0x23, 0x65, 0x78, 0x74, 0x65, 0x6e, 0x73, 0x69,
+    0x6f, 0x6e, 0x20, 0x47, 0x4c, 0x5f, 0x41, 0x4e, 0x44, 0x52, 0x4f, 0x49,
+    0x44, 0x5f, 0x65, 0x78, 0x74, 0x65, 0x6e, 0x73, 0x69, 0x6f, 0x6e, 0x5f,
+    0x70, 0x61, 0x63, 0x6b, 0x5f, 0x65, 0x73, 0x33, 0x31, 0x61, 0x20, 0x3a,
+    0x20, 0x72, 0x65, 0x71, 0x75, 0x69, 0x72, 0x65, 0x0a, 0x23, 0x64, 0x65,
+    0x66, 0x69, 0x6e, 0x65, 0x20, 0x46, 0x4f, 0x52, 0x4d, 0x41, 0x54, 0x5f,
+    0x52, 0x47, 0x42, 0x41, 0x33, 0x32, 0x46, 0x20, 0x30, 0x0a, 0x23, 0x64,
+    0x65, 0x66, 0x69, 0x6e, 0x65, 0x20, 0x46, 0x4f, 0x52, 0x4d, 0x41, 0x54,
+    0x5f, 0x52, 0x47, 0x42, 0x41, 0x31, 0x36, 0x46, 0x20, 0x31, 0x0a, 0x23,
+    0x64, 0x65, 0x66, 0x69, 0x6e, 0x65, 0x20, 0x46, 0x4f, 0x52, 0x4d, 0x41,
+    0x54, 0x5f, 0x48, 0x41, 0x4c, 0x46, 0x5f, 0x52, 0x33, 0x32, 0x55, 0x49,
+    0x20, 0x32, 0x0a, 0x23, 0x64, 0x65, 0x66, 0x69, 0x6e, 0x65, 0x20, 0x46,
+    0x4f, 0x52, 0x4d, 0x41, 0x54, 0x5f, 0x46, 0x49, 0x58, 0x45, 0x44, 0x31,
+    0x36, 0x20, 0x33, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x28, 0x6c,
+    0x6f, 0x63, 0x61, 0x6c, 0x5f, 0x73, 0x69, 0x7a, 0x65, 0x5f, 0x78, 0x3d,
+    0x4c, 0x4f, 0x43, 0x41, 0x4c, 0x5f, 0x53, 0x49, 0x5a, 0x45, 0x29, 0x69,
+    0x6e, 0x3b, 0x0a, 0x23, 0x69, 0x66, 0x20, 0x56, 0x45, 0x4c, 0x4f, 0x43,
+    0x49, 0x54, 0x59, 0x5f, 0x46, 0x4f, 0x52, 0x4d, 0x41, 0x54, 0x20, 0x3d,
+    0x3d, 0x20, 0x46, 0x4f, 0x52, 0x4d, 0x41, 0x54, 0x5f, 0x52, 0x47, 0x42,
+    0x41, 0x31, 0x36, 0x46, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x28,
+    0x62, 0x69, 0x6e, 0x64, 0x69, 0x6e, 0x67, 0x3d, 0x30, 0x2c, 0x72, 0x67,
+    0x62, 0x61, 0x31, 0x36, 0x66, 0x29, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72,
+    0x6d, 0x20, 0x6d, 0x65, 0x64, 0x69, 0x75, 0x6d, 0x70, 0x20, 0x72, 0x65,
+    0x61, 0x64, 0x6f, 0x6e, 0x6c, 0x79, 0x20, 0x69, 0x6d, 0x61, 0x67, 0x65,
+    0x42, 0x75, 0x66, 0x66, 0x65, 0x72, 0x20, 0x76, 0x65, 0x6c, 0x6f, 0x63,
+    0x69, 0x74, 0x79, 0x5f, 0x62, 0x75, 0x66, 0x66, 0x65, 0x72, 0x3b, 0x0a,
+    0x23, 0x65, 0x6c, 0x69, 0x66, 0x20, 0x56, 0x45, 0x4c, 0x4f, 0x43, 0x49,
+    0x54, 0x59, 0x5f, 0x46, 0x4f, 0x52, 0x4d, 0x41, 0x54, 0x20, 0x3d, 0x3d,
+    0x20, 0x46, 0x4f, 0x52, 0x4d, 0x41, 0x54, 0x5f, 0x48, 0x41, 0x4c, 0x46,
+    0x5f, 0x52, 0x33, 0x32, 0x55, 0x49, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75,
+    0x74, 0x28, 0x62, 0x69, 0x6e, 0x64, 0x69, 0x6e, 0x67, 0x3d, 0x30, 0x2c,
+    0x72, 0x33, 0x32, 0x75, 0x69, 0x29, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72,
+    0x6d, 0x20, 0x68, 0x69, 0x67, 0x68, 0x70, 0x20, 0x72, 0x65, 0x61, 0x64,
+    0x6f, 0x6e, 0x6c, 0x79, 0x20, 0x75, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x42,
+    0x75, 0x66, 0x66, 0x65, 0x72, 0x20, 0x76, 0x65, 0x6c, 0x6f, 0x63, 0x69,
+    0x74, 0x79, 0x5f, 0x62, 0x75, 0x66, 0x66, 0x65, 0x72, 0x3b, 0x0a, 0x23,
+    0x65, 0x6c, 0x69, 0x66, 0x20, 0x56, 0x45, 0x4c, 0x4f, 0x43, 0x49, 0x54,
+    0x59, 0x5f, 0x46, 0x4f, 0x52, 0x4d, 0x41, 0x54, 0x20, 0x3d, 0x3d, 0x20,
+    0x46, 0x4f, 0x52, 0x4d, 0x41, 0x54, 0x5f, 0x46, 0x49, 0x58, 0x45, 0x44,
+    0x31, 0x36, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x28, 0x62, 0x69,
+    0x6e, 0x64, 0x69, 0x6e, 0x67, 0x3d, 0x30, 0x2c, 0x72, 0x67, 0x62, 0x61,
+    0x31, 0x36, 0x69, 0x29, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20,
+    0x68, 0x69, 0x67, 0x68, 0x70, 0x20, 0x72, 0x65, 0x61, 0x64, 0x6f, 0x6e,
+    0x6c, 0x79, 0x20, 0x69, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x42, 0x75, 0x66,
+    0x66, 0x65, 0x72, 0x20, 0x76, 0x65, 0x6c, 0x6f, 0x63, 0x69, 0x74, 0x79,
+    0x5f, 0x62, 0x75, 0x66, 0x66, 0x65, 0x72, 0x3b, 0x0a, 0x23, 0x65, 0x6c,
+    0x73, 0x65, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x28, 0x62, 0x69,
+    0x6e, 0x64, 0x69, 0x6e, 0x67, 0x3d, 0x30, 0x2c, 0x72, 0x67, 0x62, 0x61,
+    0x33, 0x32, 0x66, 0x29, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20,
+    0x6d, 0x65, 0x64, 0x69, 0x75, 0x6d, 0x70, 0x20, 0x72, 0x65, 0x61, 0x64,
+    0x6f, 0x6e, 0x6c, 0x79, 0x20, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x42, 0x75,
+    0x66, 0x66, 0x65, 0x72, 0x20, 0x76, 0x65, 0x6c, 0x6f, 0x63, 0x69, 0x74,
+    0x79, 0x5f, 0x62, 0x75, 0x66, 0x66, 0x65, 0x72, 0x3b, 0x0a, 0x23, 0x65,
+    0x6e, 0x64, 0x69, 0x66, 0x0a, 0x23, 0x69, 0x66, 0x20, 0x50, 0x4f, 0x53,
+    0x49, 0x54, 0x49, 0x4f, 0x4e, 0x5f, 0x46, 0x4f, 0x52, 0x4d, 0x41, 0x54,
+    0x20, 0x3d, 0x3d, 0x20, 0x46, 0x4f, 0x52, 0x4d, 0x41, 0x54, 0x5f, 0x52,
+    0x47, 0x42, 0x41, 0x31, 0x36, 0x46, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75,
+    0x74, 0x28, 0x62, 0x69, 0x6e, 0x64, 0x69, 0x6e, 0x67, 0x3d, 0x31, 0x2c,
+    0x72, 0x67, 0x62, 0x61, 0x31, 0x36, 0x66, 0x29, 0x75, 0x6e, 0x69, 0x66,
+    0x6f, 0x72, 0x6d, 0x20, 0x6d, 0x65, 0x64, 0x69, 0x75, 0x6d, 0x70, 0x20,
+    0x77, 0x72, 0x69, 0x74, 0x65, 0x6f, 0x6e, 0x6c, 0x79, 0x20, 0x69, 0x6d,
+    0x61, 0x67, 0x65, 0x42, 0x75, 0x66, 0x66, 0x65, 0x72, 0x20, 0x70, 0x6f,
+    0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x5f, 0x62, 0x75, 0x66, 0x66, 0x65,
+    0x72, 0x3b, 0x0a, 0x23, 0x65, 0x6c, 0x69, 0x66, 0x20, 0x50, 0x4f, 0x53,
+    0x49, 0x54, 0x49, 0x4f, 0x4e, 0x5f, 0x46, 0x4f, 0x52, 0x4d, 0x41, 0x54,
+    0x20, 0x3d, 0x3d, 0x20, 0x46, 0x4f, 0x52, 0x4d, 0x41, 0x54, 0x5f, 0x48,
+    0x41, 0x4c, 0x46, 0x5f, 0x52, 0x33, 0x32, 0x55, 0x49, 0x0a, 0x6c, 0x61,
+    0x79, 0x6f, 0x75, 0x74, 0x28, 0x62, 0x69, 0x6e, 0x64, 0x69, 0x6e, 0x67,
+    0x3d, 0x31, 0x2c, 0x72, 0x33, 0x32, 0x75, 0x69, 0x29, 0x75, 0x6e, 0x69,
+    0x66, 0x6f, 0x72, 0x6d, 0x20, 0x68, 0x69, 0x67, 0x68, 0x70, 0x20, 0x77,
+    0x72, 0x69, 0x74, 0x65, 0x6f, 0x6e, 0x6c, 0x79, 0x20, 0x75, 0x69, 0x6d,
+    0x61, 0x67, 0x65, 0x42, 0x75, 0x66, 0x66, 0x65, 0x72, 0x20, 0x70, 0x6f,
+    0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x5f, 0x62, 0x75, 0x66, 0x66, 0x65,
+    0x72, 0x3b, 0x0a, 0x23, 0x65, 0x6c, 0x69, 0x66, 0x20, 0x50, 0x4f, 0x53,
+    0x49, 0x54, 0x49, 0x4f, 0x4e, 0x5f, 0x46, 0x4f, 0x52, 0x4d, 0x41, 0x54,
+    0x20, 0x3d, 0x3d, 0x20, 0x46, 0x4f, 0x52, 0x4d, 0x41, 0x54, 0x5f, 0x46,
+    0x49, 0x58, 0x45, 0x44, 0x31, 0x36, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75,
+    0x74, 0x28, 0x62, 0x69, 0x6e, 0x64, 0x69, 0x6e, 0x67, 0x3d, 0x31, 0x2c,
+    0x72, 0x67, 0x62, 0x61, 0x31, 0x36, 0x69, 0x29, 0x75, 0x6e, 0x69, 0x66,
+    0x6f, 0x72, 0x6d, 0x20, 0x68, 0x69, 0x67, 0x68, 0x70, 0x20, 0x77, 0x72,
+    0x69, 0x74, 0x65, 0x6f, 0x6e, 0x6c, 0x79, 0x20, 0x69, 0x69, 0x6d, 0x61,
+    0x67, 0x65, 0x42, 0x75, 0x66, 0x66, 0x65, 0x72, 0x20, 0x70, 0x6f, 0x73,
+    0x69, 0x74, 0x69, 0x6f, 0x6e, 0x5f, 0x62, 0x75, 0x66, 0x66, 0x65, 0x72,
+    0x3b, 0x0a, 0x23, 0x65, 0x6c, 0x73, 0x65, 0x0a, 0x6c, 0x61, 0x79, 0x6f,
+    0x75, 0x74, 0x28, 0x62, 0x69, 0x6e, 0x64, 0x69, 0x6e, 0x67, 0x3d, 0x31,
+    0x2c, 0x72, 0x67, 0x62, 0x61, 0x33, 0x32, 0x66, 0x29, 0x75, 0x6e, 0x69,
+    0x66, 0x6f, 0x72, 0x6d, 0x20, 0x6d, 0x65, 0x64, 0x69, 0x75, 0x6d, 0x70,
+    0x20, 0x77, 0x72, 0x69, 0x74, 0x65, 0x6f, 0x6e, 0x6c, 0x79, 0x20, 0x69,
+    0x6d, 0x61, 0x67, 0x65, 0x42, 0x75, 0x66, 0x66, 0x65, 0x72, 0x20, 0x70,
+    0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x5f, 0x62, 0x75, 0x66, 0x66,
+    0x65, 0x72, 0x3b, 0x0a, 0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 0x75,
+    0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x68, 0x69, 0x67, 0x68, 0x70,
+    0x20, 0x75, 0x76, 0x65, 0x63, 0x33, 0x20, 0x62, 0x61, 0x73, 0x65, 0x47,
+    0x72, 0x6f, 0x75, 0x70, 0x3b, 0x68, 0x69, 0x67, 0x68, 0x70, 0x20, 0x76,
+    0x65, 0x63, 0x34, 0x20, 0x6c, 0x6f, 0x61, 0x64, 0x56, 0x65, 0x6c, 0x6f,
+    0x63, 0x69, 0x74, 0x79, 0x28, 0x69, 0x6e, 0x74, 0x20, 0x69, 0x29, 0x7b,
+    0x0a, 0x23, 0x69, 0x66, 0x20, 0x56, 0x45, 0x4c, 0x4f, 0x43, 0x49, 0x54,
+    0x59, 0x5f, 0x46, 0x4f, 0x52, 0x4d, 0x41, 0x54, 0x20, 0x3d, 0x3d, 0x20,
+    0x46, 0x4f, 0x52, 0x4d, 0x41, 0x54, 0x5f, 0x48, 0x41, 0x4c, 0x46, 0x5f,
+    0x52, 0x33, 0x32, 0x55, 0x49, 0x0a, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e,
+    0x20, 0x76, 0x65, 0x63, 0x34, 0x28, 0x75, 0x6e, 0x70, 0x61, 0x63, 0x6b,
+    0x48, 0x61, 0x6c, 0x66, 0x32, 0x78, 0x31, 0x36, 0x28, 0x69, 0x6d, 0x61,
+    0x67, 0x65, 0x4c, 0x6f, 0x61, 0x64, 0x28, 0x76, 0x65, 0x6c, 0x6f, 0x63,
+    0x69, 0x74, 0x79, 0x5f, 0x62, 0x75, 0x66, 0x66, 0x65, 0x72, 0x2c, 0x32,
+    0x2a, 0x69, 0x29, 0x2e, 0x78, 0x29, 0x2c, 0x75, 0x6e, 0x70, 0x61, 0x63,
+    0x6b, 0x48, 0x61, 0x6c, 0x66, 0x32, 0x78, 0x31, 0x36, 0x28, 0x69, 0x6d,
+    0x61, 0x67, 0x65, 0x4c, 0x6f, 0x61, 0x64, 0x28, 0x76, 0x65, 0x6c, 0x6f,
+    0x63, 0x69, 0x74, 0x79, 0x5f, 0x62, 0x75, 0x66, 0x66, 0x65, 0x72, 0x2c,
+    0x32, 0x2a, 0x69, 0x2b, 0x31, 0x29, 0x2e, 0x78, 0x29, 0x29, 0x3b, 0x0a,
+    0x23, 0x65, 0x6c, 0x69, 0x66, 0x20, 0x56, 0x45, 0x4c, 0x4f, 0x43, 0x49,
+    0x54, 0x59, 0x5f, 0x46, 0x4f, 0x52, 0x4d, 0x41, 0x54, 0x20, 0x3d, 0x3d,
+    0x20, 0x46, 0x4f, 0x52, 0x4d, 0x41, 0x54, 0x5f, 0x46, 0x49, 0x58, 0x45,
+    0x44, 0x31, 0x36, 0x0a, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x76,
+    0x65, 0x63, 0x34, 0x28, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x4c, 0x6f, 0x61,
+    0x64, 0x28, 0x76, 0x65, 0x6c, 0x6f, 0x63, 0x69, 0x74, 0x79, 0x5f, 0x62,
+    0x75, 0x66, 0x66, 0x65, 0x72, 0x2c, 0x69, 0x29, 0x29, 0x2a, 0x65, 0x78,
+    0x70, 0x32, 0x28, 0x2d, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x28, 0x56, 0x45,
+    0x4c, 0x4f, 0x43, 0x49, 0x54, 0x59, 0x5f, 0x46, 0x52, 0x41, 0x43, 0x5f,
+    0x42, 0x49, 0x54, 0x53, 0x29, 0x29, 0x3b, 0x0a, 0x23, 0x65, 0x6c, 0x73,
+    0x65, 0x0a, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x69, 0x6d, 0x61,
+    0x67, 0x65, 0x4c, 0x6f, 0x61, 0x64, 0x28, 0x76, 0x65, 0x6c, 0x6f, 0x63,
+    0x69, 0x74, 0x79, 0x5f, 0x62, 0x75, 0x66, 0x66, 0x65, 0x72, 0x2c, 0x69,
+    0x29, 0x3b, 0x0a, 0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 0x7d, 0x76,
+    0x6f, 0x69, 0x64, 0x20, 0x73, 0x74, 0x6f, 0x72, 0x65, 0x50, 0x6f, 0x73,
+    0x69, 0x74, 0x69, 0x6f, 0x6e, 0x28, 0x69, 0x6e, 0x74, 0x20, 0x69, 0x2c,
+    0x68, 0x69, 0x67, 0x68, 0x70, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x76,
+    0x61, 0x6c, 0x75, 0x65, 0x29, 0x7b, 0x0a, 0x23, 0x69, 0x66, 0x20, 0x50,
+    0x4f, 0x53, 0x49, 0x54, 0x49, 0x4f, 0x4e, 0x5f, 0x46, 0x4f, 0x52, 0x4d,
+    0x41, 0x54, 0x20, 0x3d, 0x3d, 0x20, 0x46, 0x4f, 0x52, 0x4d, 0x41, 0x54,
+    0x5f, 0x48, 0x41, 0x4c, 0x46, 0x5f, 0x52, 0x33, 0x32, 0x55, 0x49, 0x0a,
+    0x69, 0x6d, 0x61, 0x67, 0x65, 0x53, 0x74, 0x6f, 0x72, 0x65, 0x28, 0x70,
+    0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x5f, 0x62, 0x75, 0x66, 0x66,
+    0x65, 0x72, 0x2c, 0x32, 0x2a, 0x69, 0x2c, 0x75, 0x76, 0x65, 0x63, 0x34,
+    0x28, 0x70, 0x61, 0x63, 0x6b, 0x48, 0x61, 0x6c, 0x66, 0x32, 0x78, 0x31,
+    0x36, 0x28, 0x76, 0x61, 0x6c, 0x75, 0x65, 0x2e, 0x78, 0x79, 0x29, 0x29,
+    0x29, 0x3b, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x53, 0x74, 0x6f, 0x72, 0x65,
+    0x28, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x5f, 0x62, 0x75,
+    0x66, 0x66, 0x65, 0x72, 0x2c, 0x32, 0x2a, 0x69, 0x2b, 0x31, 0x2c, 0x75,
+    0x76, 0x65, 0x63, 0x34, 0x28, 0x70, 0x61, 0x63, 0x6b, 0x48, 0x61, 0x6c,
+    0x66, 0x32, 0x78, 0x31, 0x36, 0x28, 0x76, 0x61, 0x6c, 0x75, 0x65, 0x2e,
+    0x7a, 0x77, 0x29, 0x29, 0x29, 0x3b, 0x0a, 0x23, 0x65, 0x6c, 0x69, 0x66,
+    0x20, 0x50, 0x4f, 0x53, 0x49, 0x54, 0x49, 0x4f, 0x4e, 0x5f, 0x46, 0x4f,
+    0x52, 0x4d, 0x41, 0x54, 0x20, 0x3d, 0x3d, 0x20, 0x46, 0x4f, 0x52, 0x4d,
+    0x41, 0x54, 0x5f, 0x46, 0x49, 0x58, 0x45, 0x44, 0x31, 0x36, 0x0a, 0x68,
+    0x69, 0x67, 0x68, 0x70, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x73, 0x63,
+    0x61, 0x6c, 0x65, 0x64, 0x3d, 0x63, 0x6c, 0x61, 0x6d, 0x70, 0x28, 0x76,
+    0x61, 0x6c, 0x75, 0x65, 0x2a, 0x65, 0x78, 0x70, 0x32, 0x28, 0x66, 0x6c,
+    0x6f, 0x61, 0x74, 0x28, 0x50, 0x4f, 0x53, 0x49, 0x54, 0x49, 0x4f, 0x4e,
+    0x5f, 0x46, 0x52, 0x41, 0x43, 0x5f, 0x42, 0x49, 0x54, 0x53, 0x29, 0x29,
+    0x2c, 0x2d, 0x33, 0x32, 0x37, 0x36, 0x37, 0x2e, 0x30, 0x2c, 0x33, 0x32,
+    0x37, 0x36, 0x37, 0x2e, 0x30, 0x29, 0x3b, 0x69, 0x6d, 0x61, 0x67, 0x65,
+    0x53, 0x74, 0x6f, 0x72, 0x65, 0x28, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69,
+    0x6f, 0x6e, 0x5f, 0x62, 0x75, 0x66, 0x66, 0x65, 0x72, 0x2c, 0x69, 0x2c,
+    0x69, 0x76, 0x65, 0x63, 0x34, 0x28, 0x72, 0x6f, 0x75, 0x6e, 0x64, 0x28,
+    0x73, 0x63, 0x61, 0x6c, 0x65, 0x64, 0x29, 0x29, 0x29, 0x3b, 0x0a, 0x23,
+    0x65, 0x6c, 0x73, 0x65, 0x0a, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x53, 0x74,
+    0x6f, 0x72, 0x65, 0x28, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e,
+    0x5f, 0x62, 0x75, 0x66, 0x66, 0x65, 0x72, 0x2c, 0x69, 0x2c, 0x76, 0x61,
+    0x6c, 0x75, 0x65, 0x29, 0x3b, 0x0a, 0x23, 0x65, 0x6e, 0x64, 0x69, 0x66,
+    0x0a, 0x7d, 0x76, 0x6f, 0x69, 0x64, 0x20, 0x6d, 0x61, 0x69, 0x6e, 0x28,
+    0x29, 0x7b, 0x68, 0x69, 0x67, 0x68, 0x70, 0x20, 0x75, 0x76, 0x65, 0x63,
+    0x33, 0x20, 0x67, 0x72, 0x6f, 0x75, 0x70, 0x3d, 0x67, 0x6c, 0x5f, 0x57,
+    0x6f, 0x72, 0x6b, 0x47, 0x72, 0x6f, 0x75, 0x70, 0x49, 0x44, 0x2b, 0x62,
+    0x61, 0x73, 0x65, 0x47, 0x72, 0x6f, 0x75, 0x70, 0x3b, 0x69, 0x6e, 0x74,
+    0x20, 0x69, 0x6e, 0x64, 0x65, 0x78, 0x3d, 0x69, 0x6e, 0x74, 0x28, 0x67,
+    0x72, 0x6f, 0x75, 0x70, 0x2e, 0x78, 0x2a, 0x67, 0x6c, 0x5f, 0x57, 0x6f,
+    0x72, 0x6b, 0x47, 0x72, 0x6f, 0x75, 0x70, 0x53, 0x69, 0x7a, 0x65, 0x2e,
+    0x78, 0x2b, 0x67, 0x6c, 0x5f, 0x4c, 0x6f, 0x63, 0x61, 0x6c, 0x49, 0x6e,
+    0x76, 0x6f, 0x63, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x49, 0x44, 0x2e, 0x78,
+    0x29, 0x3b, 0x0a, 0x23, 0x69, 0x66, 0x20, 0x44, 0x45, 0x42, 0x55, 0x47,
+    0x5f, 0x49, 0x44, 0x53, 0x0a, 0x76, 0x65, 0x63, 0x34, 0x20, 0x72, 0x65,
+    0x73, 0x75, 0x6c, 0x74, 0x3d, 0x76, 0x65, 0x63, 0x34, 0x28, 0x67, 0x6c,
+    0x5f, 0x4c, 0x6f, 0x63, 0x61, 0x6c, 0x49, 0x6e, 0x76, 0x6f, 0x63, 0x61,
+    0x74, 0x69, 0x6f, 0x6e, 0x49, 0x44, 0x2e, 0x78, 0x2c, 0x67, 0x72, 0x6f,
+    0x75, 0x70, 0x2e, 0x78, 0x2c, 0x67, 0x6c, 0x5f, 0x4c, 0x6f, 0x63, 0x61,
+    0x6c, 0x49, 0x6e, 0x76, 0x6f, 0x63, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x49,
+    0x44, 0x2e, 0x79, 0x2c, 0x67, 0x72, 0x6f, 0x75, 0x70, 0x2e, 0x79, 0x29,
+    0x3b, 0x0a, 0x23, 0x65, 0x6c, 0x73, 0x65, 0x0a, 0x76, 0x65, 0x63, 0x34,
+    0x20, 0x76, 0x65, 0x6c, 0x3d, 0x6c, 0x6f, 0x61, 0x64, 0x56, 0x65, 0x6c,
+    0x6f, 0x63, 0x69, 0x74, 0x79, 0x28, 0x69, 0x6e, 0x64, 0x65, 0x78, 0x29,
+    0x3b, 0x76, 0x65, 0x63, 0x34, 0x20, 0x72, 0x65, 0x73, 0x75, 0x6c, 0x74,
+    0x3d, 0x76, 0x65, 0x6c, 0x2b, 0x76, 0x65, 0x63, 0x34, 0x28, 0x30, 0x2e,
+    0x30, 0x66, 0x2c, 0x30, 0x2e, 0x30, 0x66, 0x2c, 0x32, 0x35, 0x2e, 0x30,
+    0x66, 0x2c, 0x31, 0x32, 0x2e, 0x35, 0x66, 0x29, 0x3b, 0x0a, 0x23, 0x65,
+    0x6e, 0x64, 0x69, 0x66, 0x0a, 0x73, 0x74, 0x6f, 0x72, 0x65, 0x50, 0x6f,
+    0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x28, 0x69, 0x6e, 0x64, 0x65, 0x78,
+    0x2c, 0x72, 0x65, 0x73, 0x75, 0x6c, 0x74, 0x29, 0x3b, 0x7d, 0x0a, 0x00,
+};
+
+static const char* const COMPUTE_FEATURES[] = {"DEBUG_IDS"};
+
+static const ShaderConstant COMPUTE_CONSTANTS[] = {
+    {"LOCAL_SIZE", 1024},
+    {"VELOCITY_FORMAT", 0},
+    {"POSITION_FORMAT", 0},
+    {"VELOCITY_FRAC_BITS", 0},
+    {"POSITION_FRAC_BITS", 0},
+};
+
+const ShaderDesc COMPUTE_SHADER = {
+    "compute", NULL, NULL, COMPUTE_COMP_SRC,
+    COMPUTE_FEATURES, 1, 0x1,
+    COMPUTE_CONSTANTS, 5,
+    0xcdf014518bac36a0ull,
+};
+
+// broadphase.comp: 4709 bytes, 2964 minified
+static constexpr char BROADPHASE_COMP_SRC[] = {
+    0x23, 0x76, 0x65, 0x72, 0x73, 0x69, 0x6f, 0x6e, 0x20, 0x33, 0x31, 0x30,
+    0x20, 0x65, 0x73, 0x0a, 0x23, 0x64, 0x65, 0x66, 0x69, 0x6e, 0x65, 0x20,
+    0x50, 0x41, 0x53, 0x53, 0x5f, 0x43, 0x4c, 0x45, 0x41, 0x52, 0x20, 0x30,
+    0x0a, 0x23, 0x64, 0x65, 0x66, 0x69, 0x6e, 0x65, 0x20, 0x50, 0x41, 0x53,
+    0x53, 0x5f, 0x48, 0x49, 0x53, 0x54, 0x4f, 0x47, 0x52, 0x41, 0x4d, 0x20,
+    0x31, 0x0a, 0x23, 0x64, 0x65, 0x66, 0x69, 0x6e, 0x65, 0x20, 0x50, 0x41,
+    0x53, 0x53, 0x5f, 0x53, 0x43, 0x41, 0x4e, 0x20, 0x32, 0x0a, 0x23, 0x64,
+    0x65, 0x66, 0x69, 0x6e, 0x65, 0x20, 0x50, 0x41, 0x53, 0x53, 0x5f, 0x53,
+    0x43, 0x41, 0x54, 0x54, 0x45, 0x52, 0x20, 0x33, 0x0a, 0x23, 0x64, 0x65,
+    0x66, 0x69, 0x6e, 0x65, 0x20, 0x50, 0x41, 0x53, 0x53, 0x5f, 0x50, 0x41,
+    0x49, 0x52, 0x53, 0x20, 0x34, 0x0a, 0x23, 0x64, 0x65, 0x66, 0x69, 0x6e,
+    0x65, 0x20, 0x51, 0x55, 0x41, 0x44, 0x5f, 0x45, 0x58, 0x54, 0x45, 0x4e,
+    0x54, 0x20, 0x30, 0x2e, 0x37, 0x0a, 0x23, 0x64, 0x65, 0x66, 0x69, 0x6e,
+    0x65, 0x20, 0x4d, 0x41, 0x58, 0x5f, 0x43, 0x45, 0x4c, 0x4c, 0x20, 0x31,
+    0x2e, 0x30, 0x65, 0x39, 0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x28,
+    0x6c, 0x6f, 0x63, 0x61, 0x6c, 0x5f, 0x73, 0x69, 0x7a, 0x65, 0x5f, 0x78,
+    0x3d, 0x4c, 0x4f, 0x43, 0x41, 0x4c, 0x5f, 0x53, 0x49, 0x5a, 0x45, 0x29,
+    0x69, 0x6e, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x75,
+    0x69, 0x6e, 0x74, 0x20, 0x6e, 0x75, 0x6d, 0x49, 0x6e, 0x73, 0x74, 0x61,
+    0x6e, 0x63, 0x65, 0x73, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d,
+    0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x69, 0x6e, 0x76, 0x43, 0x65,
+    0x6c, 0x6c, 0x53, 0x69, 0x7a, 0x65, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f,
+    0x72, 0x6d, 0x20, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x6e, 0x75, 0x6d, 0x42,
+    0x75, 0x63, 0x6b, 0x65, 0x74, 0x73, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f,
+    0x72, 0x6d, 0x20, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x6d, 0x61, 0x78, 0x50,
+    0x61, 0x69, 0x72, 0x73, 0x3b, 0x73, 0x74, 0x72, 0x75, 0x63, 0x74, 0x20,
+    0x45, 0x6e, 0x74, 0x72, 0x79, 0x7b, 0x76, 0x65, 0x63, 0x34, 0x20, 0x62,
+    0x6f, 0x75, 0x6e, 0x64, 0x73, 0x3b, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x62,
+    0x75, 0x63, 0x6b, 0x65, 0x74, 0x3b, 0x7d, 0x3b, 0x6c, 0x61, 0x79, 0x6f,
+    0x75, 0x74, 0x28, 0x73, 0x74, 0x64, 0x34, 0x33, 0x30, 0x2c, 0x62, 0x69,
+    0x6e, 0x64, 0x69, 0x6e, 0x67, 0x3d, 0x33, 0x29, 0x62, 0x75, 0x66, 0x66,
+    0x65, 0x72, 0x20, 0x42, 0x75, 0x63, 0x6b, 0x65, 0x74, 0x73, 0x7b, 0x75,
+    0x69, 0x6e, 0x74, 0x20, 0x62, 0x75, 0x63, 0x6b, 0x65, 0x74, 0x73, 0x5b,
+    0x5d, 0x3b, 0x7d, 0x3b, 0x0a, 0x23, 0x69, 0x66, 0x20, 0x50, 0x41, 0x53,
+    0x53, 0x20, 0x3d, 0x3d, 0x20, 0x50, 0x41, 0x53, 0x53, 0x5f, 0x48, 0x49,
+    0x53, 0x54, 0x4f, 0x47, 0x52, 0x41, 0x4d, 0x0a, 0x6c, 0x61, 0x79, 0x6f,
+    0x75, 0x74, 0x28, 0x73, 0x74, 0x64, 0x34, 0x33, 0x30, 0x2c, 0x62, 0x69,
+    0x6e, 0x64, 0x69, 0x6e, 0x67, 0x3d, 0x30, 0x29, 0x72, 0x65, 0x61, 0x64,
+    0x6f, 0x6e, 0x6c, 0x79, 0x20, 0x62, 0x75, 0x66, 0x66, 0x65, 0x72, 0x20,
+    0x4f, 0x66, 0x66, 0x73, 0x65, 0x74, 0x73, 0x7b, 0x76, 0x65, 0x63, 0x32,
+    0x20, 0x6f, 0x66, 0x66, 0x73, 0x65, 0x74, 0x73, 0x5b, 0x5d, 0x3b, 0x7d,
+    0x3b, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x28, 0x73, 0x74, 0x64, 0x34,
+    0x33, 0x30, 0x2c, 0x62, 0x69, 0x6e, 0x64, 0x69, 0x6e, 0x67, 0x3d, 0x31,
+    0x29, 0x72, 0x65, 0x61, 0x64, 0x6f, 0x6e, 0x6c, 0x79, 0x20, 0x62, 0x75,
+    0x66, 0x66, 0x65, 0x72, 0x20, 0x54, 0x72, 0x61, 0x6e, 0x73, 0x66, 0x6f,
+    0x72, 0x6d, 0x73, 0x7b, 0x76, 0x65, 0x63, 0x34, 0x20, 0x74, 0x72, 0x61,
+    0x6e, 0x73, 0x66, 0x6f, 0x72, 0x6d, 0x73, 0x5b, 0x5d, 0x3b, 0x7d, 0x3b,
+    0x0a, 0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 0x23, 0x69, 0x66, 0x20,
+    0x50, 0x41, 0x53, 0x53, 0x20, 0x3d, 0x3d, 0x20, 0x50, 0x41, 0x53, 0x53,
+    0x5f, 0x48, 0x49, 0x53, 0x54, 0x4f, 0x47, 0x52, 0x41, 0x4d, 0x20, 0x7c,
+    0x7c, 0x20, 0x50, 0x41, 0x53, 0x53, 0x20, 0x3d, 0x3d, 0x20, 0x50, 0x41,
+    0x53, 0x53, 0x5f, 0x53, 0x43, 0x41, 0x54, 0x54, 0x45, 0x52, 0x20, 0x7c,
+    0x7c, 0x20, 0x50, 0x41, 0x53, 0x53, 0x20, 0x3d, 0x3d, 0x20, 0x50, 0x41,
+    0x53, 0x53, 0x5f, 0x50, 0x41, 0x49, 0x52, 0x53, 0x0a, 0x6c, 0x61, 0x79,
+    0x6f, 0x75, 0x74, 0x28, 0x73, 0x74, 0x64, 0x34, 0x33, 0x30, 0x2c, 0x62,
+    0x69, 0x6e, 0x64, 0x69, 0x6e, 0x67, 0x3d, 0x32, 0x29, 0x62, 0x75, 0x66,
+    0x66, 0x65, 0x72, 0x20, 0x45, 0x6e, 0x74, 0x72, 0x69, 0x65, 0x73, 0x7b,
+    0x45, 0x6e, 0x74, 0x72, 0x79, 0x20, 0x65, 0x6e, 0x74, 0x72, 0x69, 0x65,
+    0x73, 0x5b, 0x5d, 0x3b, 0x7d, 0x3b, 0x0a, 0x23, 0x65, 0x6e, 0x64, 0x69,
+    0x66, 0x0a, 0x23, 0x69, 0x66, 0x20, 0x50, 0x41, 0x53, 0x53, 0x20, 0x3d,
+    0x3d, 0x20, 0x50, 0x41, 0x53, 0x53, 0x5f, 0x53, 0x43, 0x41, 0x54, 0x54,
+    0x45, 0x52, 0x20, 0x7c, 0x7c, 0x20, 0x50, 0x41, 0x53, 0x53, 0x20, 0x3d,
+    0x3d, 0x20, 0x50, 0x41, 0x53, 0x53, 0x5f, 0x50, 0x41, 0x49, 0x52, 0x53,
+    0x0a, 0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x28, 0x73, 0x74, 0x64, 0x34,
+    0x33, 0x30, 0x2c, 0x62, 0x69, 0x6e, 0x64, 0x69, 0x6e, 0x67, 0x3d, 0x30,
+    0x29, 0x62, 0x75, 0x66, 0x66, 0x65, 0x72, 0x20, 0x53, 0x6f, 0x72, 0x74,
+    0x65, 0x64, 0x7b, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x73, 0x6f, 0x72, 0x74,
+    0x65, 0x64, 0x5b, 0x5d, 0x3b, 0x7d, 0x3b, 0x0a, 0x23, 0x65, 0x6e, 0x64,
+    0x69, 0x66, 0x0a, 0x23, 0x69, 0x66, 0x20, 0x50, 0x41, 0x53, 0x53, 0x20,
+    0x3d, 0x3d, 0x20, 0x50, 0x41, 0x53, 0x53, 0x5f, 0x43, 0x4c, 0x45, 0x41,
+    0x52, 0x20, 0x7c, 0x7c, 0x20, 0x50, 0x41, 0x53, 0x53, 0x20, 0x3d, 0x3d,
+    0x20, 0x50, 0x41, 0x53, 0x53, 0x5f, 0x50, 0x41, 0x49, 0x52, 0x53, 0x0a,
+    0x6c, 0x61, 0x79, 0x6f, 0x75, 0x74, 0x28, 0x73, 0x74, 0x64, 0x34, 0x33,
+    0x30, 0x2c, 0x62, 0x69, 0x6e, 0x64, 0x69, 0x6e, 0x67, 0x3d, 0x31, 0x29,
+    0x62, 0x75, 0x66, 0x66, 0x65, 0x72, 0x20, 0x50, 0x61, 0x69, 0x72, 0x73,
+    0x7b, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x70, 0x61, 0x69, 0x72, 0x43, 0x6f,
+    0x75, 0x6e, 0x74, 0x3b, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x70, 0x61, 0x69,
+    0x72, 0x73, 0x55, 0x6e, 0x75, 0x73, 0x65, 0x64, 0x3b, 0x75, 0x76, 0x65,
+    0x63, 0x32, 0x20, 0x70, 0x61, 0x69, 0x72, 0x73, 0x5b, 0x5d, 0x3b, 0x7d,
+    0x3b, 0x0a, 0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 0x23, 0x69, 0x66,
+    0x20, 0x50, 0x41, 0x53, 0x53, 0x20, 0x3d, 0x3d, 0x20, 0x50, 0x41, 0x53,
+    0x53, 0x5f, 0x53, 0x43, 0x41, 0x4e, 0x0a, 0x73, 0x68, 0x61, 0x72, 0x65,
+    0x64, 0x20, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x73, 0x63, 0x61, 0x6e, 0x5b,
+    0x4c, 0x4f, 0x43, 0x41, 0x4c, 0x5f, 0x53, 0x49, 0x5a, 0x45, 0x5d, 0x3b,
+    0x0a, 0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 0x69, 0x76, 0x65, 0x63,
+    0x32, 0x20, 0x63, 0x65, 0x6c, 0x6c, 0x4f, 0x66, 0x28, 0x76, 0x65, 0x63,
+    0x32, 0x20, 0x63, 0x65, 0x6e, 0x74, 0x65, 0x72, 0x29, 0x7b, 0x72, 0x65,
+    0x74, 0x75, 0x72, 0x6e, 0x20, 0x69, 0x76, 0x65, 0x63, 0x32, 0x28, 0x63,
+    0x6c, 0x61, 0x6d, 0x70, 0x28, 0x66, 0x6c, 0x6f, 0x6f, 0x72, 0x28, 0x63,
+    0x65, 0x6e, 0x74, 0x65, 0x72, 0x2a, 0x69, 0x6e, 0x76, 0x43, 0x65, 0x6c,
+    0x6c, 0x53, 0x69, 0x7a, 0x65, 0x29, 0x2c, 0x2d, 0x4d, 0x41, 0x58, 0x5f,
+    0x43, 0x45, 0x4c, 0x4c, 0x2c, 0x4d, 0x41, 0x58, 0x5f, 0x43, 0x45, 0x4c,
+    0x4c, 0x29, 0x29, 0x3b, 0x7d, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x62, 0x75,
+    0x63, 0x6b, 0x65, 0x74, 0x4f, 0x66, 0x28, 0x69, 0x76, 0x65, 0x63, 0x32,
+    0x20, 0x63, 0x65, 0x6c, 0x6c, 0x29, 0x7b, 0x72, 0x65, 0x74, 0x75, 0x72,
+    0x6e, 0x28, 0x28, 0x75, 0x69, 0x6e, 0x74, 0x28, 0x63, 0x65, 0x6c, 0x6c,
+    0x2e, 0x78, 0x29, 0x2a, 0x37, 0x33, 0x38, 0x35, 0x36, 0x30, 0x39, 0x33,
+    0x75, 0x29, 0x5e, 0x28, 0x75, 0x69, 0x6e, 0x74, 0x28, 0x63, 0x65, 0x6c,
+    0x6c, 0x2e, 0x79, 0x29, 0x2a, 0x31, 0x39, 0x33, 0x34, 0x39, 0x36, 0x36,
+    0x33, 0x75, 0x29, 0x29, 0x26, 0x28, 0x6e, 0x75, 0x6d, 0x42, 0x75, 0x63,
+    0x6b, 0x65, 0x74, 0x73, 0x2d, 0x31, 0x75, 0x29, 0x3b, 0x7d, 0x76, 0x6f,
+    0x69, 0x64, 0x20, 0x6d, 0x61, 0x69, 0x6e, 0x28, 0x29, 0x7b, 0x75, 0x69,
+    0x6e, 0x74, 0x20, 0x69, 0x3d, 0x67, 0x6c, 0x5f, 0x47, 0x6c, 0x6f, 0x62,
+    0x61, 0x6c, 0x49, 0x6e, 0x76, 0x6f, 0x63, 0x61, 0x74, 0x69, 0x6f, 0x6e,
+    0x49, 0x44, 0x2e, 0x78, 0x3b, 0x0a, 0x23, 0x69, 0x66, 0x20, 0x50, 0x41,
+    0x53, 0x53, 0x20, 0x3d, 0x3d, 0x20, 0x50, 0x41, 0x53, 0x53, 0x5f, 0x43,
+    0x4c, 0x45, 0x41, 0x52, 0x0a, 0x69, 0x66, 0x28, 0x69, 0x3c, 0x6e, 0x75,
+    0x6d, 0x42, 0x75, 0x63, 0x6b, 0x65, 0x74, 0x73, 0x29, 0x62, 0x75, 0x63,
+    0x6b, 0x65, 0x74, 0x73, 0x5b, 0x69, 0x5d, 0x3d, 0x30, 0x75, 0x3b, 0x69,
+    0x66, 0x28, 0x69, 0x3d, 0x3d, 0x30, 0x75, 0x29, 0x70, 0x61, 0x69, 0x72,
+    0x43, 0x6f, 0x75, 0x6e, 0x74, 0x3d, 0x30, 0x75, 0x3b, 0x0a, 0x23, 0x65,
+    0x6c, 0x69, 0x66, 0x20, 0x50, 0x41, 0x53, 0x53, 0x20, 0x3d, 0x3d, 0x20,
+    0x50, 0x41, 0x53, 0x53, 0x5f, 0x48, 0x49, 0x53, 0x54, 0x4f, 0x47, 0x52,
+    0x41, 0x4d, 0x0a, 0x69, 0x66, 0x28, 0x69, 0x3e, 0x3d, 0x6e, 0x75, 0x6d,
+    0x49, 0x6e, 0x73, 0x74, 0x61, 0x6e, 0x63, 0x65, 0x73, 0x29, 0x72, 0x65,
+    0x74, 0x75, 0x72, 0x6e, 0x3b, 0x76, 0x65, 0x63, 0x32, 0x20, 0x63, 0x65,
+    0x6e, 0x74, 0x65, 0x72, 0x3d, 0x6f, 0x66, 0x66, 0x73, 0x65, 0x74, 0x73,
+    0x5b, 0x69, 0x5d, 0x3b, 0x76, 0x65, 0x63, 0x34, 0x20, 0x74, 0x3d, 0x74,
+    0x72, 0x61, 0x6e, 0x73, 0x66, 0x6f, 0x72, 0x6d, 0x73, 0x5b, 0x69, 0x5d,
+    0x3b, 0x76, 0x65, 0x63, 0x34, 0x20, 0x62, 0x6f, 0x75, 0x6e, 0x64, 0x73,
+    0x3d, 0x76, 0x65, 0x63, 0x34, 0x28, 0x63, 0x65, 0x6e, 0x74, 0x65, 0x72,
+    0x2c, 0x51, 0x55, 0x41, 0x44, 0x5f, 0x45, 0x58, 0x54, 0x45, 0x4e, 0x54,
+    0x2a, 0x28, 0x61, 0x62, 0x73, 0x28, 0x74, 0x2e, 0x78, 0x29, 0x2b, 0x61,
+    0x62, 0x73, 0x28, 0x74, 0x2e, 0x7a, 0x29, 0x29, 0x2c, 0x51, 0x55, 0x41,
+    0x44, 0x5f, 0x45, 0x58, 0x54, 0x45, 0x4e, 0x54, 0x2a, 0x28, 0x61, 0x62,
+    0x73, 0x28, 0x74, 0x2e, 0x79, 0x29, 0x2b, 0x61, 0x62, 0x73, 0x28, 0x74,
+    0x2e, 0x77, 0x29, 0x29, 0x29, 0x3b, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x62,
+    0x75, 0x63, 0x6b, 0x65, 0x74, 0x3d, 0x62, 0x75, 0x63, 0x6b, 0x65, 0x74,
+    0x4f, 0x66, 0x28, 0x63, 0x65, 0x6c, 0x6c, 0x4f, 0x66, 0x28, 0x63, 0x65,
+    0x6e, 0x74, 0x65, 0x72, 0x29, 0x29, 0x3b, 0x65, 0x6e, 0x74, 0x72, 0x69,
+    0x65, 0x73, 0x5b, 0x69, 0x5d, 0x3d, 0x45, 0x6e, 0x74, 0x72, 0x79, 0x28,
+    0x62, 0x6f, 0x75, 0x6e, 0x64, 0x73, 0x2c, 0x62, 0x75, 0x63, 0x6b, 0x65,
+    0x74, 0x29, 0x3b, 0x61, 0x74, 0x6f, 0x6d, 0x69, 0x63, 0x41, 0x64, 0x64,
+    0x28, 0x62, 0x75, 0x63, 0x6b, 0x65, 0x74, 0x73, 0x5b, 0x62, 0x75, 0x63,
+    0x6b, 0x65, 0x74, 0x5d, 0x2c, 0x31, 0x75, 0x29, 0x3b, 0x0a, 0x23, 0x65,
+    0x6c, 0x69, 0x66, 0x20, 0x50, 0x41, 0x53, 0x53, 0x20, 0x3d, 0x3d, 0x20,
+    0x50, 0x41, 0x53, 0x53, 0x5f, 0x53, 0x43, 0x41, 0x4e, 0x0a, 0x75, 0x69,
+    0x6e, 0x74, 0x20, 0x6c, 0x69, 0x64, 0x3d, 0x67, 0x6c, 0x5f, 0x4c, 0x6f,
+    0x63, 0x61, 0x6c, 0x49, 0x6e, 0x76, 0x6f, 0x63, 0x61, 0x74, 0x69, 0x6f,
+    0x6e, 0x49, 0x44, 0x2e, 0x78, 0x3b, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x63,
+    0x61, 0x72, 0x72, 0x79, 0x3d, 0x30, 0x75, 0x3b, 0x66, 0x6f, 0x72, 0x28,
+    0x75, 0x69, 0x6e, 0x74, 0x20, 0x62, 0x61, 0x73, 0x65, 0x3d, 0x30, 0x75,
+    0x3b, 0x62, 0x61, 0x73, 0x65, 0x3c, 0x6e, 0x75, 0x6d, 0x42, 0x75, 0x63,
+    0x6b, 0x65, 0x74, 0x73, 0x3b, 0x62, 0x61, 0x73, 0x65, 0x2b, 0x3d, 0x75,
+    0x69, 0x6e, 0x74, 0x28, 0x4c, 0x4f, 0x43, 0x41, 0x4c, 0x5f, 0x53, 0x49,
+    0x5a, 0x45, 0x29, 0x29, 0x7b, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x62, 0x3d,
+    0x62, 0x61, 0x73, 0x65, 0x2b, 0x6c, 0x69, 0x64, 0x3b, 0x75, 0x69, 0x6e,
+    0x74, 0x20, 0x63, 0x6f, 0x75, 0x6e, 0x74, 0x3d, 0x62, 0x3c, 0x6e, 0x75,
+    0x6d, 0x42, 0x75, 0x63, 0x6b, 0x65, 0x74, 0x73, 0x3f, 0x62, 0x75, 0x63,
+    0x6b, 0x65, 0x74, 0x73, 0x5b, 0x62, 0x5d, 0x3a, 0x30, 0x75, 0x3b, 0x73,
+    0x63, 0x61, 0x6e, 0x5b, 0x6c, 0x69, 0x64, 0x5d, 0x3d, 0x63, 0x6f, 0x75,
+    0x6e, 0x74, 0x3b, 0x6d, 0x65, 0x6d, 0x6f, 0x72, 0x79, 0x42, 0x61, 0x72,
+    0x72, 0x69, 0x65, 0x72, 0x53, 0x68, 0x61, 0x72, 0x65, 0x64, 0x28, 0x29,
+    0x3b, 0x62, 0x61, 0x72, 0x72, 0x69, 0x65, 0x72, 0x28, 0x29, 0x3b, 0x66,
+    0x6f, 0x72, 0x28, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x73, 0x74, 0x65, 0x70,
+    0x3d, 0x31, 0x75, 0x3b, 0x73, 0x74, 0x65, 0x70, 0x3c, 0x75, 0x69, 0x6e,
+    0x74, 0x28, 0x4c, 0x4f, 0x43, 0x41, 0x4c, 0x5f, 0x53, 0x49, 0x5a, 0x45,
+    0x29, 0x3b, 0x73, 0x74, 0x65, 0x70, 0x3c, 0x3c, 0x3d, 0x31, 0x29, 0x7b,
+    0x75, 0x69, 0x6e, 0x74, 0x20, 0x61, 0x64, 0x64, 0x3d, 0x6c, 0x69, 0x64,
+    0x3e, 0x3d, 0x73, 0x74, 0x65, 0x70, 0x3f, 0x73, 0x63, 0x61, 0x6e, 0x5b,
+    0x6c, 0x69, 0x64, 0x2d, 0x73, 0x74, 0x65, 0x70, 0x5d, 0x3a, 0x30, 0x75,
+    0x3b, 0x6d, 0x65, 0x6d, 0x6f, 0x72, 0x79, 0x42, 0x61, 0x72, 0x72, 0x69,
+    0x65, 0x72, 0x53, 0x68, 0x61, 0x72, 0x65, 0x64, 0x28, 0x29, 0x3b, 0x62,
+    0x61, 0x72, 0x72, 0x69, 0x65, 0x72, 0x28, 0x29, 0x3b, 0x73, 0x63, 0x61,
+    0x6e, 0x5b, 0x6c, 0x69, 0x64, 0x5d, 0x2b, 0x3d, 0x61, 0x64, 0x64, 0x3b,
+    0x6d, 0x65, 0x6d, 0x6f, 0x72, 0x79, 0x42, 0x61, 0x72, 0x72, 0x69, 0x65,
+    0x72, 0x53, 0x68, 0x61, 0x72, 0x65, 0x64, 0x28, 0x29, 0x3b, 0x62, 0x61,
+    0x72, 0x72, 0x69, 0x65, 0x72, 0x28, 0x29, 0x3b, 0x7d, 0x69, 0x66, 0x28,
+    0x62, 0x3c, 0x6e, 0x75, 0x6d, 0x42, 0x75, 0x63, 0x6b, 0x65, 0x74, 0x73,
+    0x29, 0x7b, 0x62, 0x75, 0x63, 0x6b, 0x65, 0x74, 0x73, 0x5b, 0x6e, 0x75,
+    0x6d, 0x42, 0x75, 0x63, 0x6b, 0x65, 0x74, 0x73, 0x2b, 0x62, 0x5d, 0x3d,
+    0x63, 0x61, 0x72, 0x72, 0x79, 0x2b, 0x73, 0x63, 0x61, 0x6e, 0x5b, 0x6c,
+    0x69, 0x64, 0x5d, 0x2d, 0x63, 0x6f, 0x75, 0x6e, 0x74, 0x3b, 0x62, 0x75,
+    0x63, 0x6b, 0x65, 0x74, 0x73, 0x5b, 0x62, 0x5d, 0x3d, 0x30, 0x75, 0x3b,
+    0x7d, 0x63, 0x61, 0x72, 0x72, 0x79, 0x2b, 0x3d, 0x73, 0x63, 0x61, 0x6e,
+    0x5b, 0x4c, 0x4f, 0x43, 0x41, 0x4c, 0x5f, 0x53, 0x49, 0x5a, 0x45, 0x2d,
+    0x31, 0x5d, 0x3b, 0x6d, 0x65, 0x6d, 0x6f, 0x72, 0x79, 0x42, 0x61, 0x72,
+    0x72, 0x69, 0x65, 0x72, 0x53, 0x68, 0x61, 0x72, 0x65, 0x64, 0x28, 0x29,
+    0x3b, 0x62, 0x61, 0x72, 0x72, 0x69, 0x65, 0x72, 0x28, 0x29, 0x3b, 0x7d,
+    0x69, 0x66, 0x28, 0x6c, 0x69, 0x64, 0x3d, 0x3d, 0x30, 0x75, 0x29, 0x62,
+    0x75, 0x63, 0x6b, 0x65, 0x74, 0x73, 0x5b, 0x32, 0x75, 0x2a, 0x6e, 0x75,
+    0x6d, 0x42, 0x75, 0x63, 0x6b, 0x65, 0x74, 0x73, 0x5d, 0x3d, 0x63, 0x61,
+    0x72, 0x72, 0x79, 0x3b, 0x0a, 0x23, 0x65, 0x6c, 0x69, 0x66, 0x20, 0x50,
+    0x41, 0x53, 0x53, 0x20, 0x3d, 0x3d, 0x20, 0x50, 0x41, 0x53, 0x53, 0x5f,
+    0x53, 0x43, 0x41, 0x54, 0x54, 0x45, 0x52, 0x0a, 0x69, 0x66, 0x28, 0x69,
+    0x3e, 0x3d, 0x6e, 0x75, 0x6d, 0x49, 0x6e, 0x73, 0x74, 0x61, 0x6e, 0x63,
+    0x65, 0x73, 0x29, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x3b, 0x75, 0x69,
+    0x6e, 0x74, 0x20, 0x62, 0x75, 0x63, 0x6b, 0x65, 0x74, 0x3d, 0x65, 0x6e,
+    0x74, 0x72, 0x69, 0x65, 0x73, 0x5b, 0x69, 0x5d, 0x2e, 0x62, 0x75, 0x63,
+    0x6b, 0x65, 0x74, 0x3b, 0x73, 0x6f, 0x72, 0x74, 0x65, 0x64, 0x5b, 0x62,
+    0x75, 0x63, 0x6b, 0x65, 0x74, 0x73, 0x5b, 0x6e, 0x75, 0x6d, 0x42, 0x75,
+    0x63, 0x6b, 0x65, 0x74, 0x73, 0x2b, 0x62, 0x75, 0x63, 0x6b, 0x65, 0x74,
+    0x5d, 0x2b, 0x61, 0x74, 0x6f, 0x6d, 0x69, 0x63, 0x41, 0x64, 0x64, 0x28,
+    0x62, 0x75, 0x63, 0x6b, 0x65, 0x74, 0x73, 0x5b, 0x62, 0x75, 0x63, 0x6b,
+    0x65, 0x74, 0x5d, 0x2c, 0x31, 0x75, 0x29, 0x5d, 0x3d, 0x69, 0x3b, 0x0a,
+    0x23, 0x65, 0x6c, 0x69, 0x66, 0x20, 0x50, 0x41, 0x53, 0x53, 0x20, 0x3d,
+    0x3d, 0x20, 0x50, 0x41, 0x53, 0x53, 0x5f, 0x50, 0x41, 0x49, 0x52, 0x53,
+    0x0a, 0x69, 0x66, 0x28, 0x69, 0x3e, 0x3d, 0x6e, 0x75, 0x6d, 0x49, 0x6e,
+    0x73, 0x74, 0x61, 0x6e, 0x63, 0x65, 0x73, 0x29, 0x72, 0x65, 0x74, 0x75,
+    0x72, 0x6e, 0x3b, 0x76, 0x65, 0x63, 0x34, 0x20, 0x61, 0x3d, 0x65, 0x6e,
+    0x74, 0x72, 0x69, 0x65, 0x73, 0x5b, 0x69, 0x5d, 0x2e, 0x62, 0x6f, 0x75,
+    0x6e, 0x64, 0x73, 0x3b, 0x69, 0x76, 0x65, 0x63, 0x32, 0x20, 0x63, 0x65,
+    0x6c, 0x6c, 0x3d, 0x63, 0x65, 0x6c, 0x6c, 0x4f, 0x66, 0x28, 0x61, 0x2e,
+    0x78, 0x79, 0x29, 0x3b, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x76, 0x69, 0x73,
+    0x69, 0x74, 0x65, 0x64, 0x5b, 0x39, 0x5d, 0x3b, 0x75, 0x69, 0x6e, 0x74,
+    0x20, 0x6e, 0x75, 0x6d, 0x56, 0x69, 0x73, 0x69, 0x74, 0x65, 0x64, 0x3d,
+    0x30, 0x75, 0x3b, 0x66, 0x6f, 0x72, 0x28, 0x69, 0x6e, 0x74, 0x20, 0x64,
+    0x79, 0x3d, 0x20, 0x2d, 0x31, 0x3b, 0x64, 0x79, 0x3c, 0x3d, 0x31, 0x3b,
+    0x64, 0x79, 0x2b, 0x2b, 0x29, 0x7b, 0x66, 0x6f, 0x72, 0x28, 0x69, 0x6e,
+    0x74, 0x20, 0x64, 0x78, 0x3d, 0x20, 0x2d, 0x31, 0x3b, 0x64, 0x78, 0x3c,
+    0x3d, 0x31, 0x3b, 0x64, 0x78, 0x2b, 0x2b, 0x29, 0x7b, 0x75, 0x69, 0x6e,
+    0x74, 0x20, 0x62, 0x75, 0x63, 0x6b, 0x65, 0x74, 0x3d, 0x62, 0x75, 0x63,
+    0x6b, 0x65, 0x74, 0x4f, 0x66, 0x28, 0x63, 0x65, 0x6c, 0x6c, 0x2b, 0x69,
+    0x76, 0x65, 0x63, 0x32, 0x28, 0x64, 0x78, 0x2c, 0x64, 0x79, 0x29, 0x29,
+    0x3b, 0x62, 0x6f, 0x6f, 0x6c, 0x20, 0x73, 0x65, 0x65, 0x6e, 0x3d, 0x66,
+    0x61, 0x6c, 0x73, 0x65, 0x3b, 0x66, 0x6f, 0x72, 0x28, 0x75, 0x69, 0x6e,
+    0x74, 0x20, 0x76, 0x3d, 0x30, 0x75, 0x3b, 0x76, 0x3c, 0x6e, 0x75, 0x6d,
+    0x56, 0x69, 0x73, 0x69, 0x74, 0x65, 0x64, 0x3b, 0x76, 0x2b, 0x2b, 0x29,
+    0x73, 0x65, 0x65, 0x6e, 0x3d, 0x73, 0x65, 0x65, 0x6e, 0x7c, 0x7c, 0x76,
+    0x69, 0x73, 0x69, 0x74, 0x65, 0x64, 0x5b, 0x76, 0x5d, 0x3d, 0x3d, 0x62,
+    0x75, 0x63, 0x6b, 0x65, 0x74, 0x3b, 0x69, 0x66, 0x28, 0x73, 0x65, 0x65,
+    0x6e, 0x29, 0x63, 0x6f, 0x6e, 0x74, 0x69, 0x6e, 0x75, 0x65, 0x3b, 0x76,
+    0x69, 0x73, 0x69, 0x74, 0x65, 0x64, 0x5b, 0x6e, 0x75, 0x6d, 0x56, 0x69,
+    0x73, 0x69, 0x74, 0x65, 0x64, 0x2b, 0x2b, 0x5d, 0x3d, 0x62, 0x75, 0x63,
+    0x6b, 0x65, 0x74, 0x3b, 0x75, 0x69, 0x6e, 0x74, 0x20, 0x65, 0x6e, 0x64,
+    0x3d, 0x62, 0x75, 0x63, 0x6b, 0x65, 0x74, 0x73, 0x5b, 0x6e, 0x75, 0x6d,
+    0x42, 0x75, 0x63, 0x6b, 0x65, 0x74, 0x73, 0x2b, 0x62, 0x75, 0x63, 0x6b,
+    0x65, 0x74, 0x2b, 0x31, 0x75, 0x5d, 0x3b, 0x66, 0x6f, 0x72, 0x28, 0x75,
+    0x69, 0x6e, 0x74, 0x20, 0x6b, 0x3d, 0x62, 0x75, 0x63, 0x6b, 0x65, 0x74,
+    0x73, 0x5b, 0x6e, 0x75, 0x6d, 0x42, 0x75, 0x63, 0x6b, 0x65, 0x74, 0x73,
+    0x2b, 0x62, 0x75, 0x63, 0x6b, 0x65, 0x74, 0x5d, 0x3b, 0x6b, 0x3c, 0x65,
+    0x6e, 0x64, 0x3b, 0x6b, 0x2b, 0x2b, 0x29, 0x7b, 0x75, 0x69, 0x6e, 0x74,
+    0x20, 0x6a, 0x3d, 0x73, 0x6f, 0x72, 0x74, 0x65, 0x64, 0x5b, 0x6b, 0x5d,
+    0x3b, 0x76, 0x65, 0x63, 0x34, 0x20, 0x62, 0x3d, 0x65, 0x6e, 0x74, 0x72,
+    0x69, 0x65, 0x73, 0x5b, 0x6a, 0x5d, 0x2e, 0x62, 0x6f, 0x75, 0x6e, 0x64,
+    0x73, 0x3b, 0x69, 0x66, 0x28, 0x6a, 0x3e, 0x69, 0x26, 0x26, 0x61, 0x6c,
+    0x6c, 0x28, 0x6c, 0x65, 0x73, 0x73, 0x54, 0x68, 0x61, 0x6e, 0x45, 0x71,
+    0x75, 0x61, 0x6c, 0x28, 0x61, 0x62, 0x73, 0x28, 0x61, 0x2e, 0x78, 0x79,
+    0x2d, 0x62, 0x2e, 0x78, 0x79, 0x29, 0x2c, 0x61, 0x2e, 0x7a, 0x77, 0x2b,
+    0x62, 0x2e, 0x7a, 0x77, 0x29, 0x29, 0x29, 0x7b, 0x75, 0x69, 0x6e, 0x74,
+    0x20, 0x73, 0x6c, 0x6f, 0x74, 0x3d, 0x61, 0x74, 0x6f, 0x6d, 0x69, 0x63,
+    0x41, 0x64, 0x64, 0x28, 0x70, 0x61, 0x69, 0x72, 0x43, 0x6f, 0x75, 0x6e,
+    0x74, 0x2c, 0x31, 0x75, 0x29, 0x3b, 0x69, 0x66, 0x28, 0x73, 0x6c, 0x6f,
+    0x74, 0x3c, 0x6d, 0x61, 0x78, 0x50, 0x61, 0x69, 0x72, 0x73, 0x29, 0x70,
+    0x61, 0x69, 0x72, 0x73, 0x5b, 0x73, 0x6c, 0x6f, 0x74, 0x5d, 0x3d, 0x75,
+    0x76, 0x65, 0x63, 0x32, 0x28, 0x69, 0x2c, 0x6a, 0x29, 0x3b, 0x7d, 0x7d,
+    0x7d, 0x7d, 0x0a, 0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 0x7d, 0x0a,
+    0x00,
+};
+
+static const ShaderConstant BROADPHASE_CONSTANTS[] = {
+    {"PASS", 0},
+    {"LOCAL_SIZE", 256},
+};
+
+const ShaderDesc BROADPHASE_SHADER = {
+    "broadphase", NULL, NULL, BROADPHASE_COMP_SRC,
+    NULL, 0, 0x0,
+    BROADPHASE_CONSTANTS, 2,
+    0x7c687ffc51124712ull,
+};
+
+// draw_es2.vert: 1148 bytes, 539 minified
+static constexpr char DRAW_ES2_VERT_SRC[] = {
+    0x23, 0x76, 0x65, 0x72, 0x73, 0x69, 0x6f, 0x6e, 0x20, 0x31, 0x30, 0x30,
+    0x0a, 0x61, 0x74, 0x74, 0x72, 0x69, 0x62, 0x75, 0x74, 0x65, 0x20, 0x76,
+    0x65, 0x63, 0x32, 0x20, 0x70, 0x6f, 0x73, 0x3b, 0x61, 0x74, 0x74, 0x72,
+    0x69, 0x62, 0x75, 0x74, 0x65, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x63,
+    0x6f, 0x6c, 0x6f, 0x72, 0x3b, 0x61, 0x74, 0x74, 0x72, 0x69, 0x62, 0x75,
+    0x74, 0x65, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x69, 0x6e, 0x73,
+    0x74, 0x61, 0x6e, 0x63, 0x65, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72,
+    0x6d, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20, 0x73, 0x63, 0x61, 0x6c, 0x65,
+    0x52, 0x6f, 0x74, 0x5b, 0x42, 0x41, 0x54, 0x43, 0x48, 0x5f, 0x53, 0x49,
+    0x5a, 0x45, 0x5d, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20,
+    0x76, 0x65, 0x63, 0x34, 0x20, 0x6f, 0x66, 0x66, 0x73, 0x65, 0x74, 0x73,
+    0x5b, 0x28, 0x42, 0x41, 0x54, 0x43, 0x48, 0x5f, 0x53, 0x49, 0x5a, 0x45,
+    0x2b, 0x31, 0x29, 0x2f, 0x32, 0x5d, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f,
+    0x72, 0x6d, 0x20, 0x76, 0x65, 0x63, 0x33, 0x20, 0x63, 0x61, 0x6d, 0x65,
+    0x72, 0x61, 0x3b, 0x0a, 0x23, 0x69, 0x66, 0x20, 0x44, 0x45, 0x50, 0x54,
+    0x48, 0x0a, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x66, 0x6c,
+    0x6f, 0x61, 0x74, 0x20, 0x64, 0x65, 0x70, 0x74, 0x68, 0x53, 0x74, 0x65,
+    0x70, 0x3b, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x66, 0x6c,
+    0x6f, 0x61, 0x74, 0x20, 0x62, 0x61, 0x74, 0x63, 0x68, 0x46, 0x69, 0x72,
+    0x73, 0x74, 0x3b, 0x0a, 0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 0x76,
+    0x61, 0x72, 0x79, 0x69, 0x6e, 0x67, 0x20, 0x76, 0x65, 0x63, 0x34, 0x20,
+    0x76, 0x43, 0x6f, 0x6c, 0x6f, 0x72, 0x3b, 0x76, 0x6f, 0x69, 0x64, 0x20,
+    0x6d, 0x61, 0x69, 0x6e, 0x28, 0x29, 0x7b, 0x69, 0x6e, 0x74, 0x20, 0x69,
+    0x3d, 0x69, 0x6e, 0x74, 0x28, 0x69, 0x6e, 0x73, 0x74, 0x61, 0x6e, 0x63,
+    0x65, 0x29, 0x3b, 0x76, 0x65, 0x63, 0x34, 0x20, 0x73, 0x72, 0x3d, 0x73,
+    0x63, 0x61, 0x6c, 0x65, 0x52, 0x6f, 0x74, 0x5b, 0x69, 0x5d, 0x3b, 0x76,
+    0x65, 0x63, 0x34, 0x20, 0x70, 0x61, 0x69, 0x72, 0x3d, 0x6f, 0x66, 0x66,
+    0x73, 0x65, 0x74, 0x73, 0x5b, 0x69, 0x2f, 0x32, 0x5d, 0x3b, 0x76, 0x65,
+    0x63, 0x32, 0x20, 0x6f, 0x66, 0x66, 0x73, 0x65, 0x74, 0x3d, 0x69, 0x2d,
+    0x32, 0x2a, 0x28, 0x69, 0x2f, 0x32, 0x29, 0x3d, 0x3d, 0x30, 0x3f, 0x70,
+    0x61, 0x69, 0x72, 0x2e, 0x78, 0x79, 0x3a, 0x70, 0x61, 0x69, 0x72, 0x2e,
+    0x7a, 0x77, 0x3b, 0x67, 0x6c, 0x5f, 0x50, 0x6f, 0x73, 0x69, 0x74, 0x69,
+    0x6f, 0x6e, 0x3d, 0x76, 0x65, 0x63, 0x34, 0x28, 0x28, 0x6d, 0x61, 0x74,
+    0x32, 0x28, 0x73, 0x72, 0x2e, 0x78, 0x79, 0x2c, 0x73, 0x72, 0x2e, 0x7a,
+    0x77, 0x29, 0x2a, 0x70, 0x6f, 0x73, 0x2b, 0x6f, 0x66, 0x66, 0x73, 0x65,
+    0x74, 0x2d, 0x63, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x2e, 0x78, 0x79, 0x29,
+    0x2a, 0x63, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x2e, 0x7a, 0x2c, 0x30, 0x2e,
+    0x30, 0x2c, 0x31, 0x2e, 0x30, 0x29, 0x3b, 0x0a, 0x23, 0x69, 0x66, 0x20,
+    0x44, 0x45, 0x50, 0x54, 0x48, 0x0a, 0x67, 0x6c, 0x5f, 0x50, 0x6f, 0x73,
+    0x69, 0x74, 0x69, 0x6f, 0x6e, 0x2e, 0x7a, 0x3d, 0x28, 0x62, 0x61, 0x74,
+    0x63, 0x68, 0x46, 0x69, 0x72, 0x73, 0x74, 0x2b, 0x69, 0x6e, 0x73, 0x74,
+    0x61, 0x6e, 0x63, 0x65, 0x2b, 0x30, 0x2e, 0x35, 0x29, 0x2a, 0x64, 0x65,
+    0x70, 0x74, 0x68, 0x53, 0x74, 0x65, 0x70, 0x2d, 0x31, 0x2e, 0x30, 0x3b,
+    0x0a, 0x23, 0x65, 0x6e, 0x64, 0x69, 0x66, 0x0a, 0x76, 0x43, 0x6f, 0x6c,
+    0x6f, 0x72, 0x3d, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x3b, 0x7d, 0x0a, 0x00,
+};
+
+// draw_es2.frag: 102 bytes, 91 minified
+static constexpr char DRAW_ES2_FRAG_SRC[] = {
+    0x23, 0x76, 0x65, 0x72, 0x73, 0x69, 0x6f, 0x6e, 0x20, 0x31, 0x30, 0x30,
+    0x0a, 0x70, 0x72, 0x65, 0x63, 0x69, 0x73, 0x69, 0x6f, 0x6e, 0x20, 0x6d,
+    0x65, 0x64, 0x69, 0x75, 0x6d, 0x70, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74,
+    0x3b, 0x76, 0x61, 0x72, 0x79, 0x69, 0x6e, 0x67, 0x20, 0x76, 0x65, 0x63,
+    0x34, 0x20, 0x76, 0x43, 0x6f, 0x6c, 0x6f, 0x72, 0x3b, 0x76, 0x6f, 0x69,
+    0x64, 0x20, 0x6d, 0x61, 0x69, 0x6e, 0x28, 0x29, 0x7b, 0x67, 0x6c, 0x5f,
+    0x46, 0x72, 0x61, 0x67, 0x43, 0x6f, 0x6c, 0x6f, 0x72, 0x3d, 0x76, 0x43,
+    0x6f, 0x6c, 0x6f, 0x72, 0x3b, 0x7d, 0x0a, 0x00,
+};
+
+static const char* const DRAW_ES2_FEATURES[] = {"DEPTH"};
+
+static const ShaderConstant DRAW_ES2_CONSTANTS[] = {
+    {"BATCH_SIZE", 16},
+};
+
+const ShaderDesc DRAW_ES2_SHADER = {
+    "draw_es2", DRAW_ES2_VERT_SRC, DRAW_ES2_FRAG_SRC, NULL,
+    DRAW_ES2_FEATURES, 1, 0x0,
+    DRAW_ES2_CONSTANTS, 1,
+    0xff9c2f09db276067ull,
+};
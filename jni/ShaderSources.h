@@ -0,0 +1,13 @@
+// Generated by tools/embed_shaders.py from jni/shaders. Do not edit.
+
+#ifndef SHADERSOURCES_H
+#define SHADERSOURCES_H 1
+
+#include "ShaderVariant.h"
+
+extern const ShaderDesc DRAW_SHADER;
+extern const ShaderDesc COMPUTE_SHADER;
+extern const ShaderDesc BROADPHASE_SHADER;
+extern const ShaderDesc DRAW_ES2_SHADER;
+
+#endif // SHADERSOURCES_H
@@ -0,0 +1,365 @@
+/*
+ * Copyright 2013 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ShaderVariant.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+uint64_t hashBytes(const void* data, size_t size, uint64_t seed) {
+    const uint8_t* p = (const uint8_t*)data;
+    uint64_t h = seed;
+    for (size_t i = 0; i < size; i++) {
+        h ^= p[i];
+        h *= 0x100000001b3ull;
+    }
+    return h;
+}
+
+ShaderVariantKey defaultVariantKey(const ShaderDesc& desc) {
+    ShaderVariantKey key;
+    memset(&key, 0, sizeof(key));
+    key.features = desc.defaultFeatures;
+    for (unsigned int i = 0; i < desc.numConstants; i++)
+        key.constants[i] = desc.constants[i].defaultValue;
+    return key;
+}
+
+int findShaderFeature(const ShaderDesc& desc, const char* name) {
+    for (unsigned int i = 0; i < desc.numFeatures; i++) {
+        if (strcmp(desc.features[i], name) == 0)
+            return i;
+    }
+    return -1;
+}
+
+int findShaderConstant(const ShaderDesc& desc, const char* name) {
+    for (unsigned int i = 0; i < desc.numConstants; i++) {
+        if (strcmp(desc.constants[i].name, name) == 0)
+            return i;
+    }
+    return -1;
+}
+
+static const char* shaderTypeName(GLenum type) {
+    switch (type) {
+    case GL_VERTEX_SHADER:   return "vertex";
+    case GL_FRAGMENT_SHADER: return "fragment";
+    case GL_COMPUTE_SHADER:  return "compute";
+    default:                 return "unknown";
+    }
+}
+
+// Returns a malloc'd copy of src with the variant's #defines inserted after
+// the #version line.
+static char* specializeSource(const char* src, const ShaderDesc& desc,
+        const ShaderVariantKey& key) {
+    const char* body = strchr(src, '\n');
+    body = body ? body + 1 : src + strlen(src);
+    size_t versionLen = body - src;
+
+    size_t len = strlen(src) + 1;
+    for (unsigned int i = 0; i < desc.numFeatures; i++)
+        len += strlen(desc.features[i]) + sizeof("#define  0\n");
+    for (unsigned int i = 0; i < desc.numConstants; i++)
+        len += strlen(desc.constants[i].name) + sizeof("#define  -2147483648\n");
+
+    char* out = (char*)malloc(len);
+    if (!out)
+        return NULL;
+    char* p = out;
+    memcpy(p, src, versionLen);
+    p += versionLen;
+    if (versionLen > 0 && p[-1] != '\n')
+        *p++ = '\n';
+    for (unsigned int i = 0; i < desc.numFeatures; i++) {
+        p += sprintf(p, "#define %s %d\n", desc.features[i],
+                (key.features >> i) & 1);
+    }
+    for (unsigned int i = 0; i < desc.numConstants; i++) {
+        p += sprintf(p, "#define %s %d\n", desc.constants[i].name,
+                key.constants[i]);
+    }
+    strcpy(p, body);
+    return out;
+}
+
+// Compiles and attaches one stage without waiting for the compile result.
+static bool attachStage(GLuint program, GLenum type, const char* src,
+        const ShaderDesc& desc, const ShaderVariantKey& key) {
+    char* specialized = specializeSource(src, desc, key);
+    if (!specialized) {
+        ALOGE("Out of memory specializing %s shader of %s",
+                shaderTypeName(type), desc.name);
+        return false;
+    }
+    GLuint shader = glCreateShader(type);
+    if (!shader) {
+        checkGlError("glCreateShader");
+        free(specialized);
+        return false;
+    }
+    const GLchar* sources = specialized;
+    glShaderSource(shader, 1, &sources, NULL);
+    glCompileShader(shader);
+    glAttachShader(program, shader);
+    // Flagged for deletion; it goes away once detached from the program.
+    glDeleteShader(shader);
+    free(specialized);
+    return true;
+}
+
+static void logShaderInfo(GLuint program, const char* name) {
+    GLuint shaders[2];
+    GLsizei count = 0;
+    glGetAttachedShaders(program, 2, &count, shaders);
+    for (GLsizei i = 0; i < count; i++) {
+        GLint compiled = GL_FALSE;
+        glGetShaderiv(shaders[i], GL_COMPILE_STATUS, &compiled);
+        if (compiled)
+            continue;
+        GLint type = 0;
+        glGetShaderiv(shaders[i], GL_SHADER_TYPE, &type);
+        GLint infoLogLen = 0;
+        glGetShaderiv(shaders[i], GL_INFO_LOG_LENGTH, &infoLogLen);
+        if (infoLogLen > 0) {
+            GLchar* infoLog = (GLchar*)malloc(infoLogLen);
+            if (infoLog) {
+                glGetShaderInfoLog(shaders[i], infoLogLen, NULL, infoLog);
+                ALOGE("Could not compile %s shader of %s:\n%s\n",
+                        shaderTypeName(type), name, infoLog);
+                free(infoLog);
+            }
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+ShaderVariantCache::ShaderVariantCache()
+:   mEntries(NULL),
+    mNumEntries(0),
+    mCapacity(0),
+    mDescHashes(NULL),
+    mNumDescHashes(0),
+    mDescHashCapacity(0)
+{}
+
+ShaderVariantCache::~ShaderVariantCache() {
+    // Programs are owned by the GL context; whoever owns the cache decides
+    // between clear() and forget() before destroying it.
+    free(mEntries);
+    free(mDescHashes);
+}
+
+uint64_t ShaderVariantCache::sourceHash(const ShaderDesc& desc) {
+    if (desc.sourceHash)
+        return desc.sourceHash;
+
+    for (unsigned int i = 0; i < mNumDescHashes; i++) {
+        if (mDescHashes[i].desc == &desc)
+            return mDescHashes[i].hash;
+    }
+
+    const char* srcs[3] = {desc.vertexSrc, desc.fragmentSrc, desc.computeSrc};
+    uint64_t hash = hashBytes(desc.name, strlen(desc.name));
+    for (int s = 0; s < 3; s++) {
+        if (srcs[s])
+            hash = hashBytes(srcs[s], strlen(srcs[s]), hash);
+    }
+
+    if (mNumDescHashes == mDescHashCapacity) {
+        unsigned int cap = mDescHashCapacity ? 2 * mDescHashCapacity : 8;
+        DescHash* hashes = (DescHash*)realloc(mDescHashes,
+                cap * sizeof(DescHash));
+        if (!hashes)
+            return hash;
+        mDescHashes = hashes;
+        mDescHashCapacity = cap;
+    }
+    mDescHashes[mNumDescHashes].desc = &desc;
+    mDescHashes[mNumDescHashes].hash = hash;
+    mNumDescHashes++;
+    return hash;
+}
+
+uint64_t ShaderVariantCache::variantHash(const ShaderDesc& desc,
+        const ShaderVariantKey& key) {
+    uint64_t descHash = sourceHash(desc);
+
+    // Only hash the constants the desc actually declares, so unused slots
+    // can hold anything.
+    uint64_t h = hashBytes(&key.features, sizeof(key.features), descHash);
+    return hashBytes(key.constants, desc.numConstants * sizeof(int), h);
+}
+
+// The hash only narrows the search; a collision must not hand out another
+// variant's program.
+ShaderVariantCache::Entry* ShaderVariantCache::find(uint64_t hash,
+        const ShaderDesc& desc, const ShaderVariantKey& key) {
+    for (unsigned int i = 0; i < mNumEntries; i++) {
+        Entry& entry = mEntries[i];
+        if (entry.hash == hash && entry.key.features == key.features &&
+                memcmp(entry.key.constants, key.constants,
+                    desc.numConstants * sizeof(int)) == 0 &&
+                entry.desc == &desc)
+            return &entry;
+    }
+    return NULL;
+}
+
+ShaderVariantCache::Entry* ShaderVariantCache::insert(uint64_t hash,
+        const ShaderDesc& desc, const ShaderVariantKey& key) {
+    if (mNumEntries == mCapacity) {
+        unsigned int cap = mCapacity ? 2 * mCapacity : 8;
+        Entry* entries = (Entry*)realloc(mEntries, cap * sizeof(Entry));
+        if (!entries) {
+            ALOGE("Out of memory caching variant of %s", desc.name);
+            return NULL;
+        }
+        mEntries = entries;
+        mCapacity = cap;
+    }
+
+    Entry* entry = &mEntries[mNumEntries++];
+    entry->hash = hash;
+    entry->desc = &desc;
+    entry->key = key;
+    entry->program = glCreateProgram();
+    entry->state = PENDING;
+    if (!entry->program) {
+        checkGlError("glCreateProgram");
+        entry->state = FAILED;
+        return entry;
+    }
+
+    bool ok;
+    if (desc.computeSrc) {
+        ok = attachStage(entry->program, GL_COMPUTE_SHADER, desc.computeSrc,
+                desc, key);
+    } else {
+        ok = attachStage(entry->program, GL_VERTEX_SHADER, desc.vertexSrc,
+                desc, key) &&
+             attachStage(entry->program, GL_FRAGMENT_SHADER, desc.fragmentSrc,
+                desc, key);
+    }
+    if (!ok) {
+        glDeleteProgram(entry->program);
+        entry->program = 0;
+        entry->state = FAILED;
+        return entry;
+    }
+    glLinkProgram(entry->program);
+    ALOGV("Building %s variant %016llx", desc.name, (unsigned long long)hash);
+    return entry;
+}
+
+void ShaderVariantCache::finish(Entry* entry) {
+    if (entry->state != PENDING)
+        return;
+
+    GLint linked = GL_FALSE;
+    glGetProgramiv(entry->program, GL_LINK_STATUS, &linked);
+    if (!linked) {
+        logShaderInfo(entry->program, entry->desc->name);
+        GLint infoLogLen = 0;
+        glGetProgramiv(entry->program, GL_INFO_LOG_LENGTH, &infoLogLen);
+        if (infoLogLen) {
+            GLchar* infoLog = (GLchar*)malloc(infoLogLen);
+            if (infoLog) {
+                glGetProgramInfoLog(entry->program, infoLogLen, NULL, infoLog);
+                ALOGE("Could not link %s:\n%s\n", entry->desc->name, infoLog);
+                free(infoLog);
+            }
+        }
+        glDeleteProgram(entry->program);
+        entry->program = 0;
+        entry->state = FAILED;
+        return;
+    }
+
+    // Detaching releases the shader objects, which were already flagged for
+    // deletion.
+    GLuint shaders[2];
+    GLsizei count = 0;
+    glGetAttachedShaders(entry->program, 2, &count, shaders);
+    for (GLsizei i = 0; i < count; i++)
+        glDetachShader(entry->program, shaders[i]);
+    entry->state = READY;
+}
+
+GLuint ShaderVariantCache::get(const ShaderDesc& desc,
+        const ShaderVariantKey& key) {
+    uint64_t hash = variantHash(desc, key);
+    Entry* entry = find(hash, desc, key);
+    if (!entry)
+        entry = insert(hash, desc, key);
+    if (!entry)
+        return 0;
+    finish(entry);
+    return entry->program;
+}
+
+void ShaderVariantCache::prewarm(const ShaderDesc& desc,
+        const ShaderVariantKey& key) {
+    uint64_t hash = variantHash(desc, key);
+    if (!find(hash, desc, key))
+        insert(hash, desc, key);
+}
+
+void ShaderVariantCache::prewarmAllFeatures(const ShaderDesc& desc,
+        const ShaderVariantKey& base) {
+    // Keep the permutation count sane; anything larger wants an explicit list.
+    if (desc.numFeatures > 8) {
+        ALOGE("%s has %u features, too many to prewarm every combination",
+                desc.name, desc.numFeatures);
+        return;
+    }
+    ShaderVariantKey key = base;
+    uint32_t combinations = 1u << desc.numFeatures;
+    for (uint32_t features = 0; features < combinations; features++) {
+        key.features = features;
+        prewarm(desc, key);
+    }
+}
+
+unsigned int ShaderVariantCache::collectPrewarmed(unsigned int maxPrograms) {
+    unsigned int pending = 0;
+    for (unsigned int i = 0; i < mNumEntries; i++) {
+        if (mEntries[i].state != PENDING)
+            continue;
+        if (maxPrograms > 0) {
+            finish(&mEntries[i]);
+            maxPrograms--;
+        } else {
+            pending++;
+        }
+    }
+    return pending;
+}
+
+void ShaderVariantCache::clear() {
+    for (unsigned int i = 0; i < mNumEntries; i++) {
+        if (mEntries[i].program)
+            glDeleteProgram(mEntries[i].program);
+    }
+    forget();
+}
+
+void ShaderVariantCache::forget() {
+    mNumEntries = 0;
+}
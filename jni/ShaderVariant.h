@@ -0,0 +1,151 @@
+/*
+ * Copyright 2013 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SHADERVARIANT_H
+#define SHADERVARIANT_H 1
+
+#include "gles3jni.h"
+
+#include <stdint.h>
+
+// ----------------------------------------------------------------------------
+// Shader permutations.
+//
+// A ShaderDesc declares the GLSL sources of one program together with the
+// feature flags and integer constants it can be specialized on. A
+// ShaderVariantKey picks one value for each of them. The cache turns a
+// (desc, key) pair into a linked program by inserting a block of #defines
+// right after the #version line, so that disabled code paths are removed by
+// the GLSL preprocessor instead of being branched over at runtime:
+//
+//     #version 310 es
+//     #define DEBUG_IDS 1       <- feature flag, 0 or 1
+//     #define LOCAL_SIZE 1024   <- constant
+//     ... rest of the source ...
+//
+// Shaders test features with "#if NAME", never "#ifdef NAME".
+
+#define MAX_SHADER_FEATURES  32
+#define MAX_SHADER_CONSTANTS 8
+
+struct ShaderConstant {
+    const char* name;
+    int defaultValue;
+};
+
+struct ShaderDesc {
+    const char* name;
+    // Either vertex + fragment, or compute. The first line of each source
+    // must be the #version directive.
+    const char* vertexSrc;
+    const char* fragmentSrc;
+    const char* computeSrc;
+
+    const char* const* features;
+    unsigned int numFeatures;
+    // bit i set means features[i] is enabled by default
+    uint32_t defaultFeatures;
+    const ShaderConstant* constants;
+    unsigned int numConstants;
+
+    // Content hash of the name and sources, as computed by
+    // tools/embed_shaders.py. 0 means the cache hashes the sources itself
+    // the first time it sees the desc.
+    uint64_t sourceHash;
+};
+
+struct ShaderVariantKey {
+    uint32_t features;
+    int constants[MAX_SHADER_CONSTANTS];
+};
+
+// Returns the key selecting every default of desc.
+extern ShaderVariantKey defaultVariantKey(const ShaderDesc& desc);
+// Returns the index of the named feature or constant, or -1.
+extern int findShaderFeature(const ShaderDesc& desc, const char* name);
+extern int findShaderConstant(const ShaderDesc& desc, const char* name);
+
+// 64-bit FNV-1a, used for variant keys and source content hashes.
+extern uint64_t hashBytes(const void* data, size_t size,
+        uint64_t seed = 0xcbf29ce484222325ull);
+
+class ShaderVariantCache {
+public:
+    ShaderVariantCache();
+    ~ShaderVariantCache();
+
+    // Returns the program for the variant, compiling and linking it on first
+    // use. Returns 0 if the variant failed to build; failures are cached too
+    // so a broken variant is only reported once.
+    GLuint get(const ShaderDesc& desc, const ShaderVariantKey& key);
+
+    // Starts compiling the variant without waiting for the result. Drivers
+    // compile on their own threads when the status isn't queried right away,
+    // so a prewarmed variant is usually ready by the time get() needs it.
+    void prewarm(const ShaderDesc& desc, const ShaderVariantKey& key);
+    // Prewarms every combination of desc's feature flags, with the constants
+    // taken from base.
+    void prewarmAllFeatures(const ShaderDesc& desc,
+            const ShaderVariantKey& base);
+
+    // Checks up to maxPrograms pending prewarmed programs, so that compile
+    // errors are reported and the driver's results are collected off the
+    // critical path. Returns the number still pending.
+    unsigned int collectPrewarmed(unsigned int maxPrograms);
+
+    // Deletes every cached program. The owning context must be current.
+    void clear();
+    // Drops every cached program without deleting it, for use after the
+    // context (and with it all programs) has been destroyed.
+    void forget();
+
+    unsigned int size() const { return mNumEntries; }
+
+private:
+    enum State {PENDING, READY, FAILED};
+    struct Entry {
+        uint64_t hash;
+        const ShaderDesc* desc;
+        ShaderVariantKey key;
+        GLuint program;
+        State state;
+    };
+
+    uint64_t sourceHash(const ShaderDesc& desc);
+    uint64_t variantHash(const ShaderDesc& desc,
+            const ShaderVariantKey& key);
+    Entry* find(uint64_t hash, const ShaderDesc& desc,
+            const ShaderVariantKey& key);
+    Entry* insert(uint64_t hash, const ShaderDesc& desc,
+            const ShaderVariantKey& key);
+    void finish(Entry* entry);
+
+    Entry* mEntries;
+    unsigned int mNumEntries;
+    unsigned int mCapacity;
+
+    // source content hash of each desc seen so far that didn't come with a
+    // precomputed one
+    struct DescHash {
+        const ShaderDesc* desc;
+        uint64_t hash;
+    };
+    DescHash* mDescHashes;
+    unsigned int mNumDescHashes;
+    unsigned int mDescHashCapacity;
+};
+
+#endif // SHADERVARIANT_H
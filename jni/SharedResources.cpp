@@ -0,0 +1,191 @@
+/*
+ * Copyright 2013 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SharedResources.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static pthread_mutex_t g_registryLock = PTHREAD_MUTEX_INITIALIZER;
+static SharedResources* g_registry = NULL;
+
+SharedResources* SharedResources::acquire(unsigned int shareGroup) {
+    pthread_mutex_lock(&g_registryLock);
+    SharedResources* res;
+    for (res = g_registry; res; res = res->mNext) {
+        if (res->mShareGroup == shareGroup)
+            break;
+    }
+    if (res) {
+        res->mRefs++;
+    } else {
+        res = new SharedResources(shareGroup);
+        if (res->init()) {
+            res->mNext = g_registry;
+            g_registry = res;
+            ALOGV("Created shared resources for share group %u", shareGroup);
+        } else {
+            res->deleteObjects();
+            delete res;
+            res = NULL;
+        }
+    }
+    pthread_mutex_unlock(&g_registryLock);
+    return res;
+}
+
+void SharedResources::release(bool contextCurrent) {
+    pthread_mutex_lock(&g_registryLock);
+    if (--mRefs > 0) {
+        pthread_mutex_unlock(&g_registryLock);
+        return;
+    }
+    for (SharedResources** p = &g_registry; *p; p = &(*p)->mNext) {
+        if (*p == this) {
+            *p = mNext;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&g_registryLock);
+
+    if (contextCurrent) {
+        deleteObjects();
+    } else {
+        mShaders.forget();
+    }
+    ALOGV("Released shared resources for share group %u", mShareGroup);
+    delete this;
+}
+
+SharedResources::SharedResources(unsigned int shareGroup)
+:   mShareGroup(shareGroup),
+    mRefs(1),
+    mNext(NULL),
+    mQuadVB(0),
+    mDeadBuffers(NULL),
+    mNumDeadBuffers(0),
+    mDeadTextures(NULL),
+    mNumDeadTextures(0),
+    mDeadSyncs(NULL),
+    mNumDeadSyncs(0)
+{
+    pthread_mutex_init(&mLock, NULL);
+}
+
+SharedResources::~SharedResources() {
+    free(mDeadBuffers);
+    free(mDeadTextures);
+    free(mDeadSyncs);
+    pthread_mutex_destroy(&mLock);
+}
+
+bool SharedResources::init() {
+    glGenBuffers(1, &mQuadVB);
+    glBindBuffer(GL_ARRAY_BUFFER, mQuadVB);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(QUAD), &QUAD[0], GL_STATIC_DRAW);
+    // Make sure the upload is complete before another context uses it.
+    glFlush();
+    return !checkGlError("SharedResources::init");
+}
+
+void SharedResources::deleteObjects() {
+    collectGarbage();
+    glDeleteBuffers(1, &mQuadVB);
+    mQuadVB = 0;
+    mShaders.clear();
+}
+
+GLuint SharedResources::program(const ShaderDesc& desc,
+        const ShaderVariantKey& key) {
+    pthread_mutex_lock(&mLock);
+    unsigned int size = mShaders.size();
+    GLuint program = mShaders.get(desc, key);
+    // A program linked in this context is only guaranteed to be usable from
+    // the others once the commands that built it have been flushed.
+    if (mShaders.size() != size)
+        glFlush();
+    pthread_mutex_unlock(&mLock);
+    return program;
+}
+
+void SharedResources::prewarmAllFeatures(const ShaderDesc& desc,
+        const ShaderVariantKey& base) {
+    pthread_mutex_lock(&mLock);
+    mShaders.prewarmAllFeatures(desc, base);
+    pthread_mutex_unlock(&mLock);
+}
+
+void SharedResources::collectPrewarmed(unsigned int maxPrograms) {
+    // Never wait on another view's GL thread for this; it's opportunistic.
+    if (pthread_mutex_trylock(&mLock) != 0)
+        return;
+    mShaders.collectPrewarmed(maxPrograms);
+    pthread_mutex_unlock(&mLock);
+}
+
+static bool appendNames(GLuint** names, unsigned int* count,
+        const GLuint* add, unsigned int numAdd) {
+    if (!numAdd)
+        return true;
+    GLuint* grown = (GLuint*)realloc(*names, (*count + numAdd) * sizeof(GLuint));
+    if (!grown)
+        return false;
+    memcpy(grown + *count, add, numAdd * sizeof(GLuint));
+    *names = grown;
+    *count += numAdd;
+    return true;
+}
+
+void SharedResources::deferDelete(const GLuint* buffers, unsigned int numBuffers,
+        const GLuint* textures, unsigned int numTextures) {
+    pthread_mutex_lock(&mLock);
+    if (!appendNames(&mDeadBuffers, &mNumDeadBuffers, buffers, numBuffers) ||
+            !appendNames(&mDeadTextures, &mNumDeadTextures, textures, numTextures)) {
+        ALOGE("Out of memory deferring deletion; leaking GL objects");
+    }
+    pthread_mutex_unlock(&mLock);
+}
+
+void SharedResources::deferDeleteSync(GLsync sync) {
+    if (!sync)
+        return;
+    pthread_mutex_lock(&mLock);
+    GLsync* grown = (GLsync*)realloc(mDeadSyncs, (mNumDeadSyncs + 1) * sizeof(GLsync));
+    if (grown) {
+        grown[mNumDeadSyncs++] = sync;
+        mDeadSyncs = grown;
+    } else {
+        ALOGE("Out of memory deferring deletion; leaking a sync object");
+    }
+    pthread_mutex_unlock(&mLock);
+}
+
+void SharedResources::collectGarbage() {
+    if (pthread_mutex_trylock(&mLock) != 0)
+        return;
+    if (mNumDeadBuffers) {
+        glDeleteBuffers(mNumDeadBuffers, mDeadBuffers);
+        mNumDeadBuffers = 0;
+    }
+    if (mNumDeadTextures) {
+        glDeleteTextures(mNumDeadTextures, mDeadTextures);
+        mNumDeadTextures = 0;
+    }
+    for (unsigned int i = 0; i < mNumDeadSyncs; i++)
+        glDeleteSync(mDeadSyncs[i]);
+    mNumDeadSyncs = 0;
+    pthread_mutex_unlock(&mLock);
+}
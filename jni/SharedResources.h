@@ -0,0 +1,87 @@
+/*
+ * Copyright 2013 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SHAREDRESOURCES_H
+#define SHAREDRESOURCES_H 1
+
+#include "ShaderVariant.h"
+
+#include <pthread.h>
+
+// ----------------------------------------------------------------------------
+// GL objects shared by every renderer whose context is in the same EGL share
+// group: compiled programs (including compute kernels) and static meshes.
+//
+// Share groups are identified by a number handed out on the Java side
+// (GLES3JNIView.SharedContextFactory), which starts a new group whenever it
+// creates a context while no other one is alive. Renderers for different
+// views run on different GL threads, so everything here is locked.
+//
+// Objects that live in the share group (buffers, textures, syncs) outlive
+// the context that created them. A renderer destroyed while its context is
+// no longer current can't delete them itself, so it hands them to
+// deferDelete() and the next renderer in the group to run a frame deletes
+// them. VAOs are per-context and never shared.
+
+class SharedResources {
+public:
+    // Returns the resources of the share group, creating them in the current
+    // context on first use. Adds a reference. Returns NULL on failure.
+    static SharedResources* acquire(unsigned int shareGroup);
+    // Drops a reference. The last one deletes the shared objects if
+    // contextCurrent is true, i.e. a context of the group is current;
+    // otherwise the group is assumed dead along with its objects.
+    void release(bool contextCurrent);
+
+    // Thread-safe wrappers around the ShaderVariantCache.
+    GLuint program(const ShaderDesc& desc, const ShaderVariantKey& key);
+    void prewarmAllFeatures(const ShaderDesc& desc,
+            const ShaderVariantKey& base);
+    void collectPrewarmed(unsigned int maxPrograms);
+
+    // static unit quad, see QUAD
+    GLuint quadBuffer() const { return mQuadVB; }
+
+    void deferDelete(const GLuint* buffers, unsigned int numBuffers,
+            const GLuint* textures, unsigned int numTextures);
+    void deferDeleteSync(GLsync sync);
+    // Deletes objects queued by deferDelete(). A context of the group must
+    // be current.
+    void collectGarbage();
+
+private:
+    SharedResources(unsigned int shareGroup);
+    ~SharedResources();
+    bool init();
+    void deleteObjects();
+
+    pthread_mutex_t mLock;
+    unsigned int mShareGroup;
+    unsigned int mRefs;
+    SharedResources* mNext;
+
+    ShaderVariantCache mShaders;
+    GLuint mQuadVB;
+
+    GLuint* mDeadBuffers;
+    unsigned int mNumDeadBuffers;
+    GLuint* mDeadTextures;
+    unsigned int mNumDeadTextures;
+    GLsync* mDeadSyncs;
+    unsigned int mNumDeadSyncs;
+};
+
+#endif // SHAREDRESOURCES_H
@@ -0,0 +1,156 @@
+/*
+ * Copyright 2013 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ThreadPool.h"
+#include "gles3jni.h"
+
+#include <unistd.h>
+
+ThreadPool::ThreadPool(unsigned int numThreads)
+:   mNumWorkers(0),
+    mQuit(false),
+    mTask(NULL),
+    mUser(NULL),
+    mNumTasks(0),
+    mGeneration(0),
+    mPending(0),
+    mActive(0),
+    mNextTask(0)
+{
+    pthread_mutex_init(&mJobLock, NULL);
+    pthread_mutex_init(&mLock, NULL);
+    pthread_cond_init(&mWake, NULL);
+    pthread_cond_init(&mDone, NULL);
+    if (numThreads > MAX_THREADS)
+        numThreads = MAX_THREADS;
+    for (unsigned int i = 0; i + 1 < numThreads; i++) {
+        if (pthread_create(&mWorkers[mNumWorkers], NULL, workerMain, this) != 0) {
+            ALOGE("Thread pool: could only start %u of %u workers",
+                    mNumWorkers, numThreads - 1);
+            break;
+        }
+        mNumWorkers++;
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    pthread_mutex_lock(&mLock);
+    mQuit = true;
+    pthread_cond_broadcast(&mWake);
+    pthread_mutex_unlock(&mLock);
+    for (unsigned int i = 0; i < mNumWorkers; i++)
+        pthread_join(mWorkers[i], NULL);
+    pthread_cond_destroy(&mDone);
+    pthread_cond_destroy(&mWake);
+    pthread_mutex_destroy(&mLock);
+    pthread_mutex_destroy(&mJobLock);
+}
+
+static ThreadPool* sShared;
+static pthread_once_t sSharedOnce = PTHREAD_ONCE_INIT;
+
+static void createShared() {
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    sShared = new ThreadPool(cores > 0 ? (unsigned int)cores : 1);
+    ALOGV("Thread pool: %u threads", sShared->threads());
+}
+
+// Lives as long as the process.
+ThreadPool& ThreadPool::shared() {
+    pthread_once(&sSharedOnce, createShared);
+    return *sShared;
+}
+
+void ThreadPool::run(unsigned int numTasks, Task task, void* user) {
+    if (numTasks == 0)
+        return;
+    pthread_mutex_lock(&mJobLock);
+    if (mNumWorkers == 0 || numTasks == 1) {
+        for (unsigned int i = 0; i < numTasks; i++)
+            task(user, i);
+        pthread_mutex_unlock(&mJobLock);
+        return;
+    }
+
+    pthread_mutex_lock(&mLock);
+    // A worker that woke up late for the previous job may still be on its
+    // way out of runTasks(); resetting mNextTask under it would hand it
+    // tasks of this job.
+    while (mActive > 0)
+        pthread_cond_wait(&mDone, &mLock);
+    mTask = task;
+    mUser = user;
+    mNumTasks = numTasks;
+    mPending = numTasks;
+    __atomic_store_n(&mNextTask, 0, __ATOMIC_RELAXED);
+    mGeneration++;
+    pthread_cond_broadcast(&mWake);
+    pthread_mutex_unlock(&mLock);
+
+    runTasks(task, user, numTasks);
+
+    // Workers still inside runTasks() would take tasks of the next job
+    // with this one's function, so wait for them to leave too.
+    pthread_mutex_lock(&mLock);
+    while (mPending > 0 || mActive > 0)
+        pthread_cond_wait(&mDone, &mLock);
+    pthread_mutex_unlock(&mLock);
+    pthread_mutex_unlock(&mJobLock);
+}
+
+void ThreadPool::runTasks(Task task, void* user, unsigned int numTasks) {
+    unsigned int done = 0;
+    for (;;) {
+        unsigned int i = __atomic_fetch_add(&mNextTask, 1, __ATOMIC_RELAXED);
+        if (i >= numTasks)
+            break;
+        task(user, i);
+        done++;
+    }
+    if (done) {
+        pthread_mutex_lock(&mLock);
+        mPending -= done;
+        if (mPending == 0)
+            pthread_cond_broadcast(&mDone);
+        pthread_mutex_unlock(&mLock);
+    }
+}
+
+void* ThreadPool::workerMain(void* arg) {
+    ThreadPool* pool = (ThreadPool*)arg;
+    unsigned int seen = 0;
+    pthread_mutex_lock(&pool->mLock);
+    for (;;) {
+        while (!pool->mQuit && pool->mGeneration == seen)
+            pthread_cond_wait(&pool->mWake, &pool->mLock);
+        if (pool->mQuit)
+            break;
+        seen = pool->mGeneration;
+        Task task = pool->mTask;
+        void* user = pool->mUser;
+        unsigned int numTasks = pool->mNumTasks;
+        pool->mActive++;
+        pthread_mutex_unlock(&pool->mLock);
+
+        pool->runTasks(task, user, numTasks);
+
+        pthread_mutex_lock(&pool->mLock);
+        if (--pool->mActive == 0)
+            pthread_cond_broadcast(&pool->mDone);
+    }
+    pthread_mutex_unlock(&pool->mLock);
+    return NULL;
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright 2013 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H 1
+
+#include <pthread.h>
+
+// ----------------------------------------------------------------------------
+// Worker threads for data-parallel CPU work. run() splits a job into
+// numbered tasks, which the workers and the calling thread take in turn,
+// and returns once all of them are done. Tasks of one job must be
+// independent. Jobs from different threads run one after the other.
+//
+// shared() is created on first use, with as many threads (the caller
+// included) as there are CPU cores, up to MAX_THREADS.
+
+class ThreadPool {
+public:
+    typedef void (*Task)(void* user, unsigned int task);
+
+    enum {MAX_THREADS = 8};
+
+    // numThreads counts the thread calling run(), so 1 starts no workers.
+    explicit ThreadPool(unsigned int numThreads);
+    ~ThreadPool();
+
+    static ThreadPool& shared();
+
+    unsigned int threads() const { return mNumWorkers + 1; }
+    void run(unsigned int numTasks, Task task, void* user);
+
+private:
+    static void* workerMain(void* arg);
+    // Takes tasks of the current job until there are none left.
+    void runTasks(Task task, void* user, unsigned int numTasks);
+
+    // held for the whole of run()
+    pthread_mutex_t mJobLock;
+    pthread_mutex_t mLock;
+    pthread_cond_t mWake;
+    pthread_cond_t mDone;
+    pthread_t mWorkers[MAX_THREADS];
+    unsigned int mNumWorkers;
+    bool mQuit;
+
+    // Current job, under mLock. mGeneration changes with every job, so
+    // workers can tell a new one from the one they just worked on.
+    Task mTask;
+    void* mUser;
+    unsigned int mNumTasks;
+    unsigned int mGeneration;
+    // tasks not finished yet, and workers inside runTasks()
+    unsigned int mPending;
+    unsigned int mActive;
+    // next task to hand out, taken without the lock
+    unsigned int mNextTask;
+};
+
+#endif // THREADPOOL_H
@@ -16,9 +16,22 @@
 
 #include <jni.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 
 #include "gles3jni.h"
+#include "BatchCompute.h"
+#include "BroadPhase.h"
+#include "CommandStream.h"
+#include "ComputeFormat.h"
+#include "ComputeKernels.h"
+#include "DeviceCaps.h"
+#include "GlDebug.h"
+#include "FrameGovernor.h"
+#include "SharedResources.h"
+
+// GPU time per frame for compute job slices, see setComputeSliceBudget()
+#define DEFAULT_SLICE_BUDGET_NS 2000000ull
 
 const Vertex QUAD[4] = {
     // Square with diagonal < 2 so that it fits in a [-1 .. 1]^2 square
@@ -115,38 +128,257 @@ exit:
     return program;
 }
 
-static void printGlString(const char* name, GLenum s) {
-    const char* v = (const char*)glGetString(s);
-    ALOGV("GL %s: %s\n", name, v);
-}
-
 // ----------------------------------------------------------------------------
 
-Renderer::Renderer()
-:   mNumInstances(0),
-    mLastFrameNs(0)
+SimulationState::SimulationState()
+:   numInstances(0),
+    width(0),
+    height(0),
+    lastFrameNs(0),
+    externalInstances(false),
+    editedInstances(false)
+{
+    memset(scale, 0, sizeof(scale));
+    memset(angles, 0, sizeof(angles));
+    memset(angularVelocity, 0, sizeof(angularVelocity));
+    memset(offsets, 0, sizeof(offsets));
+    memset(depths, 0, sizeof(depths));
+    memset(transforms, 0, sizeof(transforms));
+    camera[0] = 0.0f;
+    camera[1] = 0.0f;
+    camera[2] = 1.0f;
+}
+
+Renderer::Renderer(SimulationState* sim)
+:   mGovernor(new FrameGovernor),
+    mCheckLevel(-1),
+    mSim(sim ? sim : new SimulationState),
+    mOwnsSim(!sim),
+    // A new renderer starts with empty buffers, whatever the state says.
+    mInstancesDirty(true),
+    mStaging(NULL),
+    mDepthMode(false),
+    mSortedCount(0),
+    mSortMoves(0),
+    mOverdrawInterval(0),
+    mOverdrawCountdown(0),
+    mOverdrawFrame(false),
+    mHasOverdraw(false),
+    mFrameInstances(0),
+    mBroadPhase(NULL),
+    mBroadPhasePending(false),
+    mNumPairs(0),
+    mCpuCompute(NULL),
+    mSliceBudgetNs(DEFAULT_SLICE_BUDGET_NS)
 {
-    memset(mScale, 0, sizeof(mScale));
-    memset(mAngularVelocity, 0, sizeof(mAngularVelocity));
-    memset(mAngles, 0, sizeof(mAngles));
+    memset(mPending, 0, sizeof(mPending));
+    for (unsigned int i = 0; i < MAX_INSTANCES; i++)
+        mOrder[i] = i;
+    memset(&mOverdraw, 0, sizeof(mOverdraw));
+    // Don't count the time without a renderer, e.g. in the background,
+    // as simulation time.
+    mSim->lastFrameNs = 0;
 }
 
 Renderer::~Renderer() {
+    delete mGovernor;
+    if (mOwnsSim)
+        delete mSim;
+    free(mStaging);
+    delete mBroadPhase;
+    free(mCpuCompute);
 }
 
-void Renderer::resize(int w, int h) {
-    float* offsets = mapOffsetBuf();
-    calcSceneParams(w, h, offsets);
-    unmapOffsetBuf();
+void Renderer::destroyTimerQueries() {
+    mGovernor->destroy();
+}
+
+void Renderer::setFrameBudget(float targetMs, float p99BoundMs) {
+    mGovernor->setBudget(targetMs, p99BoundMs);
+}
 
-    for (unsigned int i = 0; i < mNumInstances; i++) {
-        mAngles[i] = drand48() * TWO_PI;
-        mAngularVelocity[i] = MAX_ROT_SPEED * (2.0*drand48() - 1.0);
+size_t Renderer::formatGovernorLog(char* buf, size_t size) const {
+    return mGovernor->formatLog(buf, size);
+}
+
+unsigned int Renderer::collisionPairs(const uint32_t** pairs) const {
+    *pairs = mPairs;
+    return mNumPairs;
+}
+
+int64_t Renderer::runBatch(const char* inputPath, const char* outputPath) {
+    BatchFiles files;
+    if (!files.open(inputPath, outputPath))
+        return -1;
+    int64_t written;
+    if (!runGpuBatch(files, &written))
+        written = batchComputeCpu(files);
+    return written;
+}
+
+// Turns pairs of slots into pairs of instances, smaller index first.
+static void slotsToInstances(uint32_t* pairs, unsigned int count,
+        const uint16_t* order) {
+    for (unsigned int i = 0; i < count; i++) {
+        uint32_t a = order[pairs[2*i]];
+        uint32_t b = order[pairs[2*i + 1]];
+        pairs[2*i] = a < b ? a : b;
+        pairs[2*i + 1] = a < b ? b : a;
     }
+}
 
-    mLastFrameNs = 0;
+void Renderer::setCollisionPairs(const uint32_t* pairs, unsigned int count,
+        const uint16_t* order) {
+    unsigned int kept = count < MAX_COLLISION_PAIRS ? count : MAX_COLLISION_PAIRS;
+    memcpy(mPairs, pairs, kept * 2 * sizeof(uint32_t));
+    slotsToInstances(mPairs, kept, order);
+    mNumPairs = count;
+}
+
+bool Renderer::setComputeFormats(unsigned int velocity, unsigned int position) {
+    if (velocity >= COMPUTE_FORMAT_COUNT || position >= COMPUTE_FORMAT_COUNT)
+        return false;
+    return useComputeFormats(velocity, position);
+}
 
+bool Renderer::compareComputeFormats(ComputeFormatReport* report) {
+    memset(report, 0, sizeof(*report));
+    return runFormatComparison(report);
+}
+
+unsigned int Renderer::submitComputeJob(unsigned int kernel, unsigned int groupsX,
+        unsigned int groupsY, unsigned int groupsZ) {
+    // Progress counts work groups in 32 bits.
+    if (!groupsX || !groupsY || !groupsZ ||
+            (uint64_t)groupsX * groupsY * groupsZ > 0xffffffffull)
+        return 0;
+    const GLuint groups[3] = {groupsX, groupsY, groupsZ};
+    return queueComputeJob(kernel, groups);
+}
+
+bool Renderer::computeJobProgress(unsigned int job, ComputeJobProgress* progress) const {
+    memset(progress, 0, sizeof(*progress));
+    return job && findComputeJob(job, progress);
+}
+
+void Renderer::setComputeSliceBudget(float ms) {
+    if (ms > 0.0f)
+        mSliceBudgetNs = (uint64_t)(ms * 1000000.0f);
+}
+
+bool Renderer::dispatchStats(DispatchStats* stats) const {
+    memset(stats, 0, sizeof(*stats));
+    return schedulerStats(stats);
+}
+
+void Renderer::setDepthMode(bool enabled) {
+    mDepthMode = enabled;
+}
+
+void Renderer::setOverdrawInterval(unsigned int frames) {
+    mOverdrawInterval = frames;
+    mOverdrawCountdown = 0;
+}
+
+bool Renderer::overdrawStats(OverdrawStats* stats) const {
+    *stats = mOverdraw;
+    return mHasOverdraw;
+}
+
+void Renderer::setOverdrawCounts(uint64_t shaded, uint64_t covered,
+        uint64_t pixels) {
+    mOverdraw.shadedPerCovered = covered ? (float)shaded / covered : 0.0f;
+    mOverdraw.coverage = pixels ? (float)covered / pixels : 0.0f;
+    mOverdraw.sortMoves = mSortMoves;
+    mSortMoves = 0;
+    mHasOverdraw = true;
+    RLOGV("Overdraw: %.2f fragments per covered pixel, %.0f%% covered, "
+            "%u sort moves", mOverdraw.shadedPerCovered,
+            100.0f * mOverdraw.coverage, mOverdraw.sortMoves);
+}
+
+bool Renderer::runCpuKernel(unsigned int kernel, const uint32_t groups[3]) {
+    if (kernel != KERNEL_VELOCITY_TO_POSITION)
+        return false;
+    if (!mCpuCompute) {
+        mCpuCompute = (float*)malloc(2 * COMPUTE_POINTS * 4 * sizeof(float));
+        if (!mCpuCompute) {
+            ALOGE("Out of memory for CPU compute buffers");
+            return true;
+        }
+        initComputeVelocities(mCpuCompute, COMPUTE_POINTS);
+    }
+    // The kernel runs on the GL thread, so like RendererES3 it only runs
+    // the work groups that cover the buffers; more would only rewrite the
+    // same points.
+    const uint32_t localSize = VELOCITY_TO_POSITION_KERNEL.localSize[0];
+    const uint32_t maxGroups = (COMPUTE_POINTS + localSize - 1) / localSize;
+    uint32_t clamped[3] = {groups[0], groups[1], groups[2]};
+    if ((uint64_t)groups[0] * groups[1] * groups[2] > maxGroups) {
+        RLOGW("Clamping CPU kernel %u from %ux%ux%u to %u work groups",
+                kernel, groups[0], groups[1], groups[2], maxGroups);
+        clamped[0] = groups[0] < maxGroups ? groups[0] : maxGroups;
+        clamped[1] = clamped[2] = 1;
+    }
+    // DEBUG_IDS is on in the default variant, which the GPU runs.
+    VelocityToPositionArgs args = {
+        mCpuCompute, mCpuCompute + COMPUTE_POINTS * 4, COMPUTE_POINTS, true,
+    };
+    if (!cpuDispatch(VELOCITY_TO_POSITION_KERNEL, clamped, &args))
+        ALOGE("Out of memory running CPU kernel %u", kernel);
+    return true;
+}
+
+const float* Renderer::frameBounds() {
+    const SimulationState& sim = *mSim;
+    for (unsigned int k = 0; k < mFrameInstances; k++) {
+        const unsigned int i = mOrder[k];
+        float transform[4];
+        const float* t = sim.transforms + 4*i;
+        // Built-in transforms only go to the GL buffer, see step().
+        if (!sim.externalInstances) {
+            float s = sinf(sim.angles[i]);
+            float c = cosf(sim.angles[i]);
+            transform[0] =  c * sim.scale[0];
+            transform[1] =  s * sim.scale[1];
+            transform[2] = -s * sim.scale[0];
+            transform[3] =  c * sim.scale[1];
+            t = transform;
+        }
+        instanceBounds(sim.offsets + 2*i, t, mBounds + 4*k);
+    }
+    return mBounds;
+}
+
+float Renderer::renderScale() const {
+    return mGovernor->level().resolutionScale;
+}
+
+void Renderer::resize(int w, int h) {
     glViewport(0, 0, w, h);
+    // A renderer for a new context usually gets the size the scene was laid
+    // out for, and keeps the scene as it is. App-supplied and spawned
+    // instances are never laid out, the app decides where things go.
+    bool changed = w != mSim->width || h != mSim->height;
+    mSim->width = w;
+    mSim->height = h;
+    if (changed && !mSim->externalInstances && !mSim->editedInstances)
+        layoutScene();
+}
+
+void Renderer::layoutScene() {
+    SimulationState& sim = *mSim;
+    calcSceneParams(sim.width, sim.height, sim.offsets);
+
+    for (unsigned int i = 0; i < sim.numInstances; i++) {
+        sim.angles[i] = drand48() * TWO_PI;
+        sim.angularVelocity[i] = MAX_ROT_SPEED * (2.0*drand48() - 1.0);
+        sim.depths[i] = drand48();
+    }
+
+    sim.lastFrameNs = 0;
+    sim.editedInstances = false;
+    mInstancesDirty = true;
 }
 
 void Renderer::calcSceneParams(unsigned int w, unsigned int h,
@@ -185,98 +417,528 @@ void Renderer::calcSceneParams(unsigned int w, unsigned int h,
         }
     }
 
-    mNumInstances = ncells[0] * ncells[1];
-    mScale[major] = 0.5f * CELL_SIZE * scene2clip[0];
-    mScale[minor] = 0.5f * CELL_SIZE * scene2clip[1];
+    mSim->numInstances = ncells[0] * ncells[1];
+    mSim->scale[major] = 0.5f * CELL_SIZE * scene2clip[0];
+    mSim->scale[minor] = 0.5f * CELL_SIZE * scene2clip[1];
+}
+
+void Renderer::uploadInstances() {
+    const SimulationState& sim = *mSim;
+    float* offsets = mapOffsetBuf();
+    if (offsets) {
+        for (unsigned int k = 0; k < sim.numInstances; k++)
+            memcpy(offsets + 2*k, sim.offsets + 2*mOrder[k], 2 * sizeof(float));
+    }
+    unmapOffsetBuf();
+    // Built-in transforms are rebuilt by every step().
+    if (sim.externalInstances) {
+        float* transforms = mapTransformBuf();
+        if (transforms) {
+            for (unsigned int k = 0; k < sim.numInstances; k++) {
+                memcpy(transforms + 4*k, sim.transforms + 4*mOrder[k],
+                        4 * sizeof(float));
+            }
+        }
+        unmapTransformBuf();
+    }
+    mInstancesDirty = false;
+}
+
+bool Renderer::updateDrawOrder(unsigned int count) {
+    bool changed = false;
+    if (mSortedCount && (!mDepthMode || count != mSortedCount)) {
+        for (unsigned int k = 0; k < mSortedCount; k++)
+            mOrder[k] = k;
+        mSortedCount = 0;
+        changed = true;
+    }
+    if (!mDepthMode)
+        return changed;
+
+    // Insertion sort, starting from last frame's order. Depths rarely
+    // change much between frames, so this is close to linear.
+    const float* depths = mSim->depths;
+    for (unsigned int k = 1; k < count; k++) {
+        const uint16_t instance = mOrder[k];
+        const float depth = depths[instance];
+        unsigned int j = k;
+        while (j > 0 && depths[mOrder[j - 1]] > depth) {
+            mOrder[j] = mOrder[j - 1];
+            j--;
+        }
+        if (j != k) {
+            mOrder[j] = instance;
+            mSortMoves += k - j;
+            changed = true;
+        }
+    }
+    mSortedCount = count;
+    return changed;
 }
 
-void Renderer::step() {
+void Renderer::step(unsigned int numInstances) {
+    SimulationState& sim = *mSim;
     timespec now;
     clock_gettime(CLOCK_MONOTONIC, &now);
     uint64_t nowNs = now.tv_sec*1000000000ull + now.tv_nsec;
 
-    if (mLastFrameNs > 0) {
-        float dt = float(nowNs - mLastFrameNs) * 0.000000001f;
+    if (sim.lastFrameNs > 0) {
+        float dt = float(nowNs - sim.lastFrameNs) * 0.000000001f;
 
-        for (unsigned int i = 0; i < mNumInstances; i++) {
-            mAngles[i] += mAngularVelocity[i] * dt;
-            if (mAngles[i] >= TWO_PI) {
-                mAngles[i] -= TWO_PI;
-            } else if (mAngles[i] <= -TWO_PI) {
-                mAngles[i] += TWO_PI;
+        for (unsigned int k = 0; k < numInstances; k++) {
+            const unsigned int i = mOrder[k];
+            sim.angles[i] += sim.angularVelocity[i] * dt;
+            if (sim.angles[i] >= TWO_PI) {
+                sim.angles[i] -= TWO_PI;
+            } else if (sim.angles[i] <= -TWO_PI) {
+                sim.angles[i] += TWO_PI;
             }
         }
+    }
 
-        float* transforms = mapTransformBuf();
-        for (unsigned int i = 0; i < mNumInstances; i++) {
-            float s = sinf(mAngles[i]);
-            float c = cosf(mAngles[i]);
-            transforms[4*i + 0] =  c * mScale[0];
-            transforms[4*i + 1] =  s * mScale[1];
-            transforms[4*i + 2] = -s * mScale[0];
-            transforms[4*i + 3] =  c * mScale[1];
+    // Written even on the first frame, which has nothing to integrate, so a
+    // fresh buffer never gets drawn.
+    float* transforms = mapTransformBuf();
+    for (unsigned int k = 0; k < numInstances; k++) {
+        const unsigned int i = mOrder[k];
+        float s = sinf(sim.angles[i]);
+        float c = cosf(sim.angles[i]);
+        transforms[4*k + 0] =  c * sim.scale[0];
+        transforms[4*k + 1] =  s * sim.scale[1];
+        transforms[4*k + 2] = -s * sim.scale[0];
+        transforms[4*k + 3] =  c * sim.scale[1];
+    }
+    unmapTransformBuf();
+
+    sim.lastFrameNs = nowNs;
+}
+
+float* Renderer::beginInstanceUpdate(InstanceStream stream) {
+    if (mPending[stream])
+        return mPending[stream];
+
+    // Java always writes to the staging arena, which is the CPU copy of the
+    // data. Handing out the GL buffer instead would let a render before
+    // commitInstances() draw a half-written frame, and the copy kept in
+    // the simulation state would have to be read back from the mapping.
+    if (!mStaging) {
+        mStaging = (float*)malloc(MAX_INSTANCES * (4 + 2 + 1) * sizeof(float));
+        if (!mStaging) {
+            ALOGE("Out of memory allocating instance staging arena");
+            return NULL;
         }
-        unmapTransformBuf();
     }
+    static const unsigned int STAGING_OFFSETS[INSTANCE_STREAM_COUNT] = {
+        0, MAX_INSTANCES * 4, MAX_INSTANCES * (4 + 2),
+    };
+    mPending[stream] = mStaging + STAGING_OFFSETS[stream];
+    mSim->externalInstances = true;
+    return mPending[stream];
+}
+
+void Renderer::commitInstances(unsigned int count) {
+    SimulationState& sim = *mSim;
+    if (count > MAX_INSTANCES)
+        count = MAX_INSTANCES;
+
+    // Committed data is also kept in the simulation state, so that a
+    // renderer for a new context can restore it.
+    // In depth mode render() uploads everything once the order is sorted.
+    if (mPending[INSTANCE_TRANSFORMS]) {
+        memcpy(sim.transforms, mPending[INSTANCE_TRANSFORMS],
+                count * 4 * sizeof(float));
+        if (!mDepthMode) {
+            float* transforms = mapTransformBuf();
+            if (transforms) {
+                memcpy(transforms, mPending[INSTANCE_TRANSFORMS],
+                        count * 4 * sizeof(float));
+            }
+            unmapTransformBuf();
+        }
+    }
+    if (mPending[INSTANCE_OFFSETS]) {
+        memcpy(sim.offsets, mPending[INSTANCE_OFFSETS], count * 2 * sizeof(float));
+        if (!mDepthMode) {
+            float* offsets = mapOffsetBuf();
+            if (offsets)
+                memcpy(offsets, sim.offsets, count * 2 * sizeof(float));
+            unmapOffsetBuf();
+        }
+    }
+    if (mPending[INSTANCE_DEPTHS])
+        memcpy(sim.depths, mPending[INSTANCE_DEPTHS], count * sizeof(float));
+    memset(mPending, 0, sizeof(mPending));
+    if (mDepthMode)
+        mInstancesDirty = true;
+
+    sim.externalInstances = true;
+    sim.numInstances = count;
+}
 
-    mLastFrameNs = nowNs;
+void Renderer::resetInstances() {
+    if (!mSim->externalInstances)
+        return;
+    mSim->externalInstances = false;
+    memset(mPending, 0, sizeof(mPending));
+    if (mSim->width > 0 && mSim->height > 0)
+        layoutScene();
 }
 
 void Renderer::render() {
-    step();
+    if (mCheckLevel != glCheckLevel())
+        mCheckLevel = applyGlCheckLevel();
+    mGovernor->beginFrame();
+
+    if (updateDrawOrder(mSim->numInstances))
+        mInstancesDirty = true;
+    if (mInstancesDirty)
+        uploadInstances();
+
+    // App-supplied instances are drawn exactly as committed; the governor
+    // only thins out the built-in animation, from the back in depth mode.
+    unsigned int numInstances = mSim->numInstances;
+    if (!mSim->externalInstances) {
+        numInstances = mGovernor->scaleInstances(numInstances);
+        step(numInstances);
+    }
+    mFrameInstances = numInstances;
+
+    if (mBroadPhasePending) {
+        mBroadPhasePending = false;
+        if (!mBroadPhase)
+            mBroadPhase = new BroadPhaseCpu;
+        const float* bounds = frameBounds();
+        mNumPairs = mBroadPhase->findPairs(bounds, numInstances,
+                broadPhaseGrid(bounds, numInstances), mPairs, MAX_COLLISION_PAIRS);
+        slotsToInstances(mPairs, mNumPairs < MAX_COLLISION_PAIRS ?
+                mNumPairs : MAX_COLLISION_PAIRS, mOrder);
+    }
+
+    mOverdrawFrame = false;
+    if (mOverdrawInterval && mOverdrawCountdown-- == 0) {
+        mOverdrawFrame = true;
+        mOverdrawCountdown = mOverdrawInterval - 1;
+    }
 
+    beginScene(renderScale());
     glClearColor(0.2f, 0.2f, 0.3f, 1.0f);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-    draw(mNumInstances);
-    checkGlError("Renderer::render");
+    draw(numInstances);
+    endScene();
+    if (GL_CHECK_MAX_LEVEL >= GL_CHECK_FRAME && mCheckLevel >= GL_CHECK_FRAME)
+        checkGlError("Renderer::render");
+
+    mGovernor->endFrame();
 }
 
 // ----------------------------------------------------------------------------
 
-static Renderer* g_renderer = NULL;
+// Renderers are handed to Java as opaque handles, one per GLES3JNIView.
+// Each is only ever used on its view's GL thread.
+static inline Renderer* fromHandle(jlong handle) {
+    return (Renderer*)(intptr_t)handle;
+}
+
+// Simulation state handles belong to the view too, and outlive its contexts.
+static inline SimulationState* simFromHandle(jlong handle) {
+    return (SimulationState*)(intptr_t)handle;
+}
 
 extern "C" {
-    JNIEXPORT void JNICALL Java_com_android_gles3jni_GLES3JNILib_init(JNIEnv* env, jobject obj);
-    JNIEXPORT void JNICALL Java_com_android_gles3jni_GLES3JNILib_resize(JNIEnv* env, jobject obj, jint width, jint height);
-    JNIEXPORT void JNICALL Java_com_android_gles3jni_GLES3JNILib_step(JNIEnv* env, jobject obj);
+    JNIEXPORT void JNICALL Java_com_android_gles3jni_GLES3JNILib_setCacheDir(JNIEnv* env, jobject obj, jstring path);
+    JNIEXPORT void JNICALL Java_com_android_gles3jni_GLES3JNILib_setGlCheckLevel(JNIEnv* env, jobject obj, jint level);
+    JNIEXPORT jlong JNICALL Java_com_android_gles3jni_GLES3JNILib_createSimulation(JNIEnv* env, jobject obj);
+    JNIEXPORT void JNICALL Java_com_android_gles3jni_GLES3JNILib_destroySimulation(JNIEnv* env, jobject obj, jlong simulation);
+    JNIEXPORT jlong JNICALL Java_com_android_gles3jni_GLES3JNILib_create(JNIEnv* env, jobject obj, jint shareGroup, jlong simulation);
+    JNIEXPORT void JNICALL Java_com_android_gles3jni_GLES3JNILib_destroy(JNIEnv* env, jobject obj, jlong handle);
+    JNIEXPORT void JNICALL Java_com_android_gles3jni_GLES3JNILib_resize(JNIEnv* env, jobject obj, jlong handle, jint width, jint height);
+    JNIEXPORT void JNICALL Java_com_android_gles3jni_GLES3JNILib_step(JNIEnv* env, jobject obj, jlong handle);
+    JNIEXPORT void JNICALL Java_com_android_gles3jni_GLES3JNILib_stepWithCommands(JNIEnv* env, jobject obj, jlong handle, jobject commands, jint length);
+    JNIEXPORT jobject JNICALL Java_com_android_gles3jni_GLES3JNILib_mapInstances(JNIEnv* env, jobject obj, jlong handle, jint stream);
+    JNIEXPORT void JNICALL Java_com_android_gles3jni_GLES3JNILib_commitInstances(JNIEnv* env, jobject obj, jlong handle, jint count);
+    JNIEXPORT void JNICALL Java_com_android_gles3jni_GLES3JNILib_resetInstances(JNIEnv* env, jobject obj, jlong handle);
+    JNIEXPORT void JNICALL Java_com_android_gles3jni_GLES3JNILib_setFrameBudget(JNIEnv* env, jobject obj, jlong handle, jfloat targetMs, jfloat p99BoundMs);
+    JNIEXPORT jstring JNICALL Java_com_android_gles3jni_GLES3JNILib_getGovernorLog(JNIEnv* env, jobject obj, jlong handle);
+    JNIEXPORT jint JNICALL Java_com_android_gles3jni_GLES3JNILib_getCollisionPairs(JNIEnv* env, jobject obj, jlong handle, jintArray pairs);
+    JNIEXPORT jlong JNICALL Java_com_android_gles3jni_GLES3JNILib_runBatch(JNIEnv* env, jobject obj, jlong handle, jstring input, jstring output);
+    JNIEXPORT void JNICALL Java_com_android_gles3jni_GLES3JNILib_setDepthMode(JNIEnv* env, jobject obj, jlong handle, jboolean enabled);
+    JNIEXPORT void JNICALL Java_com_android_gles3jni_GLES3JNILib_setOverdrawInterval(JNIEnv* env, jobject obj, jlong handle, jint frames);
+    JNIEXPORT jboolean JNICALL Java_com_android_gles3jni_GLES3JNILib_getOverdrawStats(JNIEnv* env, jobject obj, jlong handle, jfloatArray stats);
+    JNIEXPORT jboolean JNICALL Java_com_android_gles3jni_GLES3JNILib_setComputeFormats(JNIEnv* env, jobject obj, jlong handle, jint velocity, jint position);
+    JNIEXPORT jstring JNICALL Java_com_android_gles3jni_GLES3JNILib_getComputeFormatReport(JNIEnv* env, jobject obj, jlong handle);
+    JNIEXPORT jint JNICALL Java_com_android_gles3jni_GLES3JNILib_submitComputeJob(JNIEnv* env, jobject obj, jlong handle, jint kernel, jint groupsX, jint groupsY, jint groupsZ);
+    JNIEXPORT jboolean JNICALL Java_com_android_gles3jni_GLES3JNILib_getComputeJobProgress(JNIEnv* env, jobject obj, jlong handle, jint job, jfloatArray progress);
+    JNIEXPORT void JNICALL Java_com_android_gles3jni_GLES3JNILib_setComputeSliceBudget(JNIEnv* env, jobject obj, jlong handle, jfloat ms);
+    JNIEXPORT jboolean JNICALL Java_com_android_gles3jni_GLES3JNILib_getDispatchStats(JNIEnv* env, jobject obj, jlong handle, jfloatArray stats);
 };
 
-#if !defined(DYNAMIC_ES3)
-static GLboolean gl3stubInit() {
-    return GL_TRUE;
+JNIEXPORT void JNICALL
+Java_com_android_gles3jni_GLES3JNILib_setCacheDir(JNIEnv* env, jobject obj, jstring path) {
+    const char* dir = path ? env->GetStringUTFChars(path, NULL) : NULL;
+    setDeviceCapsCacheDir(dir);
+    if (dir)
+        env->ReleaseStringUTFChars(path, dir);
+}
+
+JNIEXPORT void JNICALL
+Java_com_android_gles3jni_GLES3JNILib_setGlCheckLevel(JNIEnv* env, jobject obj, jint level) {
+    setGlCheckLevel(level);
+}
+
+JNIEXPORT jlong JNICALL
+Java_com_android_gles3jni_GLES3JNILib_createSimulation(JNIEnv* env, jobject obj) {
+    return (jlong)(intptr_t)new SimulationState;
+}
+
+JNIEXPORT void JNICALL
+Java_com_android_gles3jni_GLES3JNILib_destroySimulation(JNIEnv* env, jobject obj, jlong simulation) {
+    delete simFromHandle(simulation);
+}
+
+JNIEXPORT jlong JNICALL
+Java_com_android_gles3jni_GLES3JNILib_create(JNIEnv* env, jobject obj, jint shareGroup, jlong simulation) {
+    Renderer* renderer = NULL;
+    SharedResources* shared = SharedResources::acquire(shareGroup);
+    if (shared) {
+        if (hasGlCaps(GLCAP_ES30))
+            renderer = createES3Renderer(shared, simFromHandle(simulation));
+        else
+            renderer = createES2Renderer(shared, simFromHandle(simulation));
+    }
+    return (jlong)(intptr_t)renderer;
+}
+
+JNIEXPORT void JNICALL
+Java_com_android_gles3jni_GLES3JNILib_destroy(JNIEnv* env, jobject obj, jlong handle) {
+    delete fromHandle(handle);
+    // The process may be killed at any point once the view is gone.
+    ringLogFlush();
+}
+
+JNIEXPORT void JNICALL
+Java_com_android_gles3jni_GLES3JNILib_resize(JNIEnv* env, jobject obj, jlong handle, jint width, jint height) {
+    Renderer* renderer = fromHandle(handle);
+    if (renderer) {
+        renderer->resize(width, height);
+    }
+}
+
+JNIEXPORT void JNICALL
+Java_com_android_gles3jni_GLES3JNILib_step(JNIEnv* env, jobject obj, jlong handle) {
+    Renderer* renderer = fromHandle(handle);
+    if (renderer) {
+        renderer->render();
+    }
+}
+
+JNIEXPORT void JNICALL
+Java_com_android_gles3jni_GLES3JNILib_stepWithCommands(JNIEnv* env, jobject obj, jlong handle, jobject commands, jint length) {
+    Renderer* renderer = fromHandle(handle);
+    if (!renderer)
+        return;
+    if (commands && length > 0) {
+        void* data = env->GetDirectBufferAddress(commands);
+        jlong capacity = env->GetDirectBufferCapacity(commands);
+        if (data && length <= capacity) {
+            renderer->executeCommands(data, length);
+        } else {
+            ALOGE("stepWithCommands: need a direct buffer of at least %d bytes", length);
+        }
+    }
+    renderer->render();
+}
+
+JNIEXPORT jobject JNICALL
+Java_com_android_gles3jni_GLES3JNILib_mapInstances(JNIEnv* env, jobject obj, jlong handle, jint stream) {
+    Renderer* renderer = fromHandle(handle);
+    if (!renderer || stream < 0 || stream >= Renderer::INSTANCE_STREAM_COUNT)
+        return NULL;
+    float* data = renderer->beginInstanceUpdate((Renderer::InstanceStream)stream);
+    if (!data)
+        return NULL;
+    static const jlong FLOATS_PER_INSTANCE[Renderer::INSTANCE_STREAM_COUNT] = {4, 2, 1};
+    const jlong floatsPerInstance = FLOATS_PER_INSTANCE[stream];
+    return env->NewDirectByteBuffer(data,
+            MAX_INSTANCES * floatsPerInstance * sizeof(float));
+}
+
+JNIEXPORT void JNICALL
+Java_com_android_gles3jni_GLES3JNILib_commitInstances(JNIEnv* env, jobject obj, jlong handle, jint count) {
+    Renderer* renderer = fromHandle(handle);
+    if (renderer && count >= 0) {
+        renderer->commitInstances(count);
+    }
+}
+
+JNIEXPORT void JNICALL
+Java_com_android_gles3jni_GLES3JNILib_resetInstances(JNIEnv* env, jobject obj, jlong handle) {
+    Renderer* renderer = fromHandle(handle);
+    if (renderer) {
+        renderer->resetInstances();
+    }
 }
-#endif
 
 JNIEXPORT void JNICALL
-Java_com_android_gles3jni_GLES3JNILib_init(JNIEnv* env, jobject obj) {
-    if (g_renderer) {
-        delete g_renderer;
-        g_renderer = NULL;
+Java_com_android_gles3jni_GLES3JNILib_setFrameBudget(JNIEnv* env, jobject obj, jlong handle, jfloat targetMs, jfloat p99BoundMs) {
+    Renderer* renderer = fromHandle(handle);
+    if (renderer) {
+        renderer->setFrameBudget(targetMs, p99BoundMs);
+    }
+}
+
+JNIEXPORT jstring JNICALL
+Java_com_android_gles3jni_GLES3JNILib_getGovernorLog(JNIEnv* env, jobject obj, jlong handle) {
+    Renderer* renderer = fromHandle(handle);
+    if (!renderer)
+        return NULL;
+    size_t size = renderer->formatGovernorLog(NULL, 0) + 1;
+    char* log = (char*)malloc(size);
+    if (!log)
+        return NULL;
+    renderer->formatGovernorLog(log, size);
+    jstring str = env->NewStringUTF(log);
+    free(log);
+    return str;
+}
+
+JNIEXPORT jint JNICALL
+Java_com_android_gles3jni_GLES3JNILib_getCollisionPairs(JNIEnv* env, jobject obj, jlong handle, jintArray pairs) {
+    Renderer* renderer = fromHandle(handle);
+    if (!renderer)
+        return 0;
+    const uint32_t* found;
+    unsigned int count = renderer->collisionPairs(&found);
+    if (pairs) {
+        jsize length = env->GetArrayLength(pairs);
+        unsigned int kept = count < MAX_COLLISION_PAIRS ? count : MAX_COLLISION_PAIRS;
+        if ((jsize)(2 * kept) < length)
+            length = 2 * kept;
+        env->SetIntArrayRegion(pairs, 0, length, (const jint*)found);
     }
+    return count;
+}
 
-    printGlString("Version", GL_VERSION);
-    printGlString("Vendor", GL_VENDOR);
-    printGlString("Renderer", GL_RENDERER);
-    printGlString("Extensions", GL_EXTENSIONS);
+JNIEXPORT jlong JNICALL
+Java_com_android_gles3jni_GLES3JNILib_runBatch(JNIEnv* env, jobject obj, jlong handle, jstring input, jstring output) {
+    Renderer* renderer = fromHandle(handle);
+    if (!renderer || !input || !output)
+        return -1;
+    const char* inputPath = env->GetStringUTFChars(input, NULL);
+    const char* outputPath = env->GetStringUTFChars(output, NULL);
+    jlong written = -1;
+    if (inputPath && outputPath)
+        written = renderer->runBatch(inputPath, outputPath);
+    if (inputPath)
+        env->ReleaseStringUTFChars(input, inputPath);
+    if (outputPath)
+        env->ReleaseStringUTFChars(output, outputPath);
+    return written;
+}
 
-    const char* versionStr = (const char*)glGetString(GL_VERSION);
-    if (strstr(versionStr, "OpenGL ES 3.") && gl3stubInit()) {
-        g_renderer = createES3Renderer();
-    } else {
-        ALOGE("Unsupported OpenGL ES version");
+JNIEXPORT void JNICALL
+Java_com_android_gles3jni_GLES3JNILib_setDepthMode(JNIEnv* env, jobject obj, jlong handle, jboolean enabled) {
+    Renderer* renderer = fromHandle(handle);
+    if (renderer) {
+        renderer->setDepthMode(enabled);
     }
 }
 
 JNIEXPORT void JNICALL
-Java_com_android_gles3jni_GLES3JNILib_resize(JNIEnv* env, jobject obj, jint width, jint height) {
-    if (g_renderer) {
-        g_renderer->resize(width, height);
+Java_com_android_gles3jni_GLES3JNILib_setOverdrawInterval(JNIEnv* env, jobject obj, jlong handle, jint frames) {
+    Renderer* renderer = fromHandle(handle);
+    if (renderer) {
+        renderer->setOverdrawInterval(frames > 0 ? frames : 0);
     }
 }
 
+JNIEXPORT jboolean JNICALL
+Java_com_android_gles3jni_GLES3JNILib_getOverdrawStats(JNIEnv* env, jobject obj, jlong handle, jfloatArray stats) {
+    Renderer* renderer = fromHandle(handle);
+    Renderer::OverdrawStats overdraw;
+    if (!renderer || !stats || !renderer->overdrawStats(&overdraw))
+        return JNI_FALSE;
+    const jfloat values[] = {
+        overdraw.shadedPerCovered, overdraw.coverage, (jfloat)overdraw.sortMoves,
+    };
+    jsize length = env->GetArrayLength(stats);
+    if (length > (jsize)(sizeof(values) / sizeof(values[0])))
+        length = sizeof(values) / sizeof(values[0]);
+    env->SetFloatArrayRegion(stats, 0, length, values);
+    return JNI_TRUE;
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_android_gles3jni_GLES3JNILib_setComputeFormats(JNIEnv* env, jobject obj, jlong handle, jint velocity, jint position) {
+    Renderer* renderer = fromHandle(handle);
+    if (!renderer || velocity < 0 || position < 0)
+        return JNI_FALSE;
+    return renderer->setComputeFormats(velocity, position) ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT jstring JNICALL
+Java_com_android_gles3jni_GLES3JNILib_getComputeFormatReport(JNIEnv* env, jobject obj, jlong handle) {
+    Renderer* renderer = fromHandle(handle);
+    ComputeFormatReport report;
+    if (!renderer || !renderer->compareComputeFormats(&report))
+        return NULL;
+    size_t size = formatComputeFormatReport(report, NULL, 0) + 1;
+    char* csv = (char*)malloc(size);
+    if (!csv)
+        return NULL;
+    formatComputeFormatReport(report, csv, size);
+    jstring str = env->NewStringUTF(csv);
+    free(csv);
+    return str;
+}
+
+JNIEXPORT jint JNICALL
+Java_com_android_gles3jni_GLES3JNILib_submitComputeJob(JNIEnv* env, jobject obj, jlong handle, jint kernel, jint groupsX, jint groupsY, jint groupsZ) {
+    Renderer* renderer = fromHandle(handle);
+    if (!renderer || kernel < 0 || groupsX <= 0 || groupsY <= 0 || groupsZ <= 0)
+        return 0;
+    return (jint)renderer->submitComputeJob(kernel, groupsX, groupsY, groupsZ);
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_android_gles3jni_GLES3JNILib_getComputeJobProgress(JNIEnv* env, jobject obj, jlong handle, jint job, jfloatArray progress) {
+    Renderer* renderer = fromHandle(handle);
+    Renderer::ComputeJobProgress p;
+    if (!renderer || !progress || !renderer->computeJobProgress((unsigned int)job, &p))
+        return JNI_FALSE;
+    const jfloat total = (jfloat)p.groupsTotal;
+    const jfloat values[] = {
+        p.groupsDone / total, p.groupsIssued / total, (jfloat)p.slices,
+        p.gpuNs / 1000000.0f, p.finished ? 1.0f : 0.0f,
+    };
+    jsize length = env->GetArrayLength(progress);
+    if (length > (jsize)(sizeof(values) / sizeof(values[0])))
+        length = sizeof(values) / sizeof(values[0]);
+    env->SetFloatArrayRegion(progress, 0, length, values);
+    return JNI_TRUE;
+}
+
 JNIEXPORT void JNICALL
-Java_com_android_gles3jni_GLES3JNILib_step(JNIEnv* env, jobject obj) {
-    if (g_renderer) {
-        g_renderer->render();
+Java_com_android_gles3jni_GLES3JNILib_setComputeSliceBudget(JNIEnv* env, jobject obj, jlong handle, jfloat ms) {
+    Renderer* renderer = fromHandle(handle);
+    if (renderer) {
+        renderer->setComputeSliceBudget(ms);
     }
 }
+
+JNIEXPORT jboolean JNICALL
+Java_com_android_gles3jni_GLES3JNILib_getDispatchStats(JNIEnv* env, jobject obj, jlong handle, jfloatArray stats) {
+    Renderer* renderer = fromHandle(handle);
+    Renderer::DispatchStats d;
+    if (!renderer || !stats || !renderer->dispatchStats(&d))
+        return JNI_FALSE;
+    const jfloat values[] = {
+        (jfloat)d.dispatches, (jfloat)d.batches,
+        d.checkedBatches ? (jfloat)d.overlappedBatches / d.checkedBatches : 0.0f,
+        (jfloat)d.dropped,
+    };
+    jsize length = env->GetArrayLength(stats);
+    if (length > (jsize)(sizeof(values) / sizeof(values[0])))
+        length = sizeof(values) / sizeof(values[0]);
+    env->SetFloatArrayRegion(stats, 0, length, values);
+    return JNI_TRUE;
+}
@@ -20,25 +20,28 @@
 #include <android/log.h>
 #include <math.h>
 
-#if DYNAMIC_ES3
-#include "gl3stub.h"
-#else
-#define GL_GLEXT_PROTOTYPES
-#include <GLES3/gl3.h>
-#include <GLES2/gl2ext.h>
-#include <GLES3/gl31.h>
-#endif
+#include "GlLoader.h"
 
+#ifndef DEBUG
+#ifdef NDEBUG
+#define DEBUG 0
+#else
 #define DEBUG 1
+#endif
+#endif
 
 #define LOG_TAG "GLES3JNI"
 #define ALOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
 #if DEBUG
 #define ALOGV(...) __android_log_print(ANDROID_LOG_VERBOSE, LOG_TAG, __VA_ARGS__)
 #else
-#define ALOGV(...)
+// Still type-checks the arguments, and keeps them referenced.
+#define ALOGV(...) \
+    do { if (0) __android_log_print(ANDROID_LOG_VERBOSE, LOG_TAG, __VA_ARGS__); } while (0)
 #endif
 
+#include "RingLog.h"
+
 // ----------------------------------------------------------------------------
 // Types, functions, and data used by both ES2 and ES3 renderers.
 // Defined in gles3jni.cpp.
@@ -47,6 +50,8 @@
 #define MAX_INSTANCES   (MAX_INSTANCES_PER_SIDE * MAX_INSTANCES_PER_SIDE)
 #define TWO_PI          (2.0 * M_PI)
 #define MAX_ROT_SPEED   (0.3 * TWO_PI)
+// collision pairs kept per broad phase run, see Renderer::collisionPairs()
+#define MAX_COLLISION_PAIRS 4096
 
 // This demo uses three coordinate spaces:
 // - The model (a quad) is in a [-1 .. 1]^2 space
@@ -71,17 +76,229 @@ extern bool checkGlError(const char* funcName);
 extern GLuint createShader(GLenum shaderType, const char* src);
 extern GLuint createProgram(const char* vtxSrc, const char* fragSrc);
 
+// ----------------------------------------------------------------------------
+// CPU-side state of the scene: the built-in animation, app-supplied instance
+// data and the camera. It is owned by the view rather than the renderer,
+// which is tied to a GL context. When the context is lost, the renderer for
+// the new one uploads the same state and carries on where the old one
+// stopped.
+
+struct SimulationState {
+    SimulationState();
+
+    unsigned int numInstances;
+    // surface size the built-in layout was computed for
+    int width, height;
+    float scale[2];
+    float angles[MAX_INSTANCES];
+    float angularVelocity[MAX_INSTANCES];
+    float offsets[MAX_INSTANCES * 2];
+    // in [0, 1], 0 nearest; only used in depth mode, see
+    // Renderer::setDepthMode()
+    float depths[MAX_INSTANCES];
+    // last committed app-supplied transforms, see commitInstances()
+    float transforms[MAX_INSTANCES * 4];
+    float camera[3];
+    uint64_t lastFrameNs;
+    bool externalInstances;
+    // Instances were spawned or killed by commands, so the built-in layout
+    // no longer describes the scene and resizing keeps it as it is.
+    bool editedInstances;
+};
+
 // ----------------------------------------------------------------------------
 // Interface to the ES2 and ES3 renderers, used by JNI code.
 
+class BatchFiles;
+class BroadPhaseCpu;
+class FrameGovernor;
+struct ComputeFormatReport;
+
 class Renderer {
 public:
     virtual ~Renderer();
     void resize(int w, int h);
     void render();
 
+    // Instance data can be supplied by the app instead of the built-in
+    // animation. beginInstanceUpdate() returns memory for MAX_INSTANCES
+    // entries of one stream, which the caller fills in place:
+    // - INSTANCE_TRANSFORMS: vec4 per instance, the column-major 2x2
+    //   scale/rotation matrix
+    // - INSTANCE_OFFSETS: vec2 per instance, the translation in clip space
+    // - INSTANCE_DEPTHS: float per instance, see SimulationState::depths
+    // The memory is a native staging arena, and is only valid until
+    // commitInstances(), which makes the first count instances current. Streams that weren't updated keep
+    // their previous contents. resetInstances() goes back to the built-in
+    // animation.
+    enum InstanceStream {
+        INSTANCE_TRANSFORMS,
+        INSTANCE_OFFSETS,
+        INSTANCE_DEPTHS,
+        INSTANCE_STREAM_COUNT
+    };
+    float* beginInstanceUpdate(InstanceStream stream);
+    void commitInstances(unsigned int count);
+    void resetInstances();
+
+    // Decodes a command stream (see CommandStream.h). Call before render()
+    // so the commands affect the frame about to be drawn.
+    void executeCommands(const void* data, size_t size);
+
+    // Frame time budget for the FrameGovernor, in milliseconds; a target
+    // <= 0 turns it off. Defaults to 16.6 ms with a 20 ms p99 bound.
+    void setFrameBudget(float targetMs, float p99BoundMs);
+    // Writes the governor's decision log, see FrameGovernor::formatLog().
+    size_t formatGovernorLog(char* buf, size_t size) const;
+
+    // Overlapping pairs of instances found by the last KERNEL_BROAD_PHASE
+    // run to complete, see BroadPhase.h. Points *pairs at up to
+    // MAX_COLLISION_PAIRS pairs of instance indices and returns how many
+    // pairs overlapped, which may be more.
+    unsigned int collisionPairs(const uint32_t** pairs) const;
+
+    // Depth mode draws instances front to back by depth with depth testing,
+    // so early-Z skips the fragments of whatever is covered. The order is
+    // kept sorted incrementally from frame to frame. Off by default, which
+    // draws instances in index order, later ones on top.
+    void setDepthMode(bool enabled);
+
+    // Every interval frames, renderers that can count fragments draw the
+    // frame a second time into a small counting target; 0, the default,
+    // turns this off. overdrawStats() returns false until the first count
+    // has been read back, a frame or two after it was drawn.
+    struct OverdrawStats {
+        // fragments shaded per pixel covered by any instance, 1 without
+        // overdraw
+        float shadedPerCovered;
+        // fraction of the pixels covered
+        float coverage;
+        // instances moved by the depth sort since the previous count
+        unsigned int sortMoves;
+    };
+    void setOverdrawInterval(unsigned int frames);
+    bool overdrawStats(OverdrawStats* stats) const;
+
+    // Runs the velocity-to-position kernel over a dataset file too large
+    // for memory and writes the results to outputPath, see BatchCompute.h.
+    // Blocks until done. Returns the number of points written, or -1.
+    int64_t runBatch(const char* inputPath, const char* outputPath);
+
+    // Storage formats of the velocity and position buffers of the GPU
+    // compute kernel, ComputeFormat values (see ComputeFormat.h); RGBA32F
+    // by default. Returns false, keeping the current formats, without GPU
+    // compute or if the kernel doesn't build for them. Kernels run on the
+    // CPU always work in floats.
+    bool setComputeFormats(unsigned int velocity, unsigned int position);
+    // Runs the kernel in each format on the same input and compares the
+    // results and GPU time to RGBA32F. Blocks until done. Returns false
+    // without GPU compute.
+    bool compareComputeFormats(ComputeFormatReport* report);
+
+    // Compute jobs run a kernel over more work groups than one dispatch
+    // should take, in slices spread over frames ahead of their draws, see
+    // ComputeJobs.h. submitComputeJob() returns the job's id, or 0 if the
+    // renderer can't slice the kernel, or too many jobs are queued; a
+    // CMD_DISPATCH runs it in one piece instead. computeJobProgress()
+    // returns false for jobs that aren't known (any more): finished jobs
+    // are remembered until newer ones need their place.
+    struct ComputeJobProgress {
+        unsigned int groupsTotal;
+        // work groups dispatched so far, and of those, finished on the GPU
+        unsigned int groupsIssued;
+        unsigned int groupsDone;
+        unsigned int slices;
+        // GPU time of the slices measured so far
+        uint64_t gpuNs;
+        bool finished;
+    };
+    unsigned int submitComputeJob(unsigned int kernel, unsigned int groupsX,
+            unsigned int groupsY, unsigned int groupsZ);
+    bool computeJobProgress(unsigned int job, ComputeJobProgress* progress) const;
+    // GPU time per frame for compute job slices; 2 ms by default. Values
+    // <= 0 are ignored.
+    void setComputeSliceBudget(float ms);
+
+    // Counts of the compute dispatches the renderer pipelined with its
+    // frames since it was created, see FrameScheduler.h. Returns false for
+    // renderers that don't pipeline dispatches (ES 2.0).
+    struct DispatchStats {
+        unsigned int dispatches;
+        unsigned int batches;
+        // batches checked at the next frame, and of those, how many had
+        // already finished, i.e. ran in the shadow of the previous frame
+        unsigned int checkedBatches;
+        unsigned int overlappedBatches;
+        // dispatches dropped because a frame's batch was full
+        unsigned int dropped;
+    };
+    bool dispatchStats(DispatchStats* stats) const;
+
 protected:
-    Renderer();
+    // sim is not owned and must outlive the renderer; NULL gives the
+    // renderer a private state.
+    Renderer(SimulationState* sim);
+
+    // Deletes the GPU timer queries of the governor. Subclass destructors
+    // call this while their context is current; otherwise the queries, which
+    // are never shared, go away with the context.
+    void destroyTimerQueries();
+
+    // render resolution chosen by the governor, relative to the surface
+    float renderScale() const;
+    int surfaceWidth() const { return mSim->width; }
+    int surfaceHeight() const { return mSim->height; }
+
+    // camera pan (x, y) and zoom, applied to clip-space positions as
+    // (p - pan) * zoom
+    const float* camera() const { return mSim->camera; }
+
+    // Slot k of the instance buffers holds instance drawOrder()[k], and
+    // instances are drawn in slot order. The order is the identity except
+    // in depth mode, where it is sorted nearest first.
+    const uint16_t* drawOrder() const { return mOrder; }
+    bool depthMode() const { return mDepthMode; }
+
+    // number of instances drawn this frame, and their bounds as from
+    // instanceBounds() in BroadPhase.h, in slot order
+    unsigned int frameInstances() const { return mFrameInstances; }
+    const float* frameBounds();
+    // Results of a broad phase run by the renderer: count pairs of slots,
+    // of which the first MAX_COLLISION_PAIRS are given, and the
+    // drawOrder() of the frame it ran on.
+    void setCollisionPairs(const uint32_t* pairs, unsigned int count,
+            const uint16_t* order);
+
+    // true if this frame is one to count fragments in, see
+    // setOverdrawInterval(); renderers that can report the counts with
+    // setOverdrawCounts(), pixels being the size of the counting target
+    bool overdrawFrame() const { return mOverdrawFrame; }
+    void setOverdrawCounts(uint64_t shaded, uint64_t covered, uint64_t pixels);
+
+    // Runs one of the ComputeKernelId kernels. Renderers may defer it to the
+    // start of the next frame's GPU work, making the results visible from
+    // the frame after. The work group counts are within the device limits.
+    // Returns false if the renderer can't run the kernel or queue it this
+    // frame, in which case executeCommands() runs it on the CPU instead:
+    // the broad phase in render(), others with runCpuKernel().
+    virtual bool dispatchKernel(unsigned int kernel, unsigned int groupsX,
+            unsigned int groupsY, unsigned int groupsZ) { return false; }
+
+    // Streams files through the GPU for runBatch(), setting *written to the
+    // points written or -1. Returns false if the renderer can't, which makes
+    // runBatch() run the kernel on the CPU instead.
+    virtual bool runGpuBatch(BatchFiles& files, int64_t* written) { return false; }
+    // For setComputeFormats() and compareComputeFormats(), with valid
+    // formats and a zeroed report.
+    virtual bool useComputeFormats(unsigned int velocity, unsigned int position) { return false; }
+    virtual bool runFormatComparison(ComputeFormatReport* report) { return false; }
+    // For submitComputeJob(), with a valid work group count, and
+    // computeJobProgress(), with a zeroed progress.
+    virtual unsigned int queueComputeJob(unsigned int kernel, const GLuint groups[3]) { return 0; }
+    virtual bool findComputeJob(unsigned int job, ComputeJobProgress* progress) const { return false; }
+    // For dispatchStats(), with zeroed stats.
+    virtual bool schedulerStats(DispatchStats* stats) const { return false; }
+    uint64_t computeSliceBudgetNs() const { return mSliceBudgetNs; }
 
     // return a pointer to a buffer of MAX_INSTANCES * sizeof(vec2).
     // the buffer is filled with per-instance offsets, then unmapped.
@@ -92,20 +309,69 @@ protected:
     virtual float* mapTransformBuf() = 0;
     virtual void unmapTransformBuf() = 0;
 
+    // Bracket the clear and draw() of each frame. beginScene() gets the
+    // render scale chosen by the governor; renderers that support dynamic
+    // resolution render to an offscreen target of that size and upscale it
+    // to the surface in endScene(). By default the scene is drawn straight
+    // to the surface at full size.
+    virtual void beginScene(float scale) {}
+    virtual void endScene() {}
     virtual void draw(unsigned int numInstances) = 0;
 
 private:
+    void layoutScene();
     void calcSceneParams(unsigned int w, unsigned int h, float* offsets);
-    void step();
+    void uploadInstances();
+    void step(unsigned int numInstances);
+    // Sorts the first count slots by depth in depth mode, or resets them
+    // to the identity. Returns true if the order changed.
+    bool updateDrawOrder(unsigned int count);
+    // Runs a kernel with cpuDispatch(), see ComputeKernels.h, clamped to the
+    // work groups that cover its buffers. Returns false if it has no CPU
+    // version.
+    bool runCpuKernel(unsigned int kernel, const uint32_t groups[3]);
 
-    unsigned int mNumInstances;
-    float mScale[2];
-    float mAngularVelocity[MAX_INSTANCES];
-    uint64_t mLastFrameNs;
-    float mAngles[MAX_INSTANCES];
+    FrameGovernor* mGovernor;
+    // GlCheckLevel applied to the context, -1 before the first frame
+    int mCheckLevel;
+    SimulationState* mSim;
+    bool mOwnsSim;
+    // the GL instance buffers don't match mSim
+    bool mInstancesDirty;
+    // staging arena for app-supplied instance data, allocated on first use
+    float* mStaging;
+    // pointers handed out by beginInstanceUpdate() since the last commit
+    float* mPending[INSTANCE_STREAM_COUNT];
+
+    bool mDepthMode;
+    uint16_t mOrder[MAX_INSTANCES];
+    // slots mOrder was last sorted over, 0 if it is the identity
+    unsigned int mSortedCount;
+    unsigned int mSortMoves;
+
+    unsigned int mOverdrawInterval;
+    unsigned int mOverdrawCountdown;
+    bool mOverdrawFrame;
+    bool mHasOverdraw;
+    OverdrawStats mOverdraw;
+
+    unsigned int mFrameInstances;
+    float mBounds[MAX_INSTANCES * 4];
+    // Runs KERNEL_BROAD_PHASE when the renderer can't; created on first use.
+    BroadPhaseCpu* mBroadPhase;
+    bool mBroadPhasePending;
+    uint32_t mPairs[MAX_COLLISION_PAIRS * 2];
+    unsigned int mNumPairs;
+    // velocities, then positions, of KERNEL_VELOCITY_TO_POSITION run on the
+    // CPU; allocated on first use
+    float* mCpuCompute;
+    uint64_t mSliceBudgetNs;
 };
 
-extern Renderer* createES2Renderer();
-extern Renderer* createES3Renderer();
+class SharedResources;
+
+// The renderer takes over the caller's reference to shared.
+extern Renderer* createES2Renderer(SharedResources* shared, SimulationState* sim);
+extern Renderer* createES3Renderer(SharedResources* shared, SimulationState* sim);
 
 #endif // GLES3JNI_H
@@ -0,0 +1,14 @@
+#version 300 es
+precision mediump float;
+// OVERDRAW counts fragments instead of shading them: with additive blending
+// into an 8-bit target, each one adds 1 to every channel.
+// @feature OVERDRAW 0
+in vec4 vColor;
+out vec4 outColor;
+void main() {
+#if OVERDRAW
+    outColor = vec4(1.0 / 255.0);
+#else
+    outColor = vColor;
+#endif
+}
@@ -0,0 +1,24 @@
+#version 300 es
+// Attribute locations must match the *_ATTRIB defines in RendererES3.cpp.
+// DEPTH gives each instance a depth by its place in the draw order, the
+// first one nearest, for drawing front to back with depth testing.
+// @feature DEPTH 0
+layout(location=0) in vec2 pos;
+layout(location=1) in vec4 color;
+layout(location=2) in vec4 scaleRot;
+layout(location=3) in vec2 offset;
+// pan in xy, zoom in z
+uniform vec3 camera;
+#if DEPTH
+// 2 / instances drawn
+uniform float depthStep;
+#endif
+out vec4 vColor;
+void main() {
+    mat2 sr = mat2(scaleRot.xy, scaleRot.zw);
+    gl_Position = vec4((sr*pos + offset - camera.xy) * camera.z, 0.0, 1.0);
+#if DEPTH
+    gl_Position.z = (float(gl_InstanceID) + 0.5) * depthStep - 1.0;
+#endif
+    vColor = color;
+}
@@ -0,0 +1,35 @@
+#version 100
+// ES 2.0 version of draw.vert, see RendererES2.cpp. Instances are drawn in
+// batches of BATCH_SIZE from a mesh of that many quads, each tagged with
+// its index in the batch, and read their transforms from uniform arrays.
+// BATCH_SIZE is set at run time from GL_MAX_VERTEX_UNIFORM_VECTORS.
+// @constant BATCH_SIZE 16
+// DEPTH as in draw.vert.
+// @feature DEPTH 0
+
+attribute vec2 pos;
+attribute vec4 color;
+// ES 2.0 has no integer attributes
+attribute float instance;
+uniform vec4 scaleRot[BATCH_SIZE];
+// two vec2 offsets per vector
+uniform vec4 offsets[(BATCH_SIZE + 1) / 2];
+// pan in xy, zoom in z
+uniform vec3 camera;
+#if DEPTH
+// 2 / instances drawn, and the first instance of the batch
+uniform float depthStep;
+uniform float batchFirst;
+#endif
+varying vec4 vColor;
+void main() {
+    int i = int(instance);
+    vec4 sr = scaleRot[i];
+    vec4 pair = offsets[i / 2];
+    vec2 offset = i - 2 * (i / 2) == 0 ? pair.xy : pair.zw;
+    gl_Position = vec4((mat2(sr.xy, sr.zw)*pos + offset - camera.xy) * camera.z, 0.0, 1.0);
+#if DEPTH
+    gl_Position.z = (batchFirst + instance + 0.5) * depthStep - 1.0;
+#endif
+    vColor = color;
+}
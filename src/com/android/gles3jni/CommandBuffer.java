@@ -0,0 +1,121 @@
+/*
+ * Copyright 2013 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package com.android.gles3jni;
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+
+// Records renderer commands from any thread and hands them to native code
+// in one JNI call per frame. The binary format is described in
+// jni/CommandStream.h; keep the two in sync.
+//
+// Two buffers are used: the app records into one while the GL thread
+// submits the other, so recording never waits for a frame.
+
+public class CommandBuffer {
+
+    static final int CMD_SET_INSTANCE = 1;
+    static final int CMD_SPAWN        = 2;
+    static final int CMD_KILL         = 3;
+    static final int CMD_CAMERA       = 4;
+    static final int CMD_DISPATCH     = 5;
+
+    public static final int KERNEL_VELOCITY_TO_POSITION = 0;
+    // See GLES3JNILib.getCollisionPairs(); the group counts are ignored.
+    public static final int KERNEL_BROAD_PHASE = 1;
+
+    private static final int DEFAULT_CAPACITY = 16 * 1024;
+
+    private ByteBuffer mRecording;
+    private ByteBuffer mSubmitting;
+
+    public CommandBuffer() {
+        this(DEFAULT_CAPACITY);
+    }
+
+    public CommandBuffer(int capacity) {
+        mRecording = ByteBuffer.allocateDirect(capacity).order(ByteOrder.nativeOrder());
+        mSubmitting = ByteBuffer.allocateDirect(capacity).order(ByteOrder.nativeOrder());
+    }
+
+    public synchronized void setInstance(int index, float angle, float angularVelocity,
+            float offsetX, float offsetY) {
+        header(CMD_SET_INSTANCE, 5);
+        mRecording.putInt(index).putFloat(angle).putFloat(angularVelocity)
+                .putFloat(offsetX).putFloat(offsetY);
+    }
+
+    public synchronized void spawn(float angle, float angularVelocity,
+            float offsetX, float offsetY) {
+        header(CMD_SPAWN, 4);
+        mRecording.putFloat(angle).putFloat(angularVelocity)
+                .putFloat(offsetX).putFloat(offsetY);
+    }
+
+    // With a depth for GLES3JNILib.setDepthMode(), in [0, 1], 0 nearest.
+    // Instances set without one keep theirs; spawned ones get a random one.
+    public synchronized void setInstance(int index, float angle, float angularVelocity,
+            float offsetX, float offsetY, float depth) {
+        header(CMD_SET_INSTANCE, 6);
+        mRecording.putInt(index).putFloat(angle).putFloat(angularVelocity)
+                .putFloat(offsetX).putFloat(offsetY).putFloat(depth);
+    }
+
+    public synchronized void spawn(float angle, float angularVelocity,
+            float offsetX, float offsetY, float depth) {
+        header(CMD_SPAWN, 5);
+        mRecording.putFloat(angle).putFloat(angularVelocity)
+                .putFloat(offsetX).putFloat(offsetY).putFloat(depth);
+    }
+
+    // The last instance moves into the killed one's slot.
+    public synchronized void kill(int index) {
+        header(CMD_KILL, 1);
+        mRecording.putInt(index);
+    }
+
+    public synchronized void camera(float x, float y, float zoom) {
+        header(CMD_CAMERA, 3);
+        mRecording.putFloat(x).putFloat(y).putFloat(zoom);
+    }
+
+    // Runs ahead of the frame's draws, overlapping them on the GPU; the
+    // results are visible from the next frame on.
+    public synchronized void dispatch(int kernel, int groupsX, int groupsY, int groupsZ) {
+        header(CMD_DISPATCH, 4);
+        mRecording.putInt(kernel).putInt(groupsX).putInt(groupsY).putInt(groupsZ);
+    }
+
+    // Called on the GL thread in place of GLES3JNILib.step().
+    void submitAndStep(long handle) {
+        ByteBuffer commands;
+        synchronized (this) {
+            commands = mRecording;
+            mRecording = mSubmitting;
+            mSubmitting = commands;
+        }
+        GLES3JNILib.stepWithCommands(handle, commands, commands.position());
+        commands.clear();
+    }
+
+    private void header(int opcode, int payloadWords) {
+        if (mRecording.remaining() < 4 * (1 + payloadWords)) {
+            throw new IllegalStateException("CommandBuffer full");
+        }
+        mRecording.putInt(opcode | (payloadWords << 16));
+    }
+}
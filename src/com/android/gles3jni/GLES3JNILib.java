@@ -16,6 +16,10 @@
 
 package com.android.gles3jni;
 
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.FloatBuffer;
+
 // Wrapper for native library
 
 public class GLES3JNILib {
@@ -24,7 +28,144 @@ public class GLES3JNILib {
          System.loadLibrary("gles3jni");
      }
 
-     public static native void init();
-     public static native void resize(int width, int height);
-     public static native void step();
+     // Must match MAX_INSTANCES and Renderer::InstanceStream in gles3jni.h.
+     public static final int MAX_INSTANCES = 256;
+     // 4 floats per instance: column-major 2x2 scale/rotation matrix
+     public static final int INSTANCE_TRANSFORMS = 0;
+     // 2 floats per instance: translation in clip space
+     public static final int INSTANCE_OFFSETS = 1;
+     // 1 float per instance: depth in [0, 1], 0 nearest, see setDepthMode()
+     public static final int INSTANCE_DEPTHS = 2;
+
+     // Directory for the native device capability profile, which saves
+     // probing the GPU on later starts. Call before the first create().
+     public static native void setCacheDir(String path);
+
+     // GL error checking: none, once per frame, or after each checked call.
+     // Native builds may cap the level; release builds check nothing.
+     // Defaults to GL_CHECK_FRAME. Applied from the next frame on.
+     public static final int GL_CHECK_OFF = 0;
+     public static final int GL_CHECK_FRAME = 1;
+     public static final int GL_CHECK_CALL = 2;
+     public static native void setGlCheckLevel(int level);
+
+     // Simulation state (the built-in animation, instance data and camera)
+     // lives outside of renderers, so that it survives the loss of the GL
+     // context. Create one per view and pass it to every renderer of that
+     // view. It must outlive them, and only be used by one at a time.
+     public static native long createSimulation();
+     public static native void destroySimulation(long simulation);
+
+     // Creates a renderer in the current context and returns its handle, or
+     // 0 on failure. Renderers whose contexts are in the same EGL share
+     // group, identified by shareGroup, share programs and static meshes.
+     // The renderer picks up the state of the simulation where the previous
+     // one left it; 0 gives it a private one.
+     // Every other call takes the handle and must be made on the GL thread
+     // of the context it was created in.
+     public static native long create(int shareGroup, long simulation);
+     // Destroys the renderer. Its context doesn't need to be current.
+     public static native void destroy(long handle);
+     public static native void resize(long handle, int width, int height);
+     public static native void step(long handle);
+     // Decodes length bytes of commands from a direct buffer (see
+     // CommandBuffer), then renders a frame.
+     public static native void stepWithCommands(long handle, ByteBuffer commands, int length);
+
+     // Returns a direct buffer over native instance memory for one stream,
+     // sized for MAX_INSTANCES. Fill it in place, then call
+     // commitInstances(). The buffer must not be touched after the commit,
+     // and both calls must happen on the GL thread (see
+     // GLSurfaceView.queueEvent).
+     public static native ByteBuffer mapInstances(long handle, int stream);
+     public static native void commitInstances(long handle, int count);
+     // Returns to the built-in animation.
+     public static native void resetInstances(long handle);
+
+     // Frame time budget in milliseconds. The renderer lowers resolution
+     // and instance count to keep frames within it. A target <= 0 turns
+     // this off. Defaults to 16.6 ms, 20 ms at p99.
+     public static native void setFrameBudget(long handle, float targetMs, float p99BoundMs);
+     // The budget decisions taken so far, as CSV with a header line.
+     public static native String getGovernorLog(long handle);
+
+     // Must match MAX_COLLISION_PAIRS in gles3jni.h.
+     public static final int MAX_COLLISION_PAIRS = 4096;
+     // Pairs of instances whose bounding boxes overlapped in the last
+     // completed CommandBuffer.KERNEL_BROAD_PHASE run. Fills pairs with
+     // index pairs (i, j), i < j, as far as it fits or up to
+     // MAX_COLLISION_PAIRS pairs, and returns how many pairs overlapped.
+     // Runs on the GPU with ES 3.1, where results lag a frame or two.
+     public static native int getCollisionPairs(long handle, int[] pairs);
+
+     // Runs the compute kernel over a file of vec4 floats in native byte
+     // order, which may be far larger than memory, and writes the results
+     // to output, a file of the same size. Blocks until done, so call it
+     // from a batch job's GL thread rather than a view's. Uses the GPU with
+     // ES 3.1, the CPU otherwise. Returns the number of points written, or
+     // -1 on failure.
+     public static native long runBatch(long handle, String input, String output);
+
+     // Storage formats of the compute kernel's buffers, see
+     // jni/ComputeFormat.h. The 16-bit ones halve the memory and bandwidth
+     // per point at some precision; getComputeFormatReport() measures how
+     // much, running the kernel in each format and returning CSV with a
+     // header line, or null without GPU compute. It blocks, like runBatch().
+     // setComputeFormats() returns false, changing nothing, without GPU
+     // compute or if the driver can't run the kernel with the formats.
+     public static final int COMPUTE_FORMAT_RGBA32F = 0;
+     public static final int COMPUTE_FORMAT_RGBA16F = 1;
+     public static final int COMPUTE_FORMAT_HALF_R32UI = 2;
+     public static final int COMPUTE_FORMAT_FIXED16 = 3;
+     public static native boolean setComputeFormats(long handle, int velocity, int position);
+     public static native String getComputeFormatReport(long handle);
+
+     // Runs a CommandBuffer kernel over groupsX * groupsY * groupsZ work
+     // groups in slices, one per frame ahead of its draws, each sized to
+     // take about the slice budget on the GPU, so that long jobs don't
+     // hold up frames. Returns the job's id, or 0 if the renderer can't
+     // slice the kernel (only KERNEL_VELOCITY_TO_POSITION, with ES 3.1) or
+     // too many jobs are queued. getComputeJobProgress() fills progress,
+     // indexed by COMPUTE_JOB_*, and returns false for unknown jobs;
+     // finished ones are remembered until newer jobs need their place.
+     public static final int COMPUTE_JOB_DONE = 0;
+     public static final int COMPUTE_JOB_ISSUED = 1;
+     public static final int COMPUTE_JOB_SLICES = 2;
+     public static final int COMPUTE_JOB_GPU_MS = 3;
+     public static final int COMPUTE_JOB_FINISHED = 4;
+     public static native int submitComputeJob(long handle, int kernel, int groupsX, int groupsY, int groupsZ);
+     public static native boolean getComputeJobProgress(long handle, int job, float[] progress);
+     // GPU time per frame for job slices, in milliseconds. Defaults to 2.
+     public static native void setComputeSliceBudget(long handle, float ms);
+
+     // Fills stats, indexed by DISPATCH_*, with the compute dispatches run
+     // ahead of each frame's draws so far: how many, in how many batches,
+     // the fraction of batches that finished within the next frame, and
+     // how many were dropped because a frame's batch was full. Returns
+     // false if the renderer doesn't pipeline dispatches (ES 2.0).
+     public static final int DISPATCH_COUNT = 0;
+     public static final int DISPATCH_BATCHES = 1;
+     public static final int DISPATCH_OVERLAP = 2;
+     public static final int DISPATCH_DROPPED = 3;
+     public static native boolean getDispatchStats(long handle, float[] stats);
+
+     // mapInstances() as native-order floats, or null without a renderer.
+     public static FloatBuffer mapInstanceFloats(long handle, int stream) {
+         ByteBuffer buf = mapInstances(handle, stream);
+         return buf != null ? buf.order(ByteOrder.nativeOrder()).asFloatBuffer() : null;
+     }
+
+     // Draws instances front to back by depth with depth testing instead of
+     // in index order, later ones on top, so covered fragments are skipped.
+     public static native void setDepthMode(long handle, boolean enabled);
+
+     // Every frames frames, counts the fragments of a frame in a second,
+     // smaller pass; 0 (the default) turns this off. getOverdrawStats()
+     // fills stats with the last count, indexed by OVERDRAW_*, and returns
+     // false if there is none yet or the renderer can't count (ES 2.0).
+     public static final int OVERDRAW_SHADED_PER_COVERED = 0;
+     public static final int OVERDRAW_COVERAGE = 1;
+     public static final int OVERDRAW_SORT_MOVES = 2;
+     public static native void setOverdrawInterval(long handle, int frames);
+     public static native boolean getOverdrawStats(long handle, float[] stats);
 }
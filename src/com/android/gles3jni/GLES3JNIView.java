@@ -30,30 +30,120 @@ import javax.microedition.khronos.egl.EGLContext;
 import javax.microedition.khronos.egl.EGLDisplay;
 import javax.microedition.khronos.opengles.GL10;
 
+import java.util.ArrayList;
+
 class GLES3JNIView extends GLSurfaceView {
     private static final String TAG = "GLES3JNI";
     private static final boolean DEBUG = true;
 
+    private final CommandBuffer mCommands = new CommandBuffer();
+
+    // Only touched on this view's GL thread.
+    private long mHandle;
+    private int mShareGroup;
+
+    // Outlives the renderer, see GLES3JNILib.createSimulation(). Only
+    // changed while the GL thread isn't running.
+    private long mSimulation;
+
     public GLES3JNIView(Context context) {
         super(context);
         // Pick an EGLConfig with RGB8 color, 16-bit depth, no stencil,
         // supporting OpenGL ES 2.0 or later backwards-compatible versions.
         setEGLConfigChooser(8, 8, 8, 0, 16, 0);
         setEGLContextClientVersion(2);
+        setEGLContextFactory(new SharedContextFactory());
+        // Keeping the context over onPause() makes resuming instant where
+        // the device allows it. Otherwise the next renderer restores the
+        // simulation state.
+        setPreserveEGLContextOnPause(true);
         setRenderer(new Renderer());
+        GLES3JNILib.setCacheDir(context.getCacheDir().getAbsolutePath());
+        mSimulation = GLES3JNILib.createSimulation();
+    }
+
+    @Override
+    protected void onAttachedToWindow() {
+        if (mSimulation == 0) {
+            mSimulation = GLES3JNILib.createSimulation();
+        }
+        super.onAttachedToWindow();
+    }
+
+    @Override
+    protected void onDetachedFromWindow() {
+        // Stops the GL thread, destroying the renderer.
+        super.onDetachedFromWindow();
+        GLES3JNILib.destroySimulation(mSimulation);
+        mSimulation = 0;
+    }
+
+    // Commands recorded here are applied at the start of the next frame.
+    public CommandBuffer getCommandBuffer() {
+        return mCommands;
+    }
+
+    // The native renderer of this view, for GLES3JNILib calls made on its GL
+    // thread (see queueEvent). 0 while there is no context.
+    public long getRendererHandle() {
+        return mHandle;
+    }
+
+    // Puts every view's context into one EGL share group, so their native
+    // renderers compile each program once and share static buffers. A new
+    // group starts whenever a context is created while none is alive.
+    private class SharedContextFactory implements GLSurfaceView.EGLContextFactory {
+        private static final int EGL_CONTEXT_CLIENT_VERSION = 0x3098;
+
+        public EGLContext createContext(EGL10 egl, EGLDisplay display, EGLConfig config) {
+            int[] attribs = {EGL_CONTEXT_CLIENT_VERSION, 2, EGL10.EGL_NONE};
+            synchronized (sContexts) {
+                EGLContext share = EGL10.EGL_NO_CONTEXT;
+                if (sContexts.isEmpty()) {
+                    sShareGroup++;
+                } else {
+                    share = sContexts.get(0);
+                }
+                EGLContext context = egl.eglCreateContext(display, config, share, attribs);
+                if (context != null && context != EGL10.EGL_NO_CONTEXT) {
+                    sContexts.add(context);
+                    mShareGroup = sShareGroup;
+                }
+                return context;
+            }
+        }
+
+        public void destroyContext(EGL10 egl, EGLDisplay display, EGLContext context) {
+            // The context is no longer current here; the native renderer
+            // hands its shared objects to the rest of the group.
+            if (mHandle != 0) {
+                GLES3JNILib.destroy(mHandle);
+                mHandle = 0;
+            }
+            synchronized (sContexts) {
+                sContexts.remove(context);
+                egl.eglDestroyContext(display, context);
+            }
+        }
     }
 
-    private static class Renderer implements GLSurfaceView.Renderer {
+    private static final ArrayList<EGLContext> sContexts = new ArrayList<EGLContext>();
+    private static int sShareGroup;
+
+    private class Renderer implements GLSurfaceView.Renderer {
         public void onDrawFrame(GL10 gl) {
-            GLES3JNILib.step();
+            mCommands.submitAndStep(mHandle);
         }
 
         public void onSurfaceChanged(GL10 gl, int width, int height) {
-            GLES3JNILib.resize(width, height);
+            GLES3JNILib.resize(mHandle, width, height);
         }
 
         public void onSurfaceCreated(GL10 gl, EGLConfig config) {
-            GLES3JNILib.init();
+            if (mHandle != 0) {
+                GLES3JNILib.destroy(mHandle);
+            }
+            mHandle = GLES3JNILib.create(mShareGroup, mSimulation);
         }
     }
 }
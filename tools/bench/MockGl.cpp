@@ -0,0 +1,374 @@
+/*
+ * Copyright 2013 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MockGl.h"
+
+#include <EGL/egl.h>
+#include <GLES3/gl31.h>
+#include <GLES2/gl2ext.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "GlProcs.h"
+
+static unsigned long sCalls;
+
+unsigned long mockGlCalls() {
+    return sCalls;
+}
+
+// ----------------------------------------------------------------------------
+// Objects. Names are never reused; only buffers have contents.
+
+struct MockBuffer {
+    unsigned char* data;
+    GLsizeiptr size;
+};
+
+static GLuint sNextName = 1;
+static MockBuffer* sBuffers;
+static GLuint sNumBuffers;
+
+// buffer bound to each target, by target
+struct MockBinding {
+    GLenum target;
+    GLuint buffer;
+};
+static MockBinding sBindings[16];
+
+static void genNames(GLsizei n, GLuint* names) {
+    for (GLsizei i = 0; i < n; i++)
+        names[i] = sNextName++;
+}
+
+static MockBuffer* buffer(GLuint name) {
+    if (name >= sNumBuffers) {
+        GLuint count = name + 64;
+        MockBuffer* grown = (MockBuffer*)realloc(sBuffers, count * sizeof(MockBuffer));
+        if (!grown)
+            abort();
+        memset(grown + sNumBuffers, 0, (count - sNumBuffers) * sizeof(MockBuffer));
+        sBuffers = grown;
+        sNumBuffers = count;
+    }
+    return &sBuffers[name];
+}
+
+static void bind(GLenum target, GLuint name) {
+    for (unsigned int i = 0; i < sizeof(sBindings) / sizeof(sBindings[0]); i++) {
+        if (sBindings[i].target == target || sBindings[i].target == 0) {
+            sBindings[i].target = target;
+            sBindings[i].buffer = name;
+            return;
+        }
+    }
+}
+
+static MockBuffer* bound(GLenum target) {
+    for (unsigned int i = 0; i < sizeof(sBindings) / sizeof(sBindings[0]); i++) {
+        if (sBindings[i].target == target)
+            return sBindings[i].buffer ? buffer(sBindings[i].buffer) : NULL;
+    }
+    return NULL;
+}
+
+static void allocate(GLenum target, GLsizeiptr size, const void* data) {
+    MockBuffer* buf = bound(target);
+    if (!buf)
+        return;
+    free(buf->data);
+    buf->data = (unsigned char*)calloc(1, size);
+    buf->size = size;
+    if (buf->data && data)
+        memcpy(buf->data, data, size);
+}
+
+// ----------------------------------------------------------------------------
+// Queries. Limits are those of a mid-range ES 3.1 GPU.
+
+static const char EXTENSIONS[] =
+        "GL_EXT_buffer_storage GL_EXT_texture_buffer GL_EXT_disjoint_timer_query "
+        "GL_KHR_debug GL_EXT_color_buffer_float GL_EXT_color_buffer_half_float";
+
+// simulated GPU time of every timer query
+static const GLuint64 QUERY_NS = 2000000;
+
+static GLint64 limit(GLenum pname) {
+    switch (pname) {
+    case GL_MAX_TEXTURE_SIZE:                       return 8192;
+    case GL_MAX_VERTEX_UNIFORM_VECTORS:             return 256;
+    case GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT:        return 64;
+    case GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT: return 64;
+    case GL_TEXTURE_BUFFER_OFFSET_ALIGNMENT_EXT:    return 64;
+    case GL_MAX_SHADER_STORAGE_BLOCK_SIZE:          return 128 << 20;
+    case GL_MAX_TEXTURE_BUFFER_SIZE_EXT:            return 64 << 20;
+    case GL_MAX_COMPUTE_SHARED_MEMORY_SIZE:         return 32768;
+    case GL_MAX_COMPUTE_SHADER_STORAGE_BLOCKS:      return 8;
+    case GL_MAX_COMPUTE_WORK_GROUP_INVOCATIONS:     return 1024;
+    case GL_MAX_COMPUTE_WORK_GROUP_COUNT:           return 65535;
+    case GL_MAX_COMPUTE_WORK_GROUP_SIZE:            return 1024;
+    default:                                        return 0;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// ES 2.0 entry points, exported like libGLESv2 does.
+
+extern "C" {
+
+GL_APICALL void GL_APIENTRY glActiveTexture(GLenum) { sCalls++; }
+GL_APICALL void GL_APIENTRY glAttachShader(GLuint, GLuint) { sCalls++; }
+GL_APICALL void GL_APIENTRY glBindBuffer(GLenum target, GLuint name) { sCalls++; bind(target, name); }
+GL_APICALL void GL_APIENTRY glBindFramebuffer(GLenum, GLuint) { sCalls++; }
+GL_APICALL void GL_APIENTRY glBindTexture(GLenum, GLuint) { sCalls++; }
+GL_APICALL void GL_APIENTRY glBlendFunc(GLenum, GLenum) { sCalls++; }
+GL_APICALL void GL_APIENTRY glBufferData(GLenum target, GLsizeiptr size, const void* data, GLenum) {
+    sCalls++;
+    allocate(target, size, data);
+}
+GL_APICALL void GL_APIENTRY glBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size,
+        const void* data) {
+    sCalls++;
+    MockBuffer* buf = bound(target);
+    if (buf && buf->data && offset + size <= buf->size)
+        memcpy(buf->data + offset, data, size);
+}
+GL_APICALL GLenum GL_APIENTRY glCheckFramebufferStatus(GLenum) { sCalls++; return GL_FRAMEBUFFER_COMPLETE; }
+GL_APICALL void GL_APIENTRY glClear(GLbitfield) { sCalls++; }
+GL_APICALL void GL_APIENTRY glClearColor(GLfloat, GLfloat, GLfloat, GLfloat) { sCalls++; }
+GL_APICALL void GL_APIENTRY glCompileShader(GLuint) { sCalls++; }
+GL_APICALL GLuint GL_APIENTRY glCreateProgram() { sCalls++; return sNextName++; }
+GL_APICALL GLuint GL_APIENTRY glCreateShader(GLenum) { sCalls++; return sNextName++; }
+GL_APICALL void GL_APIENTRY glDeleteBuffers(GLsizei n, const GLuint* names) {
+    sCalls++;
+    for (GLsizei i = 0; i < n; i++) {
+        if (names[i] && names[i] < sNumBuffers) {
+            free(sBuffers[names[i]].data);
+            memset(&sBuffers[names[i]], 0, sizeof(MockBuffer));
+        }
+    }
+}
+GL_APICALL void GL_APIENTRY glDeleteFramebuffers(GLsizei, const GLuint*) { sCalls++; }
+GL_APICALL void GL_APIENTRY glDeleteProgram(GLuint) { sCalls++; }
+GL_APICALL void GL_APIENTRY glDeleteShader(GLuint) { sCalls++; }
+GL_APICALL void GL_APIENTRY glDeleteTextures(GLsizei, const GLuint*) { sCalls++; }
+GL_APICALL void GL_APIENTRY glDetachShader(GLuint, GLuint) { sCalls++; }
+GL_APICALL void GL_APIENTRY glDisable(GLenum) { sCalls++; }
+GL_APICALL void GL_APIENTRY glDisableVertexAttribArray(GLuint) { sCalls++; }
+GL_APICALL void GL_APIENTRY glDrawElements(GLenum, GLsizei, GLenum, const void*) { sCalls++; }
+GL_APICALL void GL_APIENTRY glEnable(GLenum) { sCalls++; }
+GL_APICALL void GL_APIENTRY glEnableVertexAttribArray(GLuint) { sCalls++; }
+GL_APICALL void GL_APIENTRY glFinish() { sCalls++; }
+GL_APICALL void GL_APIENTRY glFlush() { sCalls++; }
+GL_APICALL void GL_APIENTRY glFramebufferTexture2D(GLenum, GLenum, GLenum, GLuint, GLint) { sCalls++; }
+GL_APICALL void GL_APIENTRY glGenBuffers(GLsizei n, GLuint* names) { sCalls++; genNames(n, names); }
+GL_APICALL void GL_APIENTRY glGenFramebuffers(GLsizei n, GLuint* names) { sCalls++; genNames(n, names); }
+GL_APICALL void GL_APIENTRY glGenTextures(GLsizei n, GLuint* names) { sCalls++; genNames(n, names); }
+GL_APICALL void GL_APIENTRY glGetAttachedShaders(GLuint, GLsizei, GLsizei* count, GLuint*) {
+    sCalls++;
+    if (count)
+        *count = 0;
+}
+GL_APICALL GLint GL_APIENTRY glGetAttribLocation(GLuint, const GLchar*) { sCalls++; return 0; }
+GL_APICALL GLenum GL_APIENTRY glGetError() { sCalls++; return GL_NO_ERROR; }
+GL_APICALL void GL_APIENTRY glGetIntegerv(GLenum pname, GLint* data) { sCalls++; *data = (GLint)limit(pname); }
+GL_APICALL void GL_APIENTRY glGetProgramInfoLog(GLuint, GLsizei size, GLsizei* length, GLchar* log) {
+    sCalls++;
+    if (length)
+        *length = 0;
+    if (size > 0)
+        log[0] = '\0';
+}
+GL_APICALL void GL_APIENTRY glGetProgramiv(GLuint, GLenum pname, GLint* params) {
+    sCalls++;
+    *params = pname == GL_LINK_STATUS ? GL_TRUE : 0;
+}
+GL_APICALL void GL_APIENTRY glGetShaderInfoLog(GLuint, GLsizei size, GLsizei* length, GLchar* log) {
+    sCalls++;
+    if (length)
+        *length = 0;
+    if (size > 0)
+        log[0] = '\0';
+}
+GL_APICALL void GL_APIENTRY glGetShaderiv(GLuint, GLenum pname, GLint* params) {
+    sCalls++;
+    *params = pname == GL_COMPILE_STATUS ? GL_TRUE : 0;
+}
+GL_APICALL const GLubyte* GL_APIENTRY glGetString(GLenum name) {
+    sCalls++;
+    switch (name) {
+    case GL_VENDOR:     return (const GLubyte*)"Mock";
+    case GL_RENDERER:   return (const GLubyte*)"Mock GL";
+    case GL_VERSION:    return (const GLubyte*)"OpenGL ES 3.1 Mock";
+    case GL_EXTENSIONS: return (const GLubyte*)EXTENSIONS;
+    default:            return NULL;
+    }
+}
+GL_APICALL GLint GL_APIENTRY glGetUniformLocation(GLuint, const GLchar*) { sCalls++; return 0; }
+GL_APICALL void GL_APIENTRY glLinkProgram(GLuint) { sCalls++; }
+GL_APICALL void GL_APIENTRY glReadPixels(GLint, GLint, GLsizei, GLsizei, GLenum, GLenum, void*) { sCalls++; }
+GL_APICALL void GL_APIENTRY glShaderSource(GLuint, GLsizei, const GLchar* const*, const GLint*) { sCalls++; }
+GL_APICALL void GL_APIENTRY glUniform1f(GLint, GLfloat) { sCalls++; }
+GL_APICALL void GL_APIENTRY glUniform3fv(GLint, GLsizei, const GLfloat*) { sCalls++; }
+GL_APICALL void GL_APIENTRY glUniform4fv(GLint, GLsizei, const GLfloat*) { sCalls++; }
+GL_APICALL void GL_APIENTRY glUseProgram(GLuint) { sCalls++; }
+GL_APICALL void GL_APIENTRY glVertexAttribPointer(GLuint, GLint, GLenum, GLboolean, GLsizei, const void*) { sCalls++; }
+GL_APICALL void GL_APIENTRY glViewport(GLint, GLint, GLsizei, GLsizei) { sCalls++; }
+
+} // extern "C"
+
+// ----------------------------------------------------------------------------
+// ES 3.0+ and extension entry points, reached through eglGetProcAddress().
+// Functions that only need to exist do nothing and return zero; the rest
+// are overridden below.
+
+template <typename T>
+static inline T mockResult() {
+    return T();
+}
+
+#define MOCK_PROC(ret, name, params, args) \
+    static ret GL_APIENTRY mock_##name params { \
+        sCalls++; \
+        return mockResult<ret>(); \
+    }
+GL_PROCS_ES30(MOCK_PROC)
+GL_PROCS_ES31(MOCK_PROC)
+GL_PROCS_EXT(MOCK_PROC)
+#undef MOCK_PROC
+
+static void GL_APIENTRY override_glGenNames(GLsizei n, GLuint* names) {
+    sCalls++;
+    genNames(n, names);
+}
+
+static void GL_APIENTRY override_glBindBufferRange(GLenum target, GLuint, GLuint name,
+        GLintptr, GLsizeiptr) {
+    sCalls++;
+    bind(target, name);
+}
+
+static void GL_APIENTRY override_glBindBufferBase(GLenum target, GLuint, GLuint name) {
+    sCalls++;
+    bind(target, name);
+}
+
+static void GL_APIENTRY override_glBufferStorageEXT(GLenum target, GLsizeiptr size,
+        const void* data, GLbitfield) {
+    sCalls++;
+    allocate(target, size, data);
+}
+
+static void* GL_APIENTRY override_glMapBufferRange(GLenum target, GLintptr offset,
+        GLsizeiptr length, GLbitfield) {
+    sCalls++;
+    MockBuffer* buf = bound(target);
+    if (!buf || !buf->data || offset + length > buf->size)
+        return NULL;
+    return buf->data + offset;
+}
+
+static GLboolean GL_APIENTRY override_glUnmapBuffer(GLenum) {
+    sCalls++;
+    return GL_TRUE;
+}
+
+static GLsync GL_APIENTRY override_glFenceSync(GLenum, GLbitfield) {
+    sCalls++;
+    return (GLsync)(intptr_t)sNextName++;
+}
+
+static GLenum GL_APIENTRY override_glClientWaitSync(GLsync, GLbitfield, GLuint64) {
+    sCalls++;
+    return GL_ALREADY_SIGNALED;
+}
+
+static void GL_APIENTRY override_glGetInteger64v(GLenum pname, GLint64* data) {
+    sCalls++;
+    *data = limit(pname);
+}
+
+static void GL_APIENTRY override_glGetIntegeri_v(GLenum pname, GLuint, GLint* data) {
+    sCalls++;
+    *data = (GLint)limit(pname);
+}
+
+static void GL_APIENTRY override_glGetQueryObjectuivEXT(GLuint, GLenum, GLuint* params) {
+    sCalls++;
+    // Only ever asked for GL_QUERY_RESULT_AVAILABLE_EXT.
+    *params = GL_TRUE;
+}
+
+static void GL_APIENTRY override_glGetQueryObjectui64vEXT(GLuint, GLenum, GLuint64* params) {
+    sCalls++;
+    *params = QUERY_NS;
+}
+
+struct MockProc {
+    const char* name;
+    void* proc;
+};
+
+static const MockProc OVERRIDES[] = {
+    {"glGenQueries", (void*)override_glGenNames},
+    {"glGenQueriesEXT", (void*)override_glGenNames},
+    {"glGenVertexArrays", (void*)override_glGenNames},
+    {"glGenSamplers", (void*)override_glGenNames},
+    {"glGenTransformFeedbacks", (void*)override_glGenNames},
+    {"glGenProgramPipelines", (void*)override_glGenNames},
+    {"glBindBufferRange", (void*)override_glBindBufferRange},
+    {"glBindBufferBase", (void*)override_glBindBufferBase},
+    {"glBufferStorageEXT", (void*)override_glBufferStorageEXT},
+    {"glMapBufferRange", (void*)override_glMapBufferRange},
+    {"glUnmapBuffer", (void*)override_glUnmapBuffer},
+    {"glFenceSync", (void*)override_glFenceSync},
+    {"glClientWaitSync", (void*)override_glClientWaitSync},
+    {"glGetInteger64v", (void*)override_glGetInteger64v},
+    {"glGetIntegeri_v", (void*)override_glGetIntegeri_v},
+    {"glGetQueryObjectuivEXT", (void*)override_glGetQueryObjectuivEXT},
+    {"glGetQueryObjectui64vEXT", (void*)override_glGetQueryObjectui64vEXT},
+};
+
+#define MOCK_ENTRY(ret, name, params, args) {#name, (void*)mock_##name},
+static const MockProc PROCS[] = {
+    GL_PROCS_ES30(MOCK_ENTRY)
+    GL_PROCS_ES31(MOCK_ENTRY)
+    GL_PROCS_EXT(MOCK_ENTRY)
+};
+#undef MOCK_ENTRY
+
+// ----------------------------------------------------------------------------
+// EGL: one context, always current.
+
+extern "C" {
+
+EGLAPI EGLContext EGLAPIENTRY eglGetCurrentContext() {
+    return (EGLContext)1;
+}
+
+EGLAPI __eglMustCastToProperFunctionPointerType EGLAPIENTRY eglGetProcAddress(const char* name) {
+    for (unsigned int i = 0; i < sizeof(OVERRIDES) / sizeof(OVERRIDES[0]); i++) {
+        if (strcmp(OVERRIDES[i].name, name) == 0)
+            return (__eglMustCastToProperFunctionPointerType)OVERRIDES[i].proc;
+    }
+    for (unsigned int i = 0; i < sizeof(PROCS) / sizeof(PROCS[0]); i++) {
+        if (strcmp(PROCS[i].name, name) == 0)
+            return (__eglMustCastToProperFunctionPointerType)PROCS[i].proc;
+    }
+    return NULL;
+}
+
+} // extern "C"
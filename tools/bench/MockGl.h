@@ -0,0 +1,34 @@
+/*
+ * Copyright 2013 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MOCKGL_H
+#define MOCKGL_H 1
+
+// ----------------------------------------------------------------------------
+// Stand-in GLES 3.1 driver for host benchmarks. Every entry point the
+// renderer uses exists and succeeds without drawing anything: objects get
+// names, buffers get host memory that can be mapped, shaders compile,
+// queries and fences complete at once. ES 3.0+ and extension functions are
+// handed out through eglGetProcAddress(), so the renderer must be built
+// with DYNAMIC_ES3.
+//
+// What is left to measure is the CPU side of a frame: simulation, command
+// decoding, state tracking and the cost of issuing GL calls.
+
+// GL calls made so far, to catch changes in calls per frame
+extern unsigned long mockGlCalls();
+
+#endif // MOCKGL_H
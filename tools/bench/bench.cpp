@@ -0,0 +1,303 @@
+/*
+ * Copyright 2013 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// ----------------------------------------------------------------------------
+// Host benchmark of the per-frame CPU work of RendererES3, against the
+// mock driver in MockGl.cpp. Runs each scenario a number of times,
+// interleaved so that drift in machine speed spreads over all of them, and
+// writes one CSV line per run:
+//
+//     scenario,run,ns_per_iter,gl_calls_per_iter
+//
+// tools/bench_compare.py compares two such files.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "gles3jni.h"
+#include "BroadPhase.h"
+#include "CommandStream.h"
+#include "MockGl.h"
+#include "SharedResources.h"
+
+#define SURFACE_WIDTH 1920
+#define SURFACE_HEIGHT 1080
+// Each run is timed in chunks and reports the median chunk, which keeps
+// preemption and other one-off stalls out of the result.
+#define CHUNKS 21
+
+struct Bench {
+    Renderer* renderer;
+    // command stream for the scenarios that use one
+    uint32_t commands[MAX_INSTANCES * 6 + 16];
+    size_t commandBytes;
+    // compute job of the jobs scenario
+    unsigned int job;
+    unsigned long iter;
+};
+
+static void putFloat(uint32_t* word, float f) {
+    memcpy(word, &f, sizeof(f));
+}
+
+// Built-in animation: Renderer::step() plus the draw.
+static void iterateRender(Bench& b) {
+    b.renderer->render();
+}
+
+// Orientation changes, which lay the scene out again through
+// Renderer::calcSceneParams().
+static void iterateLayout(Bench& b) {
+    if (b.iter & 1)
+        b.renderer->resize(SURFACE_HEIGHT, SURFACE_WIDTH);
+    else
+        b.renderer->resize(SURFACE_WIDTH, SURFACE_HEIGHT);
+}
+
+// App-supplied instances for both streams every frame.
+static void iterateExternal(Bench& b) {
+    float* transforms = b.renderer->beginInstanceUpdate(Renderer::INSTANCE_TRANSFORMS);
+    float* offsets = b.renderer->beginInstanceUpdate(Renderer::INSTANCE_OFFSETS);
+    for (unsigned int i = 0; i < MAX_INSTANCES; i++) {
+        float a = 0.001f * (b.iter + i);
+        transforms[4*i + 0] = 0.05f * cosf(a);
+        transforms[4*i + 1] = 0.05f * sinf(a);
+        transforms[4*i + 2] = -0.05f * sinf(a);
+        transforms[4*i + 3] = 0.05f * cosf(a);
+        offsets[2*i + 0] = (i % 16) / 8.0f - 1.0f;
+        offsets[2*i + 1] = (i / 16) / 8.0f - 1.0f;
+    }
+    b.renderer->commitInstances(MAX_INSTANCES);
+    b.renderer->render();
+}
+
+// A command stream moving every instance and the camera.
+static void setupCommands(Bench& b) {
+    uint32_t* w = b.commands;
+    for (unsigned int i = 0; i < MAX_INSTANCES / 2; i++) {
+        *w++ = CMD_SET_INSTANCE | (5 << 16);
+        *w++ = i;
+        putFloat(w++, 0.01f * i);
+        putFloat(w++, 1.0f);
+        putFloat(w++, 0.0f);
+        putFloat(w++, 0.0f);
+    }
+    *w++ = CMD_CAMERA | (3 << 16);
+    putFloat(w++, 0.1f);
+    putFloat(w++, 0.0f);
+    putFloat(w++, 1.5f);
+    b.commandBytes = (w - b.commands) * sizeof(uint32_t);
+}
+
+static void iterateCommands(Bench& b) {
+    b.renderer->executeCommands(b.commands, b.commandBytes);
+    b.renderer->render();
+}
+
+// A compute dispatch ahead of every frame.
+static void setupCompute(Bench& b) {
+    uint32_t* w = b.commands;
+    *w++ = CMD_DISPATCH | (4 << 16);
+    *w++ = KERNEL_VELOCITY_TO_POSITION;
+    *w++ = 1;
+    *w++ = 1;
+    *w++ = 1;
+    b.commandBytes = (w - b.commands) * sizeof(uint32_t);
+}
+
+// A broad phase dispatch ahead of every frame.
+static void setupCollide(Bench& b) {
+    uint32_t* w = b.commands;
+    *w++ = CMD_DISPATCH | (4 << 16);
+    *w++ = KERNEL_BROAD_PHASE;
+    *w++ = 1;
+    *w++ = 1;
+    *w++ = 1;
+    b.commandBytes = (w - b.commands) * sizeof(uint32_t);
+}
+
+// Depth mode, which keeps the draw order sorted, counting overdraw every
+// 16 frames.
+static void setupDepth(Bench& b) {
+    b.renderer->setDepthMode(true);
+    b.renderer->setOverdrawInterval(16);
+}
+
+// A long compute job in slices between frames, resubmitted once done.
+static void iterateJobs(Bench& b) {
+    Renderer::ComputeJobProgress progress;
+    if (!b.renderer->computeJobProgress(b.job, &progress) || progress.finished)
+        b.job = b.renderer->submitComputeJob(KERNEL_VELOCITY_TO_POSITION, 4096, 1, 1);
+    b.renderer->render();
+}
+
+// The CPU broad phase on its own, over far more boxes than the renderer
+// draws, with about one overlap per box.
+#define BROADPHASE_BOXES 100000
+
+static float* sBoxes;
+static uint32_t sPairs[2 * MAX_COLLISION_PAIRS];
+
+static void setupBroadPhase(Bench& b) {
+    if (sBoxes)
+        return;
+    sBoxes = (float*)malloc(BROADPHASE_BOXES * 4 * sizeof(float));
+    srand48(1);
+    for (unsigned int i = 0; i < BROADPHASE_BOXES; i++) {
+        sBoxes[4*i + 0] = 2.0f * drand48() - 1.0f;
+        sBoxes[4*i + 1] = 2.0f * drand48() - 1.0f;
+        sBoxes[4*i + 2] = 0.001f + 0.002f * drand48();
+        sBoxes[4*i + 3] = 0.001f + 0.002f * drand48();
+    }
+}
+
+static void iterateBroadPhase(Bench& b) {
+    static BroadPhaseCpu broadPhase;
+    const BroadPhaseGrid grid = broadPhaseGrid(sBoxes, BROADPHASE_BOXES);
+    broadPhase.findPairs(sBoxes, BROADPHASE_BOXES, grid, sPairs, MAX_COLLISION_PAIRS);
+}
+
+struct Scenario {
+    const char* name;
+    void (*setup)(Bench& b);
+    void (*iterate)(Bench& b);
+    // iterations are divided by this, for scenarios far slower than a frame
+    unsigned int cost;
+    // renderer to run the scenario with; NULL for the ES 3 one
+    Renderer* (*create)(SharedResources* shared, SimulationState* sim);
+};
+
+static const Scenario SCENARIOS[] = {
+    {"render",     NULL,            iterateRender,     1},
+    {"layout",     NULL,            iterateLayout,     1},
+    {"external",   NULL,            iterateExternal,   1},
+    {"commands",   setupCommands,   iterateCommands,   1},
+    {"compute",    setupCompute,    iterateCommands,   1},
+    {"collide",    setupCollide,    iterateCommands,   1},
+    {"broadphase", setupBroadPhase, iterateBroadPhase, 2000},
+    {"es2",        NULL,            iterateRender,     1, createES2Renderer},
+    {"depth",      setupDepth,      iterateRender,     1},
+    {"jobs",       NULL,            iterateJobs,       1},
+};
+#define NUM_SCENARIOS (sizeof(SCENARIOS) / sizeof(SCENARIOS[0]))
+
+static int compareDoubles(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return x < y ? -1 : x > y ? 1 : 0;
+}
+
+static uint64_t nowNs() {
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec*1000000000ull + now.tv_nsec;
+}
+
+// Returns false if the renderer couldn't be created.
+static bool runScenario(const Scenario& s, unsigned int run, unsigned int warmup,
+        unsigned int iters) {
+    SharedResources* shared = SharedResources::acquire(0);
+    if (!shared)
+        return false;
+    Bench b;
+    memset(&b, 0, sizeof(b));
+    b.renderer = (s.create ? s.create : createES3Renderer)(shared, NULL);
+    if (!b.renderer)
+        return false;
+    // Keep the workload fixed; the governor would scale it with the timing.
+    b.renderer->setFrameBudget(0.0f, 0.0f);
+    b.renderer->resize(SURFACE_WIDTH, SURFACE_HEIGHT);
+    if (s.setup)
+        s.setup(b);
+
+    warmup = (warmup + s.cost - 1) / s.cost;
+    iters = (iters + s.cost - 1) / s.cost;
+    for (unsigned int i = 0; i < warmup; i++, b.iter++)
+        s.iterate(b);
+    unsigned long calls = mockGlCalls();
+    const unsigned int chunkIters = (iters + CHUNKS - 1) / CHUNKS;
+    double chunkNs[CHUNKS];
+    for (unsigned int c = 0; c < CHUNKS; c++) {
+        uint64_t start = nowNs();
+        for (unsigned int i = 0; i < chunkIters; i++, b.iter++)
+            s.iterate(b);
+        chunkNs[c] = (double)(nowNs() - start) / chunkIters;
+    }
+    calls = mockGlCalls() - calls;
+    qsort(chunkNs, CHUNKS, sizeof(double), compareDoubles);
+
+    printf("%s,%u,%.1f,%.2f\n", s.name, run, chunkNs[CHUNKS / 2],
+            (double)calls / (CHUNKS * chunkIters));
+    fflush(stdout);
+    delete b.renderer;
+    return true;
+}
+
+static void usage() {
+    fprintf(stderr, "usage: bench [--runs N] [--iters N] [--warmup N] [scenario...]\n"
+            "scenarios:");
+    for (unsigned int i = 0; i < NUM_SCENARIOS; i++)
+        fprintf(stderr, " %s", SCENARIOS[i].name);
+    fprintf(stderr, "\n");
+}
+
+int main(int argc, char** argv) {
+    unsigned int runs = 10;
+    unsigned int iters = 20000;
+    unsigned int warmup = 1000;
+    bool selected[NUM_SCENARIOS];
+    bool any = false;
+    memset(selected, 0, sizeof(selected));
+
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 < argc && strcmp(argv[i], "--runs") == 0) {
+            runs = atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--iters") == 0) {
+            iters = atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--warmup") == 0) {
+            warmup = atoi(argv[++i]);
+        } else {
+            unsigned int s = 0;
+            while (s < NUM_SCENARIOS && strcmp(argv[i], SCENARIOS[s].name) != 0)
+                s++;
+            if (s == NUM_SCENARIOS) {
+                usage();
+                return 2;
+            }
+            selected[s] = true;
+            any = true;
+        }
+    }
+    if (runs == 0 || iters == 0) {
+        usage();
+        return 2;
+    }
+
+    printf("scenario,run,ns_per_iter,gl_calls_per_iter\n");
+    for (unsigned int run = 0; run < runs; run++) {
+        for (unsigned int s = 0; s < NUM_SCENARIOS; s++) {
+            if (any && !selected[s])
+                continue;
+            if (!runScenario(SCENARIOS[s], run, warmup, iters)) {
+                fprintf(stderr, "bench: could not create a renderer\n");
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,24 @@
+/*
+ * Copyright 2013 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BENCH_ANDROID_API_LEVEL_H
+#define BENCH_ANDROID_API_LEVEL_H 1
+
+// Host stand-in for the NDK's <android/api-level.h>: the minSdkVersion of
+// the app.
+#define __ANDROID_API__ 21
+
+#endif // BENCH_ANDROID_API_LEVEL_H
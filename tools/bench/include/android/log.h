@@ -0,0 +1,58 @@
+/*
+ * Copyright 2013 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BENCH_ANDROID_LOG_H
+#define BENCH_ANDROID_LOG_H 1
+
+// Host stand-in for the NDK's <android/log.h>. Warnings and errors go to
+// stderr, everything else is dropped so it can't skew the timings.
+
+#include <stdarg.h>
+#include <stdio.h>
+
+enum {
+    ANDROID_LOG_UNKNOWN = 0,
+    ANDROID_LOG_DEFAULT,
+    ANDROID_LOG_VERBOSE,
+    ANDROID_LOG_DEBUG,
+    ANDROID_LOG_INFO,
+    ANDROID_LOG_WARN,
+    ANDROID_LOG_ERROR,
+    ANDROID_LOG_FATAL,
+    ANDROID_LOG_SILENT,
+};
+
+static inline int __android_log_write(int prio, const char* tag, const char* text) {
+    if (prio < ANDROID_LOG_WARN)
+        return 0;
+    return fprintf(stderr, "%s: %s\n", tag, text);
+}
+
+static inline int __android_log_print(int prio, const char* tag, const char* fmt, ...)
+        __attribute__((format(printf, 3, 4)));
+static inline int __android_log_print(int prio, const char* tag, const char* fmt, ...) {
+    if (prio < ANDROID_LOG_WARN)
+        return 0;
+    va_list args;
+    va_start(args, fmt);
+    int n = fprintf(stderr, "%s: ", tag);
+    n += vfprintf(stderr, fmt, args);
+    n += fprintf(stderr, "\n");
+    va_end(args);
+    return n;
+}
+
+#endif // BENCH_ANDROID_LOG_H
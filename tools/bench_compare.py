@@ -0,0 +1,180 @@
+#!/usr/bin/env python3
+#
+# Copyright 2013 The Android Open Source Project
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Compares host benchmark results against a stored baseline.
+
+Usage:
+    bench_compare.py [--threshold PCT] [--confidence LEVEL] baseline.csv current.csv
+
+Both files are tools/bench output: one line per run of each scenario, with
+the mean time per iteration and the GL calls per iteration of that run.
+For each scenario the runs are summarized by their mean, and the change in
+time is given with a Welch confidence interval. A scenario regresses if
+the slowdown is statistically significant at the given confidence level
+and larger than the threshold, or if it makes more GL calls than before
+(the mock driver makes that count exact).
+
+Exits with status 1 if any scenario regressed, so it can gate CI. Timings
+only compare between runs on the same machine; record the baseline on the
+machine that runs the comparison (make bench-baseline).
+"""
+
+import argparse
+import collections
+import csv
+import math
+import sys
+
+
+def load(path):
+    runs = collections.OrderedDict()
+    with open(path) as f:
+        for row in csv.DictReader(f):
+            runs.setdefault(row['scenario'], []).append(
+                (float(row['ns_per_iter']), float(row['gl_calls_per_iter'])))
+    return runs
+
+
+def mean_var(xs):
+    m = sum(xs) / len(xs)
+    v = sum((x - m) ** 2 for x in xs) / (len(xs) - 1) if len(xs) > 1 else 0.0
+    return m, v
+
+
+def betacf(a, b, x):
+    # Continued fraction for the incomplete beta function (Lentz).
+    tiny = 1e-300
+    qab, qap, qam = a + b, a + 1.0, a - 1.0
+    c, d = 1.0, 1.0 - qab * x / qap
+    d = 1.0 / (d if abs(d) > tiny else tiny)
+    h = d
+    for m in range(1, 300):
+        m2 = 2 * m
+        aa = m * (b - m) * x / ((qam + m2) * (a + m2))
+        d = 1.0 + aa * d
+        d = 1.0 / (d if abs(d) > tiny else tiny)
+        c = 1.0 + aa / c
+        c = c if abs(c) > tiny else tiny
+        h *= d * c
+        aa = -(a + m) * (qab + m) * x / ((a + m2) * (qap + m2))
+        d = 1.0 + aa * d
+        d = 1.0 / (d if abs(d) > tiny else tiny)
+        c = 1.0 + aa / c
+        c = c if abs(c) > tiny else tiny
+        de = d * c
+        h *= de
+        if abs(de - 1.0) < 1e-12:
+            break
+    return h
+
+
+def betai(a, b, x):
+    if x <= 0.0:
+        return 0.0
+    if x >= 1.0:
+        return 1.0
+    lbt = (math.lgamma(a + b) - math.lgamma(a) - math.lgamma(b) +
+           a * math.log(x) + b * math.log(1.0 - x))
+    if x < (a + 1.0) / (a + b + 2.0):
+        return math.exp(lbt) * betacf(a, b, x) / a
+    return 1.0 - math.exp(lbt) * betacf(b, a, 1.0 - x) / b
+
+
+def t_quantile(p, df):
+    """Two-sided critical value: P(|T| <= t) = p for Student's t."""
+    lo, hi = 0.0, 1000.0
+    for _ in range(200):
+        t = (lo + hi) / 2
+        if 1.0 - betai(df / 2.0, 0.5, df / (df + t * t)) < p:
+            lo = t
+        else:
+            hi = t
+    return (lo + hi) / 2
+
+
+def compare(name, base, cur, threshold, confidence):
+    """Returns (regressed, report line)."""
+    if len(base) < 2 or len(cur) < 2:
+        return False, '%-10s needs at least 2 runs on each side' % name
+    mb, vb = mean_var([r[0] for r in base])
+    mc, vc = mean_var([r[0] for r in cur])
+    calls_b = mean_var([r[1] for r in base])[0]
+    calls_c = mean_var([r[1] for r in cur])[0]
+
+    se2 = vb / len(base) + vc / len(cur)
+    diff = mc - mb
+    if se2 > 0:
+        df = se2 ** 2 / ((vb / len(base)) ** 2 / (len(base) - 1) +
+                         (vc / len(cur)) ** 2 / (len(cur) - 1))
+        half = t_quantile(confidence, df) * math.sqrt(se2)
+    else:
+        half = 0.0
+    rel, rel_lo, rel_hi = (100.0 * x / mb for x in (diff, diff - half, diff + half))
+
+    status = 'ok'
+    regressed = False
+    if rel_lo > 0 and rel > threshold:
+        status = 'SLOWER'
+        regressed = True
+    elif rel_hi < 0 and rel < -threshold:
+        status = 'faster'
+    if calls_c > calls_b + 1e-6:
+        status += ', MORE GL CALLS'
+        regressed = True
+    line = ('%-10s %10.1f -> %10.1f ns  %+6.1f%% [%+6.1f%%, %+6.1f%%]  '
+            'calls %6.2f -> %6.2f  %s' %
+            (name, mb, mc, rel, rel_lo, rel_hi, calls_b, calls_c, status))
+    return regressed, line
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Flag benchmark regressions against a baseline.')
+    parser.add_argument('--threshold', type=float, default=5.0,
+                        help='slowdown in percent to tolerate (default 5)')
+    parser.add_argument('--confidence', type=float, default=0.95,
+                        help='confidence level of the intervals (default 0.95)')
+    parser.add_argument('baseline')
+    parser.add_argument('current')
+    args = parser.parse_args()
+    if not 0 < args.confidence < 1:
+        sys.exit('--confidence must be between 0 and 1')
+
+    base = load(args.baseline)
+    cur = load(args.current)
+    print('%.0f%% confidence, %.1f%% threshold' %
+          (100 * args.confidence, args.threshold))
+    regressions = 0
+    for name in base:
+        if name not in cur:
+            print('%-10s missing from %s' % (name, args.current))
+            regressions += 1
+            continue
+        regressed, line = compare(name, base[name], cur[name],
+                                  args.threshold, args.confidence)
+        print(line)
+        regressions += regressed
+    for name in cur:
+        if name not in base:
+            print('%-10s has no baseline' % name)
+
+    if regressions:
+        print('%d scenario(s) regressed' % regressions)
+        sys.exit(1)
+
+
+if __name__ == '__main__':
+    main()
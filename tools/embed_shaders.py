@@ -0,0 +1,279 @@
+#!/usr/bin/env python3
+#
+# Copyright 2013 The Android Open Source Project
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Validates, minifies and embeds GLSL sources as a C++ header.
+
+Usage:
+    embed_shaders.py -o ShaderSources.h [--validator PATH | --no-validate] \\
+        draw=draw.vert,draw.frag compute=compute.comp
+
+Each argument names one program and lists its stage files; the stage is
+taken from the file extension (.vert, .frag, .comp). Stage files declare
+the permutations they support in comments, which become the program's
+ShaderDesc (see ShaderVariant.h):
+
+    // @feature DEBUG_IDS 1        flag, enabled by default
+    // @constant LOCAL_SIZE 1024   integer constant and its default
+
+Every combination of feature flags is validated with glslangValidator,
+both before and after minification. The header declares one ShaderDesc
+per program. Its definition goes in a .cpp file of the same name next to
+the header, once for the whole library, so descs can be compared by
+address. That file holds each minified stage as a constexpr byte array,
+and each desc's sourceHash is the same FNV-1a hash ShaderVariantCache
+would compute at runtime.
+"""
+
+import argparse
+import itertools
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+STAGES = {
+    '.vert': 'vertex',
+    '.frag': 'fragment',
+    '.comp': 'compute',
+}
+
+DIRECTIVE_RE = re.compile(r'^\s*//\s*@(feature|constant)\s+(\w+)\s+(-?\d+)')
+IDENT_CHARS = set('abcdefghijklmnopqrstuvwxyz'
+                  'ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789_.')
+OPERATOR_CHARS = set('+-*/%<>=!&|^')
+
+
+def fnv1a64(data, seed=0xcbf29ce484222325):
+    h = seed
+    for b in bytearray(data):
+        h ^= b
+        h = (h * 0x100000001b3) & 0xffffffffffffffff
+    return h
+
+
+def strip_comments(src):
+    src = re.sub(r'/\*.*?\*/', lambda m: '\n' * m.group(0).count('\n'),
+                 src, flags=re.S)
+    return re.sub(r'//[^\n]*', '', src)
+
+
+def squeeze(line):
+    """Collapses whitespace, keeping a space only where tokens would merge."""
+    out = []
+    tokens = line.split()
+    for tok in tokens:
+        if out:
+            a, b = out[-1][-1], tok[0]
+            if ((a in IDENT_CHARS and b in IDENT_CHARS) or
+                    (a in OPERATOR_CHARS and b in OPERATOR_CHARS)):
+                out.append(' ')
+        out.append(tok)
+    return ''.join(out)
+
+
+def minify(src):
+    """Strips comments and whitespace. Preprocessor directives stay on their
+    own lines, and the #version line stays first."""
+    lines = []
+    code = []
+    for line in strip_comments(src).split('\n'):
+        line = line.strip()
+        if not line:
+            continue
+        if line.startswith('#'):
+            if code:
+                lines.append(squeeze(' '.join(code)))
+                code = []
+            lines.append('#' + ' '.join(line[1:].split()))
+        else:
+            code.append(line)
+    if code:
+        lines.append(squeeze(' '.join(code)))
+    return '\n'.join(lines) + '\n'
+
+
+class Program(object):
+    def __init__(self, name, paths):
+        self.name = name
+        self.stages = []    # (stage, path, source, minified)
+        self.features = []  # (name, default)
+        self.constants = []  # (name, default)
+        for path in paths:
+            ext = os.path.splitext(path)[1]
+            if ext not in STAGES:
+                sys.exit('%s: unknown shader stage extension' % path)
+            with open(path) as f:
+                src = f.read()
+            if not src.startswith('#version'):
+                sys.exit('%s: first line must be #version' % path)
+            for line in src.split('\n'):
+                m = DIRECTIVE_RE.match(line)
+                if not m:
+                    continue
+                kind, ident, default = m.group(1), m.group(2), int(m.group(3))
+                table = self.features if kind == 'feature' else self.constants
+                if ident not in [t[0] for t in table]:
+                    table.append((ident, default))
+            self.stages.append((STAGES[ext], path, src, minify(src)))
+        stage_names = sorted(s[0] for s in self.stages)
+        if stage_names not in (['compute'], ['fragment', 'vertex']):
+            sys.exit('%s: needs vertex+fragment or compute stages' % name)
+        if len(self.features) > 8:
+            sys.exit('%s: too many features to validate' % name)
+
+    def stage(self, kind):
+        for s in self.stages:
+            if s[0] == kind:
+                return s
+        return None
+
+    def content_hash(self):
+        h = fnv1a64(self.name.encode())
+        for kind in ('vertex', 'fragment', 'compute'):
+            s = self.stage(kind)
+            if s:
+                h = fnv1a64(s[3].encode('ascii'), h)
+        return h
+
+    def variant_defines(self):
+        names = [f[0] for f in self.features]
+        for bits in itertools.product((0, 1), repeat=len(names)):
+            defines = ['-D%s=%d' % (n, b) for n, b in zip(names, bits)]
+            defines += ['-D%s=%d' % c for c in self.constants]
+            yield defines
+
+
+def validate(validator, program):
+    failed = False
+    for kind, path, src, mini in program.stages:
+        ext = os.path.splitext(path)[1]
+        fd, tmp = tempfile.mkstemp(suffix=ext)
+        with os.fdopen(fd, 'w') as f:
+            f.write(mini)
+        try:
+            for defines in program.variant_defines():
+                for label, p in (('source', path), ('minified', tmp)):
+                    cmd = [validator] + defines + [p]
+                    r = subprocess.run(cmd, stdout=subprocess.PIPE,
+                                       stderr=subprocess.STDOUT,
+                                       universal_newlines=True)
+                    if r.returncode != 0:
+                        failed = True
+                        sys.stderr.write('%s (%s, %s) failed validation:\n%s\n'
+                                         % (path, label, ' '.join(defines),
+                                            r.stdout))
+        finally:
+            os.unlink(tmp)
+    return not failed
+
+
+def c_bytes(data):
+    data = bytearray(data) + bytearray(1)
+    rows = []
+    for i in range(0, len(data), 12):
+        rows.append('    ' + ' '.join('0x%02x,' % b for b in data[i:i + 12]))
+    return '\n'.join(rows)
+
+
+def emit_header(programs, out):
+    w = out.write
+    w('// Generated by tools/embed_shaders.py from jni/shaders. Do not edit.\n')
+    w('\n#ifndef SHADERSOURCES_H\n#define SHADERSOURCES_H 1\n\n')
+    w('#include "ShaderVariant.h"\n\n')
+    for p in programs:
+        w('extern const ShaderDesc %s_SHADER;\n' % p.name.upper())
+    w('\n#endif // SHADERSOURCES_H\n')
+
+
+def emit_source(programs, header, out):
+    w = out.write
+    w('// Generated by tools/embed_shaders.py from jni/shaders. Do not edit.\n')
+    w('\n#include "%s"\n' % header)
+    for p in programs:
+        prefix = p.name.upper()
+        srcs = {}
+        for kind, path, src, mini in p.stages:
+            ident = '%s_%s_SRC' % (prefix, os.path.splitext(path)[1][1:].upper())
+            srcs[kind] = ident
+            w('\n// %s: %d bytes, %d minified\n'
+              % (os.path.basename(path), len(src), len(mini)))
+            w('static constexpr char %s[] = {\n%s\n};\n'
+              % (ident, c_bytes(mini.encode('ascii'))))
+        if p.features:
+            w('\nstatic const char* const %s_FEATURES[] = {%s};\n'
+              % (prefix, ', '.join('"%s"' % f[0] for f in p.features)))
+        if p.constants:
+            w('\nstatic const ShaderConstant %s_CONSTANTS[] = {\n' % prefix)
+            for c in p.constants:
+                w('    {"%s", %d},\n' % c)
+            w('};\n')
+        default_features = 0
+        for i, f in enumerate(p.features):
+            if f[1]:
+                default_features |= 1 << i
+        w('\nconst ShaderDesc %s_SHADER = {\n' % prefix)
+        w('    "%s", %s, %s, %s,\n' % (
+            p.name, srcs.get('vertex', 'NULL'), srcs.get('fragment', 'NULL'),
+            srcs.get('compute', 'NULL')))
+        w('    %s, %d, 0x%x,\n' % (
+            '%s_FEATURES' % prefix if p.features else 'NULL',
+            len(p.features), default_features))
+        w('    %s, %d,\n' % (
+            '%s_CONSTANTS' % prefix if p.constants else 'NULL',
+            len(p.constants)))
+        w('    0x%016xull,\n};\n' % p.content_hash())
+
+
+def write_file(path, emit):
+    tmp = path + '.tmp'
+    with open(tmp, 'w') as f:
+        emit(f)
+    os.rename(tmp, path)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Validate, minify and embed GLSL shaders.')
+    parser.add_argument('-o', '--output', required=True)
+    parser.add_argument('--validator', default='glslangValidator')
+    parser.add_argument('--no-validate', action='store_true',
+                        help='skip glslangValidator (not recommended)')
+    parser.add_argument('programs', nargs='+', metavar='NAME=FILE[,FILE]')
+    args = parser.parse_args()
+
+    programs = []
+    for spec in args.programs:
+        name, _, files = spec.partition('=')
+        if not files:
+            parser.error('bad program spec: %s' % spec)
+        programs.append(Program(name, files.split(',')))
+
+    if not args.no_validate:
+        ok = True
+        for p in programs:
+            ok = validate(args.validator, p) and ok
+        if not ok:
+            sys.exit(1)
+
+    source = os.path.splitext(args.output)[0] + '.cpp'
+    header = os.path.basename(args.output)
+    write_file(source, lambda f: emit_source(programs, header, f))
+    write_file(args.output, lambda f: emit_header(programs, f))
+
+
+if __name__ == '__main__':
+    main()